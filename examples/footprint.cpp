@@ -0,0 +1,85 @@
+/**
+ * @file footprint.cpp
+ * @brief Object sizes and heap footprint of a 100k-widget tree
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details The footprint is taken before and after every row is laid out
+ * and drawn once through the software context, so state widgets create
+ * lazily for drawing is counted. It fails if drawing grew the tree: plain
+ * labels, buttons and check boxes draw their UTF-8 text through the
+ * canvas's scratch buffer.
+ *
+ * Usage: zwidget_footprint [font.ttf]
+ */
+
+#include "zwidget/core/memory_report.hpp"
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/widgets/button.hpp"
+#include "zwidget/widgets/checkbox.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include "zwidget/widgets/textbox.hpp"
+#include <iostream>
+
+using namespace zuu::widget;
+
+int main(int argc, char** argv) {
+    std::cout << "sizeof(Widget)   = " << sizeof(Widget) << "\n"
+              << "sizeof(Label)    = " << sizeof(Label) << "\n"
+              << "sizeof(Button)   = " << sizeof(Button) << "\n"
+              << "sizeof(CheckBox) = " << sizeof(CheckBox) << "\n"
+              << "sizeof(TextBox)  = " << sizeof(TextBox) << "\n"
+              << "sizeof(VBox)     = " << sizeof(VBox) << "\n\n";
+
+    // 10k rows of: label, checkbox, button, textbox, nested hbox with 4 labels
+    constexpr size_t rows = 10000;
+    auto root = make_widget<VBox>();
+
+    for (size_t i = 0; i < rows; ++i) {
+        auto row = make_widget<HBox>();
+        row->add_child(make_widget<Label>(L"Item"));
+        row->add_child(make_widget<CheckBox>(L"Enabled"));
+        row->add_child(make_widget<Button>(L"Edit"));
+        row->add_child(make_widget<TextBox>());
+
+        auto tags = make_widget<HBox>();
+        for (int t = 0; t < 4; ++t) {
+            tags->add_child(make_widget<Label>(L"tag"));
+        }
+        row->add_child(tags);
+        root->add_child(row);
+    }
+
+    size_t built = MemoryReport::build(*root, 0).total_bytes();
+
+    // Draw each row at the top of the target, so none of them is culled
+    SoftContext ctx(Size{800, 600});
+    if (argc > 1) ctx.add_font(FontFamily(), argv[1]);
+    Canvas canvas(ctx);
+    root->set_bounds(Rectf{0.0f, 0.0f, 800.0f, 600.0f});
+    root->layout();
+    {
+        DrawScope scope(ctx);
+        canvas.begin_frame();
+        for (const auto& row : root->children()) {
+            CanvasTranslate translate(canvas, Pointf{0.0f, -row->bounds().top()});
+            row->render(canvas);
+        }
+    }
+
+    auto report = MemoryReport::build(*root, 0);
+    std::cout << report.widget_count() << " widgets, " << built << " bytes built, "
+              << report.total_bytes() << " bytes after a draw ("
+              << report.total_bytes() / report.widget_count() << " per widget)\n"
+              << "widgets drawn: " << canvas.stats().drawn_widgets << "\n"
+              << "widgets with sparse extras: " << Widget::extras_count() << "\n\n";
+    report.print(std::cout);
+
+    if (report.total_bytes() > built) {
+        std::cerr << "FAILED: drawing grew the tree by " << report.total_bytes() - built << " bytes\n";
+        return 1;
+    }
+    return 0;
+}
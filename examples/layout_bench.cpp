@@ -0,0 +1,213 @@
+/**
+ * @file layout_bench.cpp
+ * @brief Layout pass cost of FlexBox, Grid and ConstraintLayout
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Each case is laid out cold once, then resized back and forth so
+ * every pass has to re-arrange all children (measures stay cached), then
+ * the preferred size of its first deepest leaf is changed back and forth
+ * and the tree brought up to date with update_layout(). For the
+ * ConstraintLayout, cold includes building the tableau and each resize is
+ * one suggest_value() on the container width.
+ */
+
+#include "zwidget/widgets/constraint_layout.hpp"
+#include "zwidget/widgets/flex_box.hpp"
+#include "zwidget/widgets/grid.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+using namespace zuu::widget;
+
+namespace {
+
+template <typename F>
+double time_us(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+WidgetPtr make_cell() {
+    auto cell = make_widget<Label>(L"cell");
+    cell->set_preferred_size(Sizef{40, 20});
+    return cell;
+}
+
+/**
+ * @brief Stretch child for HBox (the Align convention of the box layouts)
+ */
+WidgetPtr make_stretch_cell() {
+    auto cell = make_cell();
+    cell->set_alignment(Align{orientations::horizontal, aligns::end, aligns::start});
+    return cell;
+}
+
+// === Wide: one container with 10k direct children ===
+
+WidgetPtr wide_hbox() {
+    auto box = make_widget<HBox>();
+    box->set_spacing(2.0f);
+    for (int i = 0; i < 10000; ++i) {
+        box->add_child(make_stretch_cell());
+    }
+    return box;
+}
+
+WidgetPtr wide_flex() {
+    auto box = make_flex_box(FlexDirection::row, 2.0f);
+    for (int i = 0; i < 10000; ++i) {
+        box->add_child(make_cell(), FlexItem{.grow = 1.0f});
+    }
+    return box;
+}
+
+// === Deep: 100 x 100 cells as nested rows, or one wrapping FlexBox ===
+
+WidgetPtr deep_boxes() {
+    auto column = make_widget<VBox>();
+    column->set_spacing(2.0f);
+    column->set_alignment(LayoutAlign::stretch);
+    for (int r = 0; r < 100; ++r) {
+        auto row = make_widget<HBox>();
+        row->set_spacing(2.0f);
+        for (int c = 0; c < 100; ++c) {
+            row->add_child(make_stretch_cell());
+        }
+        column->add_child(row);
+    }
+    return column;
+}
+
+WidgetPtr deep_flex() {
+    auto box = make_flex_box(FlexDirection::row, 2.0f);
+    box->set_wrap(true);
+    for (int i = 0; i < 10000; ++i) {
+        box->add_child(make_cell(), FlexItem{.grow = 1.0f});
+    }
+    return box;
+}
+
+// === Nested: 12 levels of containers, two children each (4096 cells) ===
+
+constexpr int nesting = 12;
+
+WidgetPtr nested_boxes(int depth = nesting) {
+    if (depth == 0) return make_stretch_cell();
+
+    std::shared_ptr<LayoutContainer> box;
+    if (depth % 2) {
+        box = make_widget<HBox>();
+    } else {
+        box = make_widget<VBox>();
+        box->set_alignment(LayoutAlign::stretch);
+    }
+    box->set_spacing(2.0f);
+    box->add_child(nested_boxes(depth - 1));
+    box->add_child(nested_boxes(depth - 1));
+    return box;
+}
+
+WidgetPtr nested_flex(int depth = nesting) {
+    if (depth == 0) return make_cell();
+
+    auto box = make_flex_box(depth % 2 ? FlexDirection::row : FlexDirection::column, 2.0f);
+    box->add_child(nested_flex(depth - 1), FlexItem{.grow = 1.0f});
+    box->add_child(nested_flex(depth - 1), FlexItem{.grow = 1.0f});
+    return box;
+}
+
+// === Form: 40 rows of label + stretching field ===
+
+WidgetPtr make_field(float width) {
+    auto field = make_widget<Label>(L"field");
+    field->set_preferred_size(Sizef{width, 24});
+    return field;
+}
+
+WidgetPtr form_grid() {
+    auto grid = make_grid(6.0f, 8.0f);
+    grid->set_columns({GridTrack::fixed(100.0f), GridTrack::fraction(1.0f, 80.0f)});
+    for (size_t r = 0; r < 40; ++r) {
+        grid->add_child(make_field(100.0f), GridCell{.row = r, .column = 0});
+        grid->add_child(make_field(200.0f), GridCell{.row = r, .column = 1});
+    }
+    return grid;
+}
+
+WidgetPtr form_constraints() {
+    auto form = make_constraint_layout(8.0f);
+    const LayoutAnchors& box = form->anchors();
+
+    LayoutExpression top = box.top;
+    for (int r = 0; r < 40; ++r) {
+        auto label = make_field(100.0f);
+        auto field = make_field(200.0f);
+        form->add_child(label);
+        form->add_child(field);
+
+        const LayoutAnchors& l = form->anchors(label.get());
+        const LayoutAnchors& f = form->anchors(field.get());
+        form->add_constraints({
+            l.left == box.left, l.top == top, l.width == 100.0,
+            f.left == l.right() + 6.0, f.top == l.top, f.right() == box.right(), f.width >= 80.0,
+        });
+        top = l.bottom() + 6.0;
+    }
+    return form;
+}
+
+void run(const char* name, const std::function<WidgetPtr()>& build, Sizef a, Sizef b) {
+    auto root = build();
+    root->set_bounds(Rectf{Pointf{0.0f, 0.0f}, a});
+
+    double cold = time_us([&] { root->layout(); });
+
+    constexpr int passes = 200;
+    double resize = time_us([&] {
+        for (int i = 0; i < passes; ++i) {
+            root->set_size(i % 2 ? a : b);
+            root->layout();
+        }
+    });
+
+    Widget* leaf = root.get();
+    while (!leaf->children().empty()) leaf = leaf->children().front().get();
+    Sizef leaf_size = leaf->preferred_size();
+
+    double relayout = time_us([&] {
+        for (int i = 0; i < passes; ++i) {
+            leaf->set_preferred_size(i % 2 ? leaf_size : Sizef{leaf_size.w + 20.0f, leaf_size.h + 10.0f});
+            root->update_layout();
+        }
+    });
+
+    std::cout << "  " << name << ": cold " << cold << " us, resize pass "
+              << resize / passes << " us, leaf change " << relayout / passes << " us\n";
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Wide (10k children in one row):\n";
+    run("HBox   ", wide_hbox, Sizef{500000, 40}, Sizef{450000, 40});
+    run("FlexBox", wide_flex, Sizef{500000, 40}, Sizef{450000, 40});
+
+    std::cout << "Grid of 100 x 100 cells:\n";
+    run("VBox of HBox rows  ", deep_boxes, Sizef{5000, 2500}, Sizef{4500, 2500});
+    run("Wrapping FlexBox   ", deep_flex, Sizef{4200, 2500}, Sizef{3800, 2500});
+
+    std::cout << "Nested (" << nesting << " levels, " << (1 << nesting) << " cells):\n";
+    run("HBox / VBox         ", [] { return nested_boxes(); }, Sizef{5000, 2500}, Sizef{4500, 2500});
+    run("Row / column FlexBox", [] { return nested_flex(); }, Sizef{5000, 2500}, Sizef{4500, 2500});
+
+    std::cout << "Form (40 rows, label + field):\n";
+    run("Grid            ", form_grid, Sizef{600, 1200}, Sizef{500, 1200});
+    run("ConstraintLayout", form_constraints, Sizef{600, 1200}, Sizef{500, 1200});
+    return 0;
+}
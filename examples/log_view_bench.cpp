@@ -0,0 +1,229 @@
+/**
+ * @file log_view_bench.cpp
+ * @brief Opening, indexing, searching and tailing a large log in a LogView
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Writes a generated service log of the requested size, opens it
+ * in a LogView drawn by the software context and times the first frame and
+ * a jump to the end while the background index is still running, then how
+ * long indexing and a plain and a regex search take to finish, the heap the
+ * index and the matches use, and a frame after data is appended in follow
+ * mode. Then lines are appended in rounds under a search with a small
+ * match limit, whose count must grow to the limit and stay there. Last,
+ * files with no line feed at all, of 1 MiB and of the full size, are
+ * opened and indexed: their first frame, a jump to the end and a page up
+ * must fill the view with rows and, reading only a screenful of them,
+ * cost about the same whatever the file size.
+ *
+ * Usage: zwidget_log_view_bench <font.ttf> [size in MiB, default 1024] [log path]
+ */
+
+#include "zwidget/core/task_pool.hpp"
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include "zwidget/widgets/log_view.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace zuu::widget;
+
+namespace {
+
+double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void write_log(const std::string& path, uint64_t bytes, uint64_t first_id) {
+    static const char* levels[] = {"INFO ", "DEBUG", "INFO ", "WARN ", "INFO ", "ERROR"};
+    std::ofstream out(path, std::ios::binary | (first_id ? std::ios::app : std::ios::trunc));
+    std::string line;
+    uint64_t written = 0;
+    for (uint64_t id = first_id; written < bytes; ++id) {
+        line = "2026-10-16T12:" + std::to_string(id / 60 % 60) + ":" + std::to_string(id % 60) + " " +
+               levels[id * 7 % 6] + " worker-" + std::to_string(id % 17) + " request " + std::to_string(id) +
+               " took " + std::to_string(id * 31 % 997) + " ms\n";
+        out << line;
+        written += line.size();
+    }
+}
+
+void write_unbroken(const std::string& path, uint64_t bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    std::string block;
+    for (int i = 0; block.size() < (64 << 10); ++i) block += "field" + std::to_string(i) + "=value ";
+    for (uint64_t written = 0; written < bytes; written += block.size()) out << block;
+}
+
+void append_marked(const std::string& path, int lines, int first) {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    for (int i = first; i < first + lines; ++i) out << "2026-10-16T13:00:00 ERROR tail-marker " << i << "\n";
+}
+
+double frame_ms(SoftContext& ctx, Canvas& canvas, LogView& view) {
+    auto start = std::chrono::steady_clock::now();
+    {
+        DrawScope draw(ctx);
+        canvas.begin_frame();
+        view.render(canvas);
+    }
+    return ms_since(start);
+}
+
+template <typename Done>
+double wait_ms(Done&& done) {
+    auto start = std::chrono::steady_clock::now();
+    while (!done()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return ms_since(start);
+}
+
+/**
+ * @brief Slowest of the first frame, a jump to the end and a page up over a file without line feeds
+ */
+double unbroken_frames(SoftContext& ctx, Canvas& canvas, TaskPool& pool, const std::string& path, uint64_t mib) {
+    write_unbroken(path, mib << 20);
+    double slowest = 0.0;
+    {
+        LogView view(path, pool);
+        view.set_bounds(Rectf{0.0f, 0.0f, 900.0f, 600.0f});
+        view.search("field7=");
+        // Time the walks, not a busy indexer
+        wait_ms([&] { return !view.file().indexing() && !view.file().searching(); });
+        double first = frame_ms(ctx, canvas, view);
+        size_t rows = view.cached_lines();
+        view.scroll_to_end();
+        double end = frame_ms(ctx, canvas, view);
+        view.scroll_lines(-static_cast<int64_t>(view.visible_rows()));
+        double up = frame_ms(ctx, canvas, view);
+        auto start = std::chrono::steady_clock::now();
+        view.next_match();
+        frame_ms(ctx, canvas, view);
+        double next = ms_since(start);
+        std::cout << "no line feeds, " << mib << " MiB: first frame " << first << " ms, jump to end " << end
+                  << " ms, page up " << up << " ms, next match " << next << " ms, " << rows << " of "
+                  << view.visible_rows() << " rows filled\n";
+        if (rows != view.visible_rows()) throw std::runtime_error("a file with no line feeds did not fill the view");
+        slowest = std::max({first, end, up, next});
+    }
+    std::remove(path.c_str());
+    return slowest;
+}
+
+void run(const std::string& font, uint64_t mib, const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    write_log(path, mib << 20, 0);
+    std::cout << "wrote " << mib << " MiB in " << ms_since(start) << " ms\n";
+
+    SoftContext ctx(Size{900, 600});
+    ctx.add_font(FontFamily(), font);
+    TextShaper::set_context(&ctx);
+    TaskPool pool;
+    Canvas canvas(ctx);
+
+    start = std::chrono::steady_clock::now();
+    LogView view(path, pool);
+    view.set_bounds(Rectf{0.0f, 0.0f, 900.0f, 600.0f});
+    double opened = ms_since(start);
+    double first = frame_ms(ctx, canvas, view);
+    view.scroll_to_end();
+    double end = frame_ms(ctx, canvas, view);
+    std::cout << "open " << opened << " ms, first frame " << first << " ms, jump to end " << end << " ms ("
+              << view.file().stats().indexed_chunks << " of " << view.file().stats().chunks << " chunks indexed)\n";
+
+    double indexed = wait_ms([&] { return !view.file().indexing(); });
+    LogFileStats stats = view.file().stats();
+    std::cout << "indexed " << *view.file().line_count() << " lines " << indexed << " ms later; index "
+              << stats.index_bytes / 1024 << " KiB\n";
+
+    uint64_t middle = *view.file().line_count() / 2;
+    view.go_to_line(middle);
+    double jump = frame_ms(ctx, canvas, view);
+    std::cout << "go to line " << middle << ": " << jump << " ms\n";
+
+    start = std::chrono::steady_clock::now();
+    view.search("ERROR");
+    double first_results = frame_ms(ctx, canvas, view);
+    double searched = wait_ms([&] { return !view.file().searching(); });
+    stats = view.file().stats();
+    std::cout << "search ERROR: frame while searching " << first_results << " ms, done after " << searched
+              << " ms, " << stats.matches << " matches" << (stats.matches_dropped ? " (limit reached)" : "")
+              << ", " << stats.match_bytes / 1024 << " KiB\n";
+
+    view.search("request [0-9]+7 took", LogSearchOptions{true});
+    searched = wait_ms([&] { return !view.file().searching(); });
+    std::cout << "regex search: " << searched << " ms, " << view.file().match_count() << " matches\n";
+    view.next_match();
+    std::cout << "next match frame " << frame_ms(ctx, canvas, view) << " ms\n";
+
+    view.scroll_to_end();
+    frame_ms(ctx, canvas, view);
+    write_log(path, 64 << 10, 1ull << 40);
+    start = std::chrono::steady_clock::now();
+    view.refresh();
+    double tail = frame_ms(ctx, canvas, view);
+    wait_ms([&] { return !view.file().indexing(); });
+    std::cout << "appended 64 KiB: refresh and frame " << ms_since(start) << " ms (frame " << tail
+              << " ms), following at line " << view.first_visible_line().value_or(0) << " of "
+              << *view.file().line_count() << "\n";
+
+    // Each refresh searches the grown chunk again; its old matches must not count twice
+    constexpr size_t limit = 1000;
+    int appended = 0;
+    append_marked(path, 600, appended);
+    appended += 600;
+    view.refresh();
+    view.search("tail-marker", LogSearchOptions{false, false, limit});
+    for (int round = 0; round < 4; ++round) {
+        if (round > 0) {
+            append_marked(path, 200, appended);
+            appended += 200;
+            view.refresh();
+        }
+        wait_ms([&] { return !view.file().searching() && !view.file().indexing(); });
+        stats = view.file().stats();
+        size_t expected = std::min<size_t>(limit, static_cast<size_t>(appended));
+        std::cout << "appended " << appended << " marked lines, limit " << limit << ": " << stats.matches
+                  << " matches" << (stats.matches_dropped ? " (limit reached)" : "") << "\n";
+        if (stats.matches != expected || stats.matches_dropped != (static_cast<size_t>(appended) > limit)) {
+            throw std::runtime_error("match count wrong after appending");
+        }
+    }
+
+    WidgetMemory memory;
+    view.measure_memory(memory);
+    std::cout << "view heap " << memory.total() / 1024 << " KiB, " << view.cached_lines() << " lines cached\n";
+
+    // No line feeds: every walk must stop at max_line_bytes per row
+    double small = unbroken_frames(ctx, canvas, pool, path + ".unbroken", 1);
+    double large = unbroken_frames(ctx, canvas, pool, path + ".unbroken", mib);
+    if (large > 1.5 * small + 4.0) throw std::runtime_error("frames over a file with no line feeds grow with its size");
+    TextShaper::set_context(nullptr);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <font.ttf> [size in MiB] [log path]\n";
+        return 1;
+    }
+    uint64_t mib = argc > 2 ? std::stoull(argv[2]) : 1024;
+    std::string path = argc > 3 ? argv[3] : "zwidget_log_view_bench.log";
+
+    try {
+        run(argv[1], mib, path);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        std::remove(path.c_str());
+        return 1;
+    }
+    std::remove(path.c_str());
+    return 0;
+}
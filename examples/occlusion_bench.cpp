@@ -0,0 +1,180 @@
+/**
+ * @file occlusion_bench.cpp
+ * @brief Overdraw with and without occlusion culling
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Renders a settings page of labels, text boxes, check boxes and
+ * buttons through the software context, once on its own and once as the
+ * top of four identical pages stacked in the same place, the way a page
+ * container without lazy pages would keep them. Each scene is drawn with
+ * plain render() and with cull_occluded() first; for both it reports the
+ * overdraw factor, the widgets drawn, the subtrees skipped and the frame
+ * time, and checks that culling left the pixels unchanged.
+ *
+ * Usage: zwidget_occlusion_bench <font.ttf>
+ */
+
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include "zwidget/widgets/button.hpp"
+#include "zwidget/widgets/checkbox.hpp"
+#include "zwidget/widgets/grid.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include "zwidget/widgets/textbox.hpp"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace zuu::widget;
+
+namespace {
+
+constexpr float page_width = 820.0f;
+constexpr float page_height = 620.0f;
+
+WidgetPtr build_page() {
+    auto page = make_widget<VBox>();
+    page->set_spacing(12.0f);
+    page->set_padding(16.0f);
+    page->set_alignment(LayoutAlign::stretch);
+    page->set_background(Color(240, 240, 240, 255));
+    page->set_bounds(Rectf{0.0f, 0.0f, page_width, page_height});
+
+    auto title = make_widget<Label>(L"Account settings");
+    title->set_text_style(TextStyle(FontFamily(), 20.0f));
+    title->set_preferred_size(Sizef{0, 30});
+    page->add_child(title);
+
+    auto form = make_grid(8.0f, 12.0f);
+    form->set_background(Color(250, 250, 250, 255));
+    form->set_columns({GridTrack::fixed(120.0f), GridTrack::fraction(1.0f)});
+    size_t row = 0;
+    for (const wchar_t* name : {L"Name:", L"Email:", L"Phone:", L"Company:", L"City:"}) {
+        auto label = make_widget<Label>(name);
+        label->set_background(Color(250, 250, 250, 255));
+        label->set_preferred_size(Sizef{120, 28});
+        form->add_child(label, GridCell{.row = row, .column = 0});
+
+        auto input = make_widget<TextBox>(L"");
+        input->set_preferred_size(Sizef{300, 28});
+        form->add_child(input, GridCell{.row = row, .column = 1});
+        ++row;
+    }
+    page->add_child(form);
+
+    auto options = make_widget<VBox>();
+    options->set_spacing(6.0f);
+    options->set_padding(12.0f);
+    options->set_background(Color(245, 245, 245, 255));
+    for (const wchar_t* name : {L"Send newsletter", L"Enable notifications", L"Share usage statistics",
+                                L"Automatic updates"}) {
+        auto option = make_widget<CheckBox>(name, false);
+        option->set_preferred_size(Sizef{300, 24});
+        options->add_child(option);
+    }
+    page->add_child(options);
+
+    auto buttons = make_widget<HBox>();
+    buttons->set_spacing(8.0f);
+    buttons->set_preferred_size(Sizef{0, 36});
+    for (const wchar_t* name : {L"Cancel", L"Apply", L"Save"}) {
+        auto button = make_widget<Button>(name);
+        button->set_background(Color(225, 225, 225, 255));
+        button->set_foreground(Color(20, 20, 20, 255));
+        button->set_preferred_size(Sizef{100, 36});
+        buttons->add_child(button);
+    }
+    page->add_child(buttons);
+    return page;
+}
+
+WidgetPtr build_scene(int pages) {
+    auto root = make_widget<Widget>();
+    root->set_bounds(Rectf{0.0f, 0.0f, page_width, page_height});
+    for (int i = 0; i < pages; ++i) {
+        root->add_child(build_page());
+    }
+    root->layout();
+    return root;
+}
+
+struct Frame {
+    RenderStats stats;
+    double ms = 0.0;
+    std::vector<uint32_t> pixels;
+};
+
+Frame draw(SoftContext& ctx, Canvas& canvas, Widget& root, bool cull) {
+    constexpr int frames = 50;
+    Frame frame;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        DrawScope scope(ctx);
+        canvas.begin_frame();
+        canvas.clear(Color(0, 0, 0, 255));
+        if (cull) root.cull_occluded(canvas);
+        root.render(canvas);
+    }
+    frame.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    frame.stats = canvas.stats();
+
+    const uint32_t* pixels = ctx.pixels();
+    frame.pixels.assign(pixels, pixels + static_cast<size_t>(page_width * page_height));
+    return frame;
+}
+
+void report(const char* name, const Frame& frame) {
+    const RenderStats& stats = frame.stats;
+    std::cout << "  " << name << ": overdraw " << stats.overdraw() << "x, " << stats.drawn_widgets
+              << " widgets drawn, " << stats.occluded_subtrees << " subtrees and " << stats.occluded_widgets
+              << " widgets occluded, " << frame.ms << " ms per frame\n";
+}
+
+/**
+ * @brief Draw a scene without and with culling; returns the overdraw of both
+ */
+std::pair<float, float> run(SoftContext& ctx, Canvas& canvas, const char* name, int pages) {
+    WidgetPtr root = build_scene(pages);
+    std::cout << name << ":\n";
+
+    Frame plain = draw(ctx, canvas, *root, false);
+    report("render      ", plain);
+    Frame culled = draw(ctx, canvas, *root, true);
+    report("cull, render", culled);
+
+    if (plain.pixels != culled.pixels) {
+        throw std::runtime_error(std::string(name) + ": culling changed the image");
+    }
+    return {plain.stats.overdraw(), culled.stats.overdraw()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <font.ttf>\n";
+        return 1;
+    }
+
+    try {
+        SoftContext ctx(Size{static_cast<int>(page_width), static_cast<int>(page_height)});
+        ctx.add_font(FontFamily(), argv[1]);
+        TextShaper::set_context(&ctx);
+        Canvas canvas(ctx);
+
+        run(ctx, canvas, "One page", 1);
+        auto [plain, culled] = run(ctx, canvas, "Four stacked pages", 4);
+        TextShaper::set_context(nullptr);
+
+        if (culled >= plain) throw std::runtime_error("culling did not reduce overdraw of hidden pages");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file parallel_layout_bench.cpp
+ * @brief Resize layout of a 200k-widget data screen, serial vs task pool
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Two identical trees are resized back and forth; one with
+ * layout(), one with layout(pool). Every widget's bounds are then compared
+ * to check the passes agree exactly. The flat screen is a VBox of 2000 rows
+ * of 100 cells; the nested one is a panel hierarchy ten containers deep,
+ * alternating columns and rows three wide, with small rows of cells at the
+ * bottom, so the parallel pass has to find its tasks several levels down.
+ */
+
+#include "zwidget/core/task_pool.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+using namespace zuu::widget;
+
+namespace {
+
+template <typename F>
+double time_us(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+WidgetPtr build_screen() {
+    auto column = make_widget<VBox>();
+    column->set_spacing(1.0f);
+    column->set_alignment(LayoutAlign::stretch);
+
+    for (int r = 0; r < 2000; ++r) {
+        auto row = make_widget<HBox>();
+        row->set_spacing(2.0f);
+        for (int c = 0; c < 100; ++c) {
+            WidgetPtr cell = make_widget<Label>(L"cell");
+            cell->set_preferred_size(Sizef{40, 18});
+            cell->set_alignment(Align{orientations::horizontal, aligns::end, aligns::start});
+            row->add_child(cell);
+        }
+        column->add_child(row);
+    }
+    return column;
+}
+
+/**
+ * @brief Columns and rows, alternating, three children each; every child stretches
+ */
+WidgetPtr build_panel(int depth) {
+    if (depth == 0) {
+        auto row = make_widget<HBox>();
+        row->set_spacing(2.0f);
+        for (int c = 0; c < 4; ++c) {
+            WidgetPtr cell = make_widget<Label>(L"cell");
+            cell->set_preferred_size(Sizef{30, 18});
+            cell->set_alignment(Align{orientations::horizontal, aligns::end, aligns::start});
+            row->add_child(cell);
+        }
+        return row;
+    }
+
+    bool column = depth % 2 == 0;
+    std::shared_ptr<LayoutContainer> panel = column ? std::shared_ptr<LayoutContainer>(make_widget<VBox>())
+                                                    : std::shared_ptr<LayoutContainer>(make_widget<HBox>());
+    panel->set_spacing(2.0f);
+    panel->set_padding(1.0f);
+    panel->set_alignment(LayoutAlign::stretch);
+    for (int i = 0; i < 3; ++i) {
+        WidgetPtr child = build_panel(depth - 1);
+        if (!column) child->set_alignment(Align{orientations::horizontal, aligns::end, aligns::start});
+        panel->add_child(child);
+    }
+    return panel;
+}
+
+WidgetPtr build_nested() {
+    return build_panel(10);
+}
+
+bool same_bounds(const Widget& a, const Widget& b) {
+    if (a.bounds() != b.bounds() || a.children().size() != b.children().size()) return false;
+    for (size_t i = 0; i < a.children().size(); ++i) {
+        if (!same_bounds(*a.children()[i], *b.children()[i])) return false;
+    }
+    return true;
+}
+
+void run(const char* name, TaskPool& pool, const std::function<WidgetPtr()>& build) {
+    auto serial = build();
+    auto parallel = build();
+    std::cout << name << ": " << serial->subtree_size() << " widgets per tree\n";
+
+    const Sizef a{5000, 40000};
+    const Sizef b{4400, 40000};
+    serial->set_bounds(Rectf{Pointf{0.0f, 0.0f}, a});
+    parallel->set_bounds(Rectf{Pointf{0.0f, 0.0f}, a});
+    serial->layout();
+    parallel->layout(pool);
+
+    constexpr int passes = 20;
+    double serial_us = time_us([&] {
+        for (int i = 0; i < passes; ++i) {
+            serial->set_size(i % 2 ? a : b);
+            serial->layout();
+        }
+    });
+    double parallel_us = time_us([&] {
+        for (int i = 0; i < passes; ++i) {
+            parallel->set_size(i % 2 ? a : b);
+            parallel->layout(pool);
+        }
+    });
+
+    std::cout << "Serial:   " << serial_us / passes << " us per resize\n"
+              << "Parallel: " << parallel_us / passes << " us per resize\n"
+              << "Identical bounds: " << (same_bounds(*serial, *parallel) ? "yes" : "NO") << "\n";
+}
+
+} // namespace
+
+int main() {
+    TaskPool pool;
+    std::cout << "Pool: " << pool.thread_count() << " workers + caller\n";
+    run("Flat screen", pool, build_screen);
+    run("Nested panels", pool, build_nested);
+    return 0;
+}
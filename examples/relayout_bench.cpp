@@ -0,0 +1,110 @@
+/**
+ * @file relayout_bench.cpp
+ * @brief Relayout cost after changing one leaf of a 50k-widget tree
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace zuu::widget;
+
+namespace {
+
+size_t measured = 0;
+
+/**
+ * @brief Label that counts how often it is actually measured (cache misses)
+ */
+class CountingLabel : public Label {
+protected:
+    Sizef measure_content(const Sizef& available) override {
+        measured++;
+        return Label::measure_content(available);
+    }
+
+public:
+    using Label::Label;
+};
+
+struct Tree {
+    std::shared_ptr<VBox> root;
+    std::vector<std::shared_ptr<CountingLabel>> leaves;
+};
+
+// 100 sections x 10 rows x 50 labels (+ containers): about 51k widgets
+Tree build(bool fixed_sections) {
+    Tree tree;
+    tree.root = make_widget<VBox>();
+    tree.root->set_spacing(4.0f);
+
+    for (int s = 0; s < 100; ++s) {
+        auto section = make_widget<VBox>();
+        section->set_padding(2.0f);
+        if (fixed_sections) {
+            section->set_fixed_size(Sizef{5000, 330});
+        }
+
+        for (int r = 0; r < 10; ++r) {
+            auto row = make_widget<HBox>();
+            row->set_spacing(2.0f);
+            for (int c = 0; c < 50; ++c) {
+                auto label = make_widget<CountingLabel>(L"cell");
+                label->set_preferred_size(Sizef{90, 30});
+                tree.leaves.push_back(label);
+                row->add_child(label);
+            }
+            section->add_child(row);
+        }
+        tree.root->add_child(section);
+    }
+
+    tree.root->set_bounds(Rectf{0, 0, 5000, 40000});
+    return tree;
+}
+
+template <typename F>
+double time_us(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+void run(const char* name, bool fixed_sections) {
+    Tree tree = build(fixed_sections);
+
+    measured = 0;
+    double full = time_us([&] { tree.root->update_layout(); });
+    size_t full_measured = measured;
+
+    constexpr int changes = 1000;
+    measured = 0;
+    double incremental = time_us([&] {
+        for (int i = 0; i < changes; ++i) {
+            auto& leaf = tree.leaves[(i * 7919) % tree.leaves.size()];
+            leaf->set_text(L"changed " + std::to_wstring(i));
+            tree.root->update_layout();
+        }
+    });
+
+    std::cout << name << ":\n"
+              << "  full layout:        " << full << " us, " << full_measured << " labels measured\n"
+              << "  one leaf changed:   " << incremental / changes << " us, "
+              << static_cast<double>(measured) / changes << " labels measured\n";
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Tree of " << 100 * 10 * 50 << " labels in 100 sections of 10 rows\n\n";
+    run("Auto-sized sections (boundary is the root)", false);
+    run("Fixed-size sections (relayout boundaries)", true);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file sliced_layout_bench.cpp
+ * @brief Time-sliced layout of a 100k-row list under a 4 ms frame budget
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details One tree is laid out in a single layout() call, an identical one
+ * through a LayoutScheduler whose viewport covers the first rows. The bench
+ * reports how many frames the sliced layout took, the longest frame, the
+ * frame in which the visible rows were placed, and whether both trees agree.
+ * It fails if the trees differ, if any frame reaches 16 ms (the 100k rows
+ * sit in one container, which must not hold a frame for its whole layout),
+ * or if the visible rows are not placed in the first frame.
+ */
+
+#include "zwidget/core/layout_scheduler.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <algorithm>
+#include <iostream>
+
+using namespace zuu::widget;
+
+namespace {
+
+template <typename F>
+double time_us(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+WidgetPtr build_list() {
+    auto root = make_widget<Widget>();
+    root->set_bounds(Rectf{0.0f, 0.0f, 800.0f, 600.0f});
+
+    auto column = make_widget<VBox>();
+    column->set_spacing(1.0f);
+    column->set_alignment(LayoutAlign::stretch);
+    column->set_bounds(Rectf{0.0f, 0.0f, 800.0f, 2200000.0f});
+
+    for (int r = 0; r < 100000; ++r) {
+        auto row = make_widget<HBox>();
+        row->set_spacing(4.0f);
+        row->set_preferred_size(Sizef{0, 20});
+        for (int c = 0; c < 5; ++c) {
+            auto cell = make_widget<Label>(L"cell");
+            cell->set_preferred_size(Sizef{60, 18});
+            row->add_child(cell);
+        }
+        column->add_child(row);
+    }
+    root->add_child(column);
+    return root;
+}
+
+bool same_bounds(const Widget& a, const Widget& b) {
+    if (a.bounds() != b.bounds() || a.children().size() != b.children().size()) return false;
+    for (size_t i = 0; i < a.children().size(); ++i) {
+        if (!same_bounds(*a.children()[i], *b.children()[i])) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    auto blocking = build_list();
+    auto sliced = build_list();
+
+    double blocking_us = time_us([&] { blocking->layout(); });
+
+    LayoutScheduler scheduler(*sliced);
+    scheduler.set_viewport(sliced->bounds());
+
+    // Rows are 20 px with 1 px between them; the 600 px viewport ends in row 28
+    const Widget& first_row = *sliced->children()[0]->children()[0];
+    const Widget& last_row = *sliced->children()[0]->children()[600 / 21];
+    int frames = 0;
+    int visible_frame = 0;
+    double longest_us = 0.0;
+    bool done = false;
+    while (!done) {
+        longest_us = std::max(longest_us, time_us([&] {
+            done = scheduler.run(std::chrono::milliseconds(4));
+        }));
+        ++frames;
+        if (!visible_frame && !first_row.needs_layout() && !last_row.needs_layout()) visible_frame = frames;
+    }
+
+    std::cout << "Blocking layout: " << blocking_us << " us\n"
+              << "Sliced layout:   " << frames << " frames, longest " << longest_us << " us\n"
+              << "Visible rows placed in frame " << visible_frame << "\n"
+              << "Identical bounds: " << (same_bounds(*blocking, *sliced) ? "yes" : "NO") << "\n";
+
+    const char* failure = !same_bounds(*blocking, *sliced) ? "bounds differ"
+                        : longest_us >= 16000.0             ? "a frame took 16 ms or more"
+                        : visible_frame != 1                ? "the visible rows waited for later frames"
+                                                            : nullptr;
+    if (failure) {
+        std::cerr << "FAILED: " << failure << "\n";
+        return 1;
+    }
+    return 0;
+}
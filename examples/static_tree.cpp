@@ -0,0 +1,110 @@
+/**
+ * @file static_tree.cpp
+ * @brief A compile-time widget tree, checked at compile time and drawn once
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details The screen from static_tree.hpp is laid out in a constexpr
+ * context and its bounds, hit tests and button colors are checked with
+ * static_assert, so a layout regression fails the build. The tree is then
+ * drawn through the software context with one button hovered and one
+ * pressed, and it fails if either is not filled with the color its
+ * description asks for.
+ *
+ * Usage: zwidget_static_tree [font.ttf]
+ */
+
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/widgets/static_tree.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace zuu::widget;
+
+namespace {
+
+constexpr Color hover{0, 120, 215, 255};
+constexpr Color pressed{0, 84, 153, 255};
+
+constexpr auto screen = make_static_tree(
+    static_vbox({.size = {380, 120}, .spacing = 10, .padding = 15},
+        static_label(L"Welcome", {350, 30}),
+        static_hbox({.size = {350, 40}, .spacing = 10},
+            static_button(L"Cancel", {100, 35}, {.id = 2}),
+            static_label(L"", {0, 35}, {.stretch = true}),
+            static_button(L"OK", {100, 35},
+                          {.id = 1, .hover_background = hover, .pressed_background = pressed}))));
+
+static_assert(std::is_trivially_copyable_v<decltype(screen)>);
+static_assert(screen.size() == 6);
+
+// Pre-order: vbox, label, hbox, Cancel, spacer, OK
+static_assert(screen[0].bounds == Rectf{0, 0, 380, 120});
+static_assert(screen[1].bounds == Rectf{15, 15, 350, 30});
+static_assert(screen[2].bounds == Rectf{15, 55, 350, 40});
+static_assert(screen[3].bounds == Rectf{0, 0, 100, 35});
+static_assert(screen[4].bounds == Rectf{110, 0, 130, 35});   // 350 - 2 * 100 - 2 * 10
+static_assert(screen[5].bounds == Rectf{250, 0, 100, 35});
+static_assert(screen[5].absolute == Pointf{265, 55});
+static_assert(screen[2].first_child == 3 && screen[2].subtree_end == 6);
+
+static_assert(screen.find(1) == 5);
+static_assert(screen.hit_test(Pointf{300, 70}) == 5);
+static_assert(screen.hit_test(Pointf{200, 70}) == 4);
+static_assert(screen.hit_test(Pointf{5, 5}) == 0);
+static_assert(screen.hit_test(Pointf{500, 5}) == screen.npos);
+
+// Unset button colors fall back to Button's defaults
+static_assert(screen[3].hover_background == Color{230, 230, 230, 255});
+static_assert(screen[3].border == Color{128, 128, 128, 255});
+static_assert(screen[5].hover_background == hover);
+static_assert(screen[5].pressed_background == pressed);
+
+Color pixel_at(const SoftContext& ctx, const Pointf& point) {
+    int width = static_cast<int>(ctx.get_size().w);
+    uint32_t argb = ctx.pixels()[static_cast<int>(point.y) * width + static_cast<int>(point.x)];
+    return Color(static_cast<uint8_t>(argb >> 16), static_cast<uint8_t>(argb >> 8),
+                 static_cast<uint8_t>(argb), static_cast<uint8_t>(argb >> 24));
+}
+
+/**
+ * @brief Throw unless the left edge of a button is filled with the expected color
+ */
+void expect_fill(const SoftContext& ctx, const StaticNode& button, const Color& expected) {
+    Color actual = pixel_at(ctx, button.absolute + Pointf{6, button.bounds.size.h / 2});
+    if (actual.r != expected.r || actual.g != expected.g || actual.b != expected.b) {
+        throw std::runtime_error("button is not filled with the color from its description");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        SoftContext ctx(Size{380, 120});
+        if (argc > 1) ctx.add_font(FontFamily(), argv[1]);
+        Canvas canvas(ctx);
+
+        // The constexpr tree is the template; a copy carries the runtime state
+        auto tree = screen;
+        tree.set_state(tree.find(1), WidgetState::pressed, true);
+        tree.set_state(tree.find(2), WidgetState::hovered, true);
+
+        {
+            DrawScope scope(ctx);
+            canvas.begin_frame();
+            canvas.clear(Color(240, 240, 240, 255));
+            tree.render(canvas);
+        }
+
+        expect_fill(ctx, tree[tree.find(1)], pressed);
+        expect_fill(ctx, tree[tree.find(2)], Color{230, 230, 230, 255});
+        std::cout << sizeof(tree) << " bytes for " << tree.size() << " nodes, laid out at compile time\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
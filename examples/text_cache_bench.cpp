@@ -0,0 +1,163 @@
+/**
+ * @file text_cache_bench.cpp
+ * @brief Cold and warm start with the persistent text cache
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Simulates two launches of an app showing 3,000 wrapped labels
+ * through the software context. The first starts without a cache file,
+ * measures and rasterizes everything and writes the results back; the
+ * second maps that file and lays out and draws from it. A third starts
+ * after the file's last record was torn, as by a crash during a flush, and
+ * must keep every record before it. Reports the time to the first laid-out
+ * and drawn frame for each, and the cache counters. Each launch also
+ * measures a slider's value captions through the canvas; the warm start
+ * fails unless all of them come from the file, at the backend's sizes.
+ *
+ * Usage: zwidget_text_cache_bench <font.ttf> [cache file]
+ */
+
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace zuu::widget;
+
+namespace {
+
+const char* const words[] = {"layout", "glyph", "measure", "cache", "widget", "frame", "atlas",
+                             "text", "window", "render", "budget", "label", "button", "start"};
+
+WidgetPtr build_page() {
+    auto root = make_widget<Widget>();
+    root->set_bounds(Rectf{0.0f, 0.0f, 1200.0f, 900.0f});
+
+    auto column = make_widget<VBox>();
+    column->set_spacing(2.0f);
+    column->set_alignment(LayoutAlign::stretch);
+    column->set_bounds(Rectf{0.0f, 0.0f, 1200.0f, 100000.0f});
+
+    for (int i = 0; i < 3000; ++i) {
+        std::string text = "Row " + std::to_string(i) + ":";
+        for (int w = 0; w < 12; ++w) {
+            text += ' ';
+            text += words[(i * 7 + w * 3) % std::size(words)];
+        }
+        auto label = make_widget<Label>(text);
+        label->set_foreground(Color(0, 0, 0, 255));
+        label->set_text_style(TextStyle(FontFamily(), static_cast<float>(11 + i % 4)));
+        label->set_word_wrap(true);
+        label->set_preferred_size(Sizef{0, 32});
+        column->add_child(label);
+    }
+    root->add_child(column);
+    return root;
+}
+
+struct Launch {
+    TextCacheStats stats;
+    size_t caption_hits = 0;
+    bool captions_match = true;
+};
+
+/**
+ * @brief Measure the captions a 0-100 slider shows while dragged, as Slider::draw() does
+ */
+void measure_captions(SoftContext& ctx, Canvas& canvas, TextCacheFile& cache, Launch& out) {
+    TextStyle style;
+    style.font_size = 10.0f;
+    style.align = TextAlign::center;
+
+    size_t hits = cache.stats().hits;
+    for (int value = 0; value <= 100; ++value) {
+        std::wstring caption = std::to_wstring(value);
+        if (canvas.measure_text(caption, style) != ctx.measure_text(caption, style)) out.captions_match = false;
+    }
+    out.caption_hits = cache.stats().hits - hits;
+}
+
+Launch launch(const char* name, const std::string& font, const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+
+    SoftContext ctx(Size{1200, 900});
+    ctx.add_font(FontFamily(), font);
+    TextCacheFile cache(path, ctx.font_identity());
+    ctx.set_text_cache(&cache);
+    TextShaper::set_context(&ctx);
+    TextShaper::set_cache(&cache);
+    auto opened = std::chrono::steady_clock::now();
+
+    auto root = build_page();
+    auto built = std::chrono::steady_clock::now();
+    root->layout();
+    auto laid_out = std::chrono::steady_clock::now();
+
+    Canvas canvas(ctx);
+    {
+        DrawScope draw(ctx);
+        canvas.begin_frame();
+        canvas.clear(Color(255, 255, 255, 255));
+        root->render(canvas);
+    }
+    auto drawn = std::chrono::steady_clock::now();
+    Launch result;
+    measure_captions(ctx, canvas, cache, result);
+    cache.flush();
+    auto flushed = std::chrono::steady_clock::now();
+
+    auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+    TextCacheStats stats = cache.stats();
+    AtlasStats atlas = ctx.atlas_stats();
+    std::cout << name << ": open " << ms(start, opened) << " ms, layout " << ms(built, laid_out)
+              << " ms, first frame " << ms(laid_out, drawn) << " ms, flush " << ms(drawn, flushed) << " ms\n"
+              << "  cache: " << stats.loaded << " records loaded, " << stats.hits << " hits, "
+              << stats.misses << " misses, " << stats.written << " written"
+              << (stats.discarded ? ", stale file discarded" : "")
+              << (stats.repaired ? ", torn tail cut off" : "") << "\n"
+              << "  captions: " << result.caption_hits << " of 101 measured from the cache\n"
+              << "  glyphs: " << atlas.loaded << " loaded from the cache, "
+              << atlas.rasterized_total << " rasterized\n";
+
+    TextShaper::set_cache(nullptr);
+    TextShaper::set_context(nullptr);
+    result.stats = stats;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <font.ttf> [cache file]\n";
+        return 1;
+    }
+    std::string path = argc > 2 ? argv[2] : "zwidget_text_bench.cache";
+
+    try {
+        std::remove(path.c_str());
+        launch("cold start", argv[1], path);
+        Launch warm_launch = launch("warm start", argv[1], path);
+        if (warm_launch.caption_hits != 101 || !warm_launch.captions_match) {
+            throw std::runtime_error("captions were not measured from the cache on the second run");
+        }
+        TextCacheStats warm = warm_launch.stats;
+
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 7);
+        TextCacheStats torn = launch("torn tail", argv[1], path).stats;
+        if (!torn.repaired || torn.loaded + 1 != warm.loaded + warm.written) {
+            throw std::runtime_error("a torn tail lost more than its last record");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file text_edit_bench.cpp
+ * @brief Frame and edit cost of TextEdit on 1,000 and 150,000 line documents
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Loads a generated configuration file into a TextEdit drawn by
+ * the software context, then times frames at the top, after jumping to the
+ * middle and the end, and after typing or inserting a line there. With the
+ * line index and the per-line layout cache both documents should cost the
+ * same per frame; only the first frame after a jump shapes new lines.
+ *
+ * Usage: zwidget_text_edit_bench <font.ttf>
+ */
+
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include "zwidget/widgets/text_edit.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace zuu::widget;
+
+namespace {
+
+std::wstring make_config(size_t lines) {
+    std::wstring text;
+    for (size_t i = 0; i < lines; ++i) {
+        if (i % 20 == 0) {
+            text += L"[section_" + std::to_wstring(i / 20) + L"]\n";
+        } else {
+            text += L"key_" + std::to_wstring(i) + L" = value " + std::to_wstring(i * 7919 % 100000) + L"\n";
+        }
+    }
+    return text;
+}
+
+double frame_ms(SoftContext& ctx, Canvas& canvas, TextEdit& edit) {
+    auto start = std::chrono::steady_clock::now();
+    {
+        DrawScope draw(ctx);
+        canvas.begin_frame();
+        edit.render(canvas);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double steady_ms(SoftContext& ctx, Canvas& canvas, TextEdit& edit) {
+    constexpr int frames = 20;
+    double total = 0.0;
+    for (int i = 0; i < frames; ++i) total += frame_ms(ctx, canvas, edit);
+    return total / frames;
+}
+
+void run(const std::string& font, size_t line_count) {
+    SoftContext ctx(Size{800, 600});
+    ctx.add_font(FontFamily(), font);
+    TextShaper::set_context(&ctx);
+
+    TextEdit edit(make_config(line_count));
+    edit.set_bounds(Rectf{0.0f, 0.0f, 800.0f, 600.0f});
+    edit.set_focused(true);
+    Canvas canvas(ctx);
+
+    double first = frame_ms(ctx, canvas, edit);
+    double top = steady_ms(ctx, canvas, edit);
+
+    edit.set_cursor_position(edit.buffer().line_start(line_count / 2));
+    double jump = frame_ms(ctx, canvas, edit);
+    double middle = steady_ms(ctx, canvas, edit);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) edit.on_key_press('X');
+    double typing = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double typed = frame_ms(ctx, canvas, edit);
+
+    edit.on_key_press(VK_RETURN);
+    double newline = frame_ms(ctx, canvas, edit);
+
+    edit.set_cursor_position(edit.length());
+    double end_jump = frame_ms(ctx, canvas, edit);
+
+    std::cout << line_count << " lines: first frame " << first << " ms, steady " << top
+              << " ms; jump to middle " << jump << " ms, steady " << middle << " ms; 100 keys "
+              << typing << " ms, next frame " << typed << " ms; new line " << newline
+              << " ms; jump to end " << end_jump << " ms; " << edit.cached_lines() << " lines cached, "
+              << edit.buffer().pieces() << " pieces\n";
+
+    TextShaper::set_context(nullptr);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <font.ttf>\n";
+        return 1;
+    }
+
+    try {
+        run(argv[1], 1000);
+        run(argv[1], 150000);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
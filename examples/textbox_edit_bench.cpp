@@ -0,0 +1,90 @@
+/**
+ * @file textbox_edit_bench.cpp
+ * @brief Paste 5 MB into a TextBox and keep typing in the middle of it
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Pastes a 5 MB log into a TextBox, then types and deletes 10,000
+ * characters halfway through it, as a user fixing a line would. Each edit
+ * goes through the piece table and notifies a listener with the edited
+ * range. The same edits on a std::wstring, which TextBox used to store,
+ * are timed for comparison.
+ */
+
+#include "zwidget/widgets/textbox.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace zuu::widget;
+
+namespace {
+
+constexpr size_t log_chars = size_t{5} << 20;
+constexpr int keystrokes = 10000;
+
+std::wstring make_log() {
+    std::wstring log;
+    log.reserve(log_chars + 128);
+    for (size_t line = 0; log.size() < log_chars; ++line) {
+        log += L"2026-10-16 12:00:00 INFO worker ";
+        log += std::to_wstring(line);
+        log += L": request served in 12 ms\r\n";
+    }
+    return log;
+}
+
+double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    std::wstring log = make_log();
+
+    TextBox box;
+    size_t notified = 0;
+    box.set_on_text_changed([&](const TextChange& change) {
+        notified += change.inserted.size() + change.removed;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    box.insert_text(log);
+    double paste = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    box.set_cursor_position(box.length() / 2);
+    for (int i = 0; i < keystrokes; ++i) {
+        box.on_key_press(i % 4 == 3 ? uint32_t{VK_BACK} : uint32_t{'x'});
+    }
+    double typing = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    TextBuffer::Snapshot snapshot = box.snapshot();
+    double snap = ms_since(start);
+
+    std::cout << "piece table: paste " << paste << " ms, " << keystrokes << " keystrokes " << typing
+              << " ms, snapshot " << snap * 1000.0 << " us; " << box.length() << " chars in "
+              << box.buffer().pieces() << " pieces, " << notified << " chars notified\n";
+
+    // What the old std::wstring storage did for the same edits
+    std::wstring text;
+    start = std::chrono::steady_clock::now();
+    text.insert(0, log);
+    paste = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t cursor = text.size() / 2;
+    for (int i = 0; i < keystrokes; ++i) {
+        if (i % 4 == 3) {
+            text.erase(--cursor, 1);
+        } else {
+            text.insert(cursor++, 1, L'x');
+        }
+    }
+    typing = ms_since(start);
+
+    std::cout << "std::wstring: paste " << paste << " ms, " << keystrokes << " keystrokes " << typing << " ms\n";
+    return snapshot.equals(text) ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file textbox_hit_test_bench.cpp
+ * @brief Cost of mouse hit-testing in a TextBox during drag-select
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Sweeps the mouse across a full TextBox, as a drag-select does,
+ * and maps every x to a text position two ways: by measuring ever longer
+ * prefixes of the visible text until one reaches x, and with the TextBox's
+ * shaped view, where it is a binary search over advance prefix sums. Both
+ * must agree on every position; then the drag itself, with a frame per
+ * move, is timed.
+ *
+ * Usage: zwidget_textbox_hit_test_bench <font.ttf>
+ */
+
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/soft/context.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include "zwidget/widgets/textbox.hpp"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace zuu::widget;
+
+namespace {
+
+double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Hit-test as without a cached layout: measure prefixes until one reaches x
+ */
+size_t measure_prefixes(RenderContext& ctx, std::wstring_view text, const TextStyle& style, float x) {
+    float previous = 0.0f;
+    for (size_t i = 1; i <= text.size(); ++i) {
+        float w = ctx.measure_text(text.substr(0, i), style).w;
+        if (w > x) return x - previous > w - x ? i : i - 1;
+        previous = w;
+    }
+    return text.size();
+}
+
+void run(const std::string& font) {
+    SoftContext ctx(Size{600, 40});
+    ctx.add_font(FontFamily(), font);
+    TextShaper::set_context(&ctx);
+
+    std::wstring text;
+    for (int i = 0; text.size() < 4000; ++i) text += L"token_" + std::to_wstring(i) + L" ";
+
+    TextBox box(text);
+    box.set_bounds(Rectf{0.0f, 0.0f, 600.0f, 30.0f});
+    box.set_focused(true);
+    box.set_cursor_position(0);
+    Canvas canvas(ctx);
+    {
+        DrawScope draw(ctx);
+        canvas.begin_frame();
+        box.render(canvas);
+    }
+
+    constexpr int moves = 590;
+    std::wstring_view visible = std::wstring_view(text).substr(0, 200);
+    size_t mismatches = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t checksum = 0;
+    for (int x = 0; x < moves; ++x) checksum += measure_prefixes(ctx, visible, box.text_style(), static_cast<float>(x));
+    double measured = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t cached = 0;
+    for (int x = 0; x < moves; ++x) cached += box.offset_at(Pointf{static_cast<float>(x) + 5.0f, 15.0f});
+    double searched = ms_since(start);
+
+    for (int x = 0; x < moves; ++x) {
+        if (measure_prefixes(ctx, visible, box.text_style(), static_cast<float>(x)) !=
+            box.offset_at(Pointf{static_cast<float>(x) + 5.0f, 15.0f})) {
+            ++mismatches;
+        }
+    }
+
+    // A drag from the left edge to past the right one, drawing every move
+    start = std::chrono::steady_clock::now();
+    box.on_mouse_press(mouse_button::left, Pointf{5.0f, 15.0f});
+    for (int x = 0; x < moves + 200; ++x) {
+        box.on_mouse_move(Pointf{static_cast<float>(x) + 5.0f, 15.0f});
+        DrawScope draw(ctx);
+        canvas.begin_frame();
+        box.render(canvas);
+    }
+    box.on_mouse_release(mouse_button::left, Pointf{600.0f, 15.0f});
+    double drag = ms_since(start);
+
+    std::cout << moves << " hit tests: measuring prefixes " << measured << " ms, prefix sums " << searched
+              << " ms (" << (checksum == cached && mismatches == 0 ? "same positions" : "MISMATCH") << ")\n"
+              << moves + 200 << " drag moves with a frame each: " << drag << " ms, "
+              << box.get_selected_text().size() << " characters selected\n";
+
+    TextShaper::set_context(nullptr);
+    if (mismatches != 0) throw std::runtime_error("hit tests disagree");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <font.ttf>\n";
+        return 1;
+    }
+
+    try {
+        run(argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file view_reconcile_bench.cpp
+ * @brief Reordering keyed children with ViewTree
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Describes a VBox of 20,000 keyed rows and reconciles it against
+ * reordered descriptions: one row moved to either end, two rows swapped,
+ * the whole list reversed and shuffled, rows inserted and removed, the
+ * same rows again and rows appended. The last two take the linear path
+ * that skips the longest-run search and must move nothing. Reports the time and the moved children for each and checks that the
+ * live children end up in described order and that every row kept its
+ * widget. Reversal is then timed at 5,000 and 20,000 rows; four times the
+ * rows must cost well under sixteen times the time, or the run fails as
+ * superlinear. Last, it checks that a property left out of a description
+ * keeps its last value.
+ *
+ * Usage: zwidget_view_reconcile_bench
+ */
+
+#include "zwidget/core/view.hpp"
+#include "zwidget/widgets/label.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace zuu::widget;
+
+namespace {
+
+ViewNode describe(const std::vector<int>& rows) {
+    ViewNode list = view<VBox>();
+    for (int id : rows) {
+        list.child(view<Label>(std::to_string(id)).prop<&Widget::set_preferred_size>(Sizef{200, 18}));
+    }
+    return list;
+}
+
+/**
+ * @brief Reconcile against rows; widgets maps each row to the widget it had and is updated
+ */
+void run_case(ViewTree& tree, const char* name, const std::vector<int>& rows,
+              std::unordered_map<int, Widget*>& widgets) {
+    std::unordered_set<Widget*> before;
+    if (tree.root()) {
+        for (const auto& child : tree.root()->children()) before.insert(child.get());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    tree.update(describe(rows));
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const auto& live = tree.root()->children();
+    // A row that was there keeps its widget; a new row gets one that was not
+    bool ordered = live.size() == rows.size();
+    for (size_t i = 0; ordered && i < rows.size(); ++i) {
+        auto it = widgets.find(rows[i]);
+        ordered = it != widgets.end() ? it->second == live[i].get() : !before.contains(live[i].get());
+    }
+    widgets.clear();
+    for (size_t i = 0; i < live.size(); ++i) widgets.emplace(rows[i], live[i].get());
+
+    const ReconcileStats& stats = tree.stats();
+    std::cout << name << ": " << ms << " ms, " << stats.moved << " moved, " << stats.inserted << " inserted, "
+              << stats.removed << " removed, " << stats.created << " created\n";
+    if (!ordered) throw std::runtime_error(std::string(name) + ": live children out of order");
+}
+
+/**
+ * @brief Best of three reversals of a list of count keyed rows, in ms
+ */
+double time_reverse(int count) {
+    std::vector<int> rows(static_cast<size_t>(count));
+    std::iota(rows.begin(), rows.end(), 0);
+
+    ViewTree tree;
+    tree.update(describe(rows));
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        std::reverse(rows.begin(), rows.end());
+        ViewNode next = describe(rows);
+        auto start = std::chrono::steady_clock::now();
+        tree.update(std::move(next));
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    constexpr int count = 20000;
+    std::vector<int> rows(count);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    try {
+        ViewTree tree;
+        std::unordered_map<int, Widget*> widgets;
+        run_case(tree, "build", rows, widgets);
+
+        std::rotate(rows.begin(), rows.begin() + 1, rows.end());
+        run_case(tree, "first to last", rows, widgets);
+        std::rotate(rows.rbegin(), rows.rbegin() + 1, rows.rend());
+        run_case(tree, "last to first", rows, widgets);
+        std::swap(rows[10], rows[count - 10]);
+        run_case(tree, "swap two", rows, widgets);
+        std::reverse(rows.begin(), rows.end());
+        run_case(tree, "reverse", rows, widgets);
+        std::shuffle(rows.begin(), rows.end(), std::mt19937(7));
+        run_case(tree, "shuffle", rows, widgets);
+
+        rows.erase(rows.begin() + 100, rows.begin() + 200);
+        for (int i = 0; i < 100; ++i) rows.insert(rows.begin() + 5000, count + i);
+        run_case(tree, "remove 100, insert 100", rows, widgets);
+        run_case(tree, "unchanged", rows, widgets);
+        if (tree.stats().moved != 0) throw std::runtime_error("unchanged: rows were moved");
+        for (int i = 0; i < 100; ++i) rows.push_back(count + 100 + i);
+        run_case(tree, "append 100", rows, widgets);
+        if (tree.stats().moved != 0) throw std::runtime_error("append 100: rows were moved");
+
+        // Linear: 4x the rows is about 4x the time, quadratic would be 16x
+        double small = time_reverse(count / 4);
+        double large = time_reverse(count);
+        std::cout << "reverse " << count / 4 << ": " << small << " ms, reverse " << count << ": " << large
+                  << " ms (" << large / small << "x)\n";
+        if (large > small * 8.0) throw std::runtime_error("reversal time grows superlinearly");
+
+        // A property dropped from the description stays as last set
+        ViewNode list = describe(rows);
+        list.prop<&LayoutContainer::set_spacing>(3.0f);
+        tree.update(std::move(list));
+        tree.update(describe(rows));
+        float spacing = static_cast<LayoutContainer&>(*tree.root()).spacing();
+        std::cout << "spacing after its prop was dropped: " << spacing << "\n";
+        if (spacing != 3.0f) throw std::runtime_error("a dropped property was reset");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
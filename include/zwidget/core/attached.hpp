@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file attached.hpp
+ * @brief Sparse side storage for rarely set object fields
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Objects keep a small bit mask of which fields they have changed
+ * from the defaults; only those objects get an entry here. Reads of unset
+ * fields never touch the table.
+ */
+
+#include "zwidget/core/memory.hpp"
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace zuu::widget {
+
+/**
+ * @brief Map from owner to a block of attached fields, default-valued when absent
+ * Not synchronized: like the widget tree, it is mutated from the UI thread.
+ */
+template <typename Owner, typename Data>
+class AttachedStorage {
+private:
+    using Entry = std::pair<const Owner* const, Data>;
+    using Map = std::unordered_map<const Owner*, Data, std::hash<const Owner*>, std::equal_to<const Owner*>,
+                                   TrackingAllocator<Entry, MemoryTag::other>>;
+
+    Map entries_;
+
+public:
+    /**
+     * @brief Approximate heap cost of one entry (node plus bucket slot)
+     */
+    static constexpr size_t entry_bytes = sizeof(Entry) + 3 * sizeof(void*);
+
+    static const Data& defaults() {
+        static const Data instance{};
+        return instance;
+    }
+
+    /**
+     * @brief Fields of an owner, or the defaults if it has none
+     */
+    const Data& get(const Owner* owner) const {
+        auto it = entries_.find(owner);
+        return it != entries_.end() ? it->second : defaults();
+    }
+
+    /**
+     * @brief Mutable fields of an owner, created from the defaults on first use
+     */
+    Data& edit(const Owner* owner) {
+        return entries_.try_emplace(owner).first->second;
+    }
+
+    void erase(const Owner* owner) {
+        entries_.erase(owner);
+    }
+
+    size_t size() const { return entries_.size(); }
+};
+
+} // namespace zuu::widget
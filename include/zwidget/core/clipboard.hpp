@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @file clipboard.hpp
+ * @brief Unicode text on the system clipboard
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Shared by the editable widgets. Reading hands out a view of the
+ * clipboard's own memory for the duration of a callback, so pasting a large
+ * block copies it once, into the destination.
+ */
+
+#include <cstring>
+#include <cwchar>
+#include <string_view>
+#include <Windows.h>
+#undef min
+#undef max
+
+namespace zuu::widget::clipboard {
+
+/**
+ * @brief Replace the clipboard contents with text
+ */
+inline bool set_text(std::wstring_view text) {
+    if (!OpenClipboard(nullptr)) return false;
+    EmptyClipboard();
+
+    bool stored = false;
+    if (HGLOBAL memory = GlobalAlloc(GMEM_MOVEABLE, (text.size() + 1) * sizeof(wchar_t))) {
+        if (auto* dst = static_cast<wchar_t*>(GlobalLock(memory))) {
+            std::memcpy(dst, text.data(), text.size() * sizeof(wchar_t));
+            dst[text.size()] = L'\0';
+            GlobalUnlock(memory);
+            stored = SetClipboardData(CF_UNICODETEXT, memory) != nullptr;  // Owned by the clipboard then
+        }
+        if (!stored) GlobalFree(memory);
+    }
+    CloseClipboard();
+    return stored;
+}
+
+/**
+ * @brief Call f(std::wstring_view) with the clipboard text, if there is any
+ * The view is only valid during the call.
+ */
+template <typename F>
+bool read_text(F&& f) {
+    if (!OpenClipboard(nullptr)) return false;
+
+    bool read = false;
+    if (HANDLE data = GetClipboardData(CF_UNICODETEXT)) {
+        if (auto* chars = static_cast<const wchar_t*>(GlobalLock(data))) {
+            f(std::wstring_view(chars, wcsnlen(chars, GlobalSize(data) / sizeof(wchar_t))));
+            GlobalUnlock(data);
+            read = true;
+        }
+    }
+    CloseClipboard();
+    return read;
+}
+
+} // namespace zuu::widget::clipboard
@@ -0,0 +1,823 @@
+#pragma once
+
+/**
+ * @file constraint_solver.hpp
+ * @brief Incremental linear constraint solver (Cassowary)
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Constraints are linear equalities/inequalities over variables,
+ * each with a strength; non-required ones may be violated, weighted by
+ * strength. The solver keeps the simplex tableau between calls: adding or
+ * removing a constraint pivots from the current solution, and edit
+ * variables (window size, a dragged splitter) take new values through
+ * suggest_value(), which only touches the rows that reference them and
+ * restores feasibility with the dual simplex.
+ *
+ * Based on "The Cassowary Linear Arithmetic Constraint Solving Algorithm"
+ * (Badros, Borning, Stuckey, 2001).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace zuu::widget {
+
+// === Strength ===
+
+/**
+ * @brief Constraint strengths; stronger always wins over any number of weaker
+ */
+namespace strength {
+    constexpr double create(double strong, double medium, double weak, double weight = 1.0) {
+        auto clip = [](double v) { return v < 0.0 ? 0.0 : (v > 1000.0 ? 1000.0 : v); };
+        return clip(strong * weight) * 1000000.0 + clip(medium * weight) * 1000.0 + clip(weak * weight);
+    }
+
+    inline constexpr double required = create(1000.0, 1000.0, 1000.0);
+    inline constexpr double strong = create(1.0, 0.0, 0.0);
+    inline constexpr double medium = create(0.0, 1.0, 0.0);
+    inline constexpr double weak = create(0.0, 0.0, 1.0);
+
+    constexpr double clip(double value) {
+        return value < 0.0 ? 0.0 : (value > required ? required : value);
+    }
+}
+
+// === Variables and Expressions ===
+
+/**
+ * @brief Solver unknown; copies refer to the same variable
+ */
+class LayoutVariable {
+private:
+    struct Data {
+        std::string name;
+        double value = 0.0;
+    };
+
+    std::shared_ptr<Data> data_;
+
+public:
+    LayoutVariable() : LayoutVariable(std::string{}) {}
+    explicit LayoutVariable(std::string name) : data_(std::make_shared<Data>(Data{std::move(name)})) {}
+
+    const std::string& name() const { return data_->name; }
+    double value() const { return data_->value; }
+
+    /**
+     * @brief Identity, for use as a map key
+     */
+    const void* id() const { return data_.get(); }
+
+    bool same(const LayoutVariable& other) const { return data_ == other.data_; }
+
+private:
+    friend class ConstraintSolver;
+    void set_value(double value) const { data_->value = value; }
+};
+
+/**
+ * @brief coefficient * variable
+ */
+struct LayoutTerm {
+    LayoutVariable variable;
+    double coefficient = 1.0;
+};
+
+/**
+ * @brief Sum of terms plus a constant
+ */
+class LayoutExpression {
+private:
+    std::vector<LayoutTerm> terms_;
+    double constant_ = 0.0;
+
+public:
+    LayoutExpression(double constant = 0.0) : constant_(constant) {}
+    LayoutExpression(const LayoutVariable& variable) : terms_{LayoutTerm{variable, 1.0}} {}
+    LayoutExpression(const LayoutTerm& term) : terms_{term} {}
+
+    const std::vector<LayoutTerm>& terms() const { return terms_; }
+    double constant() const { return constant_; }
+
+    /**
+     * @brief Current value from the variables' last solved values
+     */
+    double value() const {
+        double result = constant_;
+        for (const auto& term : terms_) {
+            result += term.coefficient * term.variable.value();
+        }
+        return result;
+    }
+
+    LayoutExpression& operator+=(const LayoutExpression& other) {
+        terms_.insert(terms_.end(), other.terms_.begin(), other.terms_.end());
+        constant_ += other.constant_;
+        return *this;
+    }
+
+    LayoutExpression& operator*=(double factor) {
+        for (auto& term : terms_) {
+            term.coefficient *= factor;
+        }
+        constant_ *= factor;
+        return *this;
+    }
+};
+
+inline LayoutExpression operator+(LayoutExpression lhs, const LayoutExpression& rhs) { return lhs += rhs; }
+inline LayoutExpression operator*(LayoutExpression lhs, double factor) { return lhs *= factor; }
+inline LayoutExpression operator*(double factor, LayoutExpression rhs) { return rhs *= factor; }
+inline LayoutExpression operator/(LayoutExpression lhs, double divisor) { return lhs *= 1.0 / divisor; }
+inline LayoutExpression operator-(LayoutExpression expr) { return expr *= -1.0; }
+inline LayoutExpression operator-(LayoutExpression lhs, const LayoutExpression& rhs) { return lhs += -rhs; }
+
+// === Constraints ===
+
+enum class RelationalOperator : uint8_t {
+    less_equal,
+    greater_equal,
+    equal
+};
+
+/**
+ * @brief expression (op) 0 with a strength; copies refer to the same constraint
+ */
+class LayoutConstraint {
+private:
+    struct Data {
+        LayoutExpression expression;  // lhs - rhs
+        RelationalOperator op;
+        double strength;
+    };
+
+    std::shared_ptr<const Data> data_;
+
+public:
+    LayoutConstraint(const LayoutExpression& lhs, RelationalOperator op, const LayoutExpression& rhs,
+                     double strength = strength::required)
+        : data_(std::make_shared<const Data>(Data{lhs - rhs, op, strength::clip(strength)})) {}
+
+    const LayoutExpression& expression() const { return data_->expression; }
+    RelationalOperator op() const { return data_->op; }
+    double strength() const { return data_->strength; }
+
+    const void* id() const { return data_.get(); }
+
+    /**
+     * @brief Same constraint with another strength
+     */
+    LayoutConstraint with_strength(double strength) const {
+        return LayoutConstraint(data_->expression, data_->op, 0.0, strength);
+    }
+};
+
+inline LayoutConstraint operator==(const LayoutExpression& lhs, const LayoutExpression& rhs) {
+    return LayoutConstraint(lhs, RelationalOperator::equal, rhs);
+}
+
+inline LayoutConstraint operator<=(const LayoutExpression& lhs, const LayoutExpression& rhs) {
+    return LayoutConstraint(lhs, RelationalOperator::less_equal, rhs);
+}
+
+inline LayoutConstraint operator>=(const LayoutExpression& lhs, const LayoutExpression& rhs) {
+    return LayoutConstraint(lhs, RelationalOperator::greater_equal, rhs);
+}
+
+/**
+ * @brief Attach a strength: (a == b) | strength::weak
+ */
+inline LayoutConstraint operator|(const LayoutConstraint& constraint, double strength) {
+    return constraint.with_strength(strength);
+}
+
+// === Solver ===
+
+/**
+ * @brief Incremental simplex solver over LayoutConstraints
+ * Throws std::runtime_error for duplicate, unknown or unsatisfiable
+ * required constraints; a rejected constraint leaves the system as it was,
+ * though among equally good solutions it may settle on another one.
+ * Call update_variables() to publish the solution.
+ */
+class ConstraintSolver {
+private:
+    struct Symbol {
+        enum class Type : uint8_t { invalid, external, slack, error, dummy };
+
+        uint64_t id = 0;
+        Type type = Type::invalid;
+
+        bool valid() const { return type != Type::invalid; }
+        bool operator<(const Symbol& other) const { return id < other.id; }
+    };
+
+    static bool near_zero(double value) {
+        return std::abs(value) < 1.0e-8;
+    }
+
+    struct Cell {
+        Symbol symbol;
+        double coefficient;
+    };
+
+    /**
+     * @brief basic = constant + sum(coefficient * symbol)
+     * Cells are kept sorted by symbol in a flat vector: lookups are binary
+     * searches and adding one row to another is a linear merge, which beats
+     * a node-based map on the dense rows large layouts produce.
+     */
+    class Row {
+    private:
+        using Cells = std::vector<Cell>;
+
+        Cells::iterator find(const Symbol& symbol) {
+            return std::lower_bound(cells.begin(), cells.end(), symbol,
+                [](const Cell& cell, const Symbol& s) { return cell.symbol < s; });
+        }
+
+        Cells::const_iterator find(const Symbol& symbol) const {
+            return std::lower_bound(cells.begin(), cells.end(), symbol,
+                [](const Cell& cell, const Symbol& s) { return cell.symbol < s; });
+        }
+
+        bool at(Cells::const_iterator it, const Symbol& symbol) const {
+            return it != cells.end() && it->symbol.id == symbol.id;
+        }
+
+    public:
+        Cells cells;
+        double constant = 0.0;
+
+        explicit Row(double c = 0.0) : constant(c) {}
+
+        double add(double value) { return constant += value; }
+
+        void insert(const Symbol& symbol, double coefficient = 1.0) {
+            auto it = find(symbol);
+            if (at(it, symbol)) {
+                it->coefficient += coefficient;
+                if (near_zero(it->coefficient)) cells.erase(it);
+            } else if (!near_zero(coefficient)) {
+                cells.insert(it, Cell{symbol, coefficient});
+            }
+        }
+
+        /**
+         * @brief this += row * coefficient, merging the sorted cell lists
+         */
+        void insert(const Row& row, double coefficient = 1.0) {
+            constant += row.constant * coefficient;
+            if (row.cells.empty()) return;
+
+            Cells merged;
+            merged.reserve(cells.size() + row.cells.size());
+
+            auto a = cells.begin();
+            auto b = row.cells.begin();
+            while (a != cells.end() || b != row.cells.end()) {
+                if (b == row.cells.end() || (a != cells.end() && a->symbol < b->symbol)) {
+                    merged.push_back(*a++);
+                } else if (a == cells.end() || b->symbol < a->symbol) {
+                    merged.push_back(Cell{b->symbol, b->coefficient * coefficient});
+                    ++b;
+                } else {
+                    double value = a->coefficient + b->coefficient * coefficient;
+                    if (!near_zero(value)) merged.push_back(Cell{a->symbol, value});
+                    ++a;
+                    ++b;
+                }
+            }
+            cells.swap(merged);
+        }
+
+        void remove(const Symbol& symbol) {
+            auto it = find(symbol);
+            if (at(it, symbol)) cells.erase(it);
+        }
+
+        void reverse_sign() {
+            constant = -constant;
+            for (auto& cell : cells) cell.coefficient = -cell.coefficient;
+        }
+
+        /**
+         * @brief Rewrite 0 = row so that symbol is the subject
+         */
+        void solve_for(const Symbol& symbol) {
+            auto it = find(symbol);
+            double coefficient = -1.0 / it->coefficient;
+            cells.erase(it);
+            constant *= coefficient;
+            for (auto& cell : cells) cell.coefficient *= coefficient;
+        }
+
+        /**
+         * @brief Rewrite lhs = row so that rhs is the subject
+         */
+        void solve_for(const Symbol& lhs, const Symbol& rhs) {
+            insert(lhs, -1.0);
+            solve_for(rhs);
+        }
+
+        double coefficient_for(const Symbol& symbol) const {
+            auto it = find(symbol);
+            return at(it, symbol) ? it->coefficient : 0.0;
+        }
+
+        void substitute(const Symbol& symbol, const Row& row) {
+            auto it = find(symbol);
+            if (at(it, symbol)) {
+                double coefficient = it->coefficient;
+                cells.erase(it);
+                insert(row, coefficient);
+            }
+        }
+    };
+
+    struct Tag {
+        Symbol marker;
+        Symbol other;
+    };
+
+    struct Edit {
+        Tag tag;
+        LayoutConstraint constraint;
+        double constant = 0.0;
+    };
+
+    struct ConstraintEntry {
+        Tag tag;
+        LayoutConstraint constraint;
+    };
+
+    std::map<const void*, ConstraintEntry> constraints_;
+    std::map<Symbol, Row> rows_;
+    std::map<const void*, std::pair<LayoutVariable, Symbol>> variables_;
+    std::map<const void*, Edit> edits_;
+    std::vector<Symbol> infeasible_rows_;
+    Row objective_;
+    std::unique_ptr<Row> artificial_;
+    uint64_t next_id_ = 1;
+
+    Symbol make_symbol(Symbol::Type type) {
+        return Symbol{next_id_++, type};
+    }
+
+    Symbol variable_symbol(const LayoutVariable& variable) {
+        auto it = variables_.find(variable.id());
+        if (it != variables_.end()) return it->second.second;
+
+        Symbol symbol = make_symbol(Symbol::Type::external);
+        variables_.emplace(variable.id(), std::make_pair(variable, symbol));
+        return symbol;
+    }
+
+    /**
+     * @brief Tableau row for a constraint, with slack/error/dummy markers
+     */
+    Row create_row(const LayoutConstraint& constraint, Tag& tag) {
+        const LayoutExpression& expr = constraint.expression();
+        Row row(expr.constant());
+
+        for (const auto& term : expr.terms()) {
+            if (near_zero(term.coefficient)) continue;
+
+            Symbol symbol = variable_symbol(term.variable);
+            auto it = rows_.find(symbol);
+            if (it != rows_.end()) {
+                row.insert(it->second, term.coefficient);
+            } else {
+                row.insert(symbol, term.coefficient);
+            }
+        }
+
+        switch (constraint.op()) {
+            case RelationalOperator::less_equal:
+            case RelationalOperator::greater_equal: {
+                double coefficient = constraint.op() == RelationalOperator::less_equal ? 1.0 : -1.0;
+                Symbol slack = make_symbol(Symbol::Type::slack);
+                tag.marker = slack;
+                row.insert(slack, coefficient);
+                if (constraint.strength() < strength::required) {
+                    Symbol error = make_symbol(Symbol::Type::error);
+                    tag.other = error;
+                    row.insert(error, -coefficient);
+                    objective_.insert(error, constraint.strength());
+                }
+                break;
+            }
+            case RelationalOperator::equal:
+                if (constraint.strength() < strength::required) {
+                    Symbol plus = make_symbol(Symbol::Type::error);
+                    Symbol minus = make_symbol(Symbol::Type::error);
+                    tag.marker = plus;
+                    tag.other = minus;
+                    row.insert(plus, -1.0);
+                    row.insert(minus, 1.0);
+                    objective_.insert(plus, constraint.strength());
+                    objective_.insert(minus, constraint.strength());
+                } else {
+                    Symbol dummy = make_symbol(Symbol::Type::dummy);
+                    tag.marker = dummy;
+                    row.insert(dummy);
+                }
+                break;
+        }
+
+        if (row.constant < 0.0) {
+            row.reverse_sign();
+        }
+        return row;
+    }
+
+    static Symbol choose_subject(const Row& row, const Tag& tag) {
+        for (const auto& [symbol, value] : row.cells) {
+            if (symbol.type == Symbol::Type::external) return symbol;
+        }
+        for (const Symbol& symbol : {tag.marker, tag.other}) {
+            if ((symbol.type == Symbol::Type::slack || symbol.type == Symbol::Type::error) &&
+                row.coefficient_for(symbol) < 0.0) {
+                return symbol;
+            }
+        }
+        return Symbol{};
+    }
+
+    static bool all_dummies(const Row& row) {
+        for (const auto& [symbol, value] : row.cells) {
+            if (symbol.type != Symbol::Type::dummy) return false;
+        }
+        return true;
+    }
+
+    static Symbol any_pivotable_symbol(const Row& row) {
+        for (const auto& [symbol, value] : row.cells) {
+            if (symbol.type == Symbol::Type::slack || symbol.type == Symbol::Type::error) return symbol;
+        }
+        return Symbol{};
+    }
+
+    void substitute(const Symbol& symbol, const Row& row) {
+        for (auto& [basic, r] : rows_) {
+            r.substitute(symbol, row);
+            if (basic.type != Symbol::Type::external && r.constant < 0.0) {
+                infeasible_rows_.push_back(basic);
+            }
+        }
+        objective_.substitute(symbol, row);
+        if (artificial_) {
+            artificial_->substitute(symbol, row);
+        }
+    }
+
+    /**
+     * @brief Make 'entering' basic using the row of 'leaving'
+     * Symbols are taken by value: callers pass the key of the row erased here.
+     */
+    void pivot(std::map<Symbol, Row>::iterator it, Symbol leaving, Symbol entering) {
+        Row row = std::move(it->second);
+        rows_.erase(it);
+        row.solve_for(leaving, entering);
+        substitute(entering, row);
+        rows_.emplace(entering, std::move(row));
+    }
+
+    /**
+     * @brief Add row through an artificial variable; false if it cannot be satisfied
+     * On failure the artificial variable is still basic, so no other row and
+     * not the objective refer to it: dropping its row leaves the original
+     * system, only pivoted, and optimizing again restores its solution.
+     */
+    bool add_with_artificial_variable(const Row& row) {
+        Symbol art = make_symbol(Symbol::Type::slack);
+        rows_.emplace(art, row);
+        artificial_ = std::make_unique<Row>(row);
+
+        optimize(*artificial_);
+        bool success = near_zero(artificial_->constant);
+        artificial_.reset();
+
+        auto it = rows_.find(art);
+        if (!success) {
+            if (it != rows_.end()) rows_.erase(it);
+            infeasible_rows_.clear();
+            optimize(objective_);
+            return false;
+        }
+
+        if (it != rows_.end()) {
+            if (it->second.cells.empty()) {
+                rows_.erase(it);
+                return true;
+            }
+            Symbol entering = any_pivotable_symbol(it->second);
+            if (!entering.valid()) {
+                rows_.erase(it);
+                infeasible_rows_.clear();
+                optimize(objective_);
+                return false;
+            }
+            pivot(it, art, entering);
+        }
+
+        for (auto& [basic, r] : rows_) {
+            r.remove(art);
+        }
+        objective_.remove(art);
+        return true;
+    }
+
+    /**
+     * @brief Primal simplex: minimize the objective while staying feasible
+     */
+    void optimize(const Row& objective) {
+        for (;;) {
+            Symbol entering;
+            for (const auto& [symbol, value] : objective.cells) {
+                if (symbol.type != Symbol::Type::dummy && value < 0.0) {
+                    entering = symbol;
+                    break;
+                }
+            }
+            if (!entering.valid()) return;
+
+            auto leaving = rows_.end();
+            double ratio = std::numeric_limits<double>::max();
+            for (auto it = rows_.begin(); it != rows_.end(); ++it) {
+                if (it->first.type == Symbol::Type::external) continue;
+                double coefficient = it->second.coefficient_for(entering);
+                if (coefficient < 0.0) {
+                    double r = -it->second.constant / coefficient;
+                    if (r < ratio) {
+                        ratio = r;
+                        leaving = it;
+                    }
+                }
+            }
+            if (leaving == rows_.end()) {
+                throw std::runtime_error("Constraint objective is unbounded");
+            }
+            pivot(leaving, leaving->first, entering);
+        }
+    }
+
+    /**
+     * @brief Dual simplex: restore feasibility after edit constants changed
+     */
+    void dual_optimize() {
+        while (!infeasible_rows_.empty()) {
+            Symbol leaving = infeasible_rows_.back();
+            infeasible_rows_.pop_back();
+
+            auto it = rows_.find(leaving);
+            if (it == rows_.end() || near_zero(it->second.constant) || it->second.constant >= 0.0) continue;
+
+            Symbol entering;
+            double ratio = std::numeric_limits<double>::max();
+            for (const auto& [symbol, value] : it->second.cells) {
+                if (value > 0.0 && symbol.type != Symbol::Type::dummy) {
+                    double r = objective_.coefficient_for(symbol) / value;
+                    if (r < ratio) {
+                        ratio = r;
+                        entering = symbol;
+                    }
+                }
+            }
+            if (!entering.valid()) {
+                throw std::runtime_error("Constraint dual optimize failed");
+            }
+            pivot(it, leaving, entering);
+        }
+    }
+
+    /**
+     * @brief Row to pivot out when removing a non-basic marker
+     */
+    std::map<Symbol, Row>::iterator marker_leaving_row(const Symbol& marker) {
+        double r1 = std::numeric_limits<double>::max();
+        double r2 = r1;
+        auto first = rows_.end();
+        auto second = rows_.end();
+        auto third = rows_.end();
+
+        for (auto it = rows_.begin(); it != rows_.end(); ++it) {
+            double c = it->second.coefficient_for(marker);
+            if (c == 0.0) continue;
+
+            if (it->first.type == Symbol::Type::external) {
+                third = it;
+            } else if (c < 0.0) {
+                double r = -it->second.constant / c;
+                if (r < r1) {
+                    r1 = r;
+                    first = it;
+                }
+            } else {
+                double r = it->second.constant / c;
+                if (r < r2) {
+                    r2 = r;
+                    second = it;
+                }
+            }
+        }
+        return first != rows_.end() ? first : (second != rows_.end() ? second : third);
+    }
+
+    void remove_marker_effects(const Symbol& marker, double strength) {
+        auto it = rows_.find(marker);
+        if (it != rows_.end()) {
+            objective_.insert(it->second, -strength);
+        } else {
+            objective_.insert(marker, -strength);
+        }
+    }
+
+public:
+    // === Constraints ===
+
+    void add_constraint(const LayoutConstraint& constraint) {
+        if (constraints_.count(constraint.id())) {
+            throw std::runtime_error("Duplicate constraint");
+        }
+
+        Tag tag;
+        Row row = create_row(constraint, tag);
+        Symbol subject = choose_subject(row, tag);
+
+        if (!subject.valid() && all_dummies(row)) {
+            if (!near_zero(row.constant)) {
+                throw std::runtime_error("Unsatisfiable constraint");
+            }
+            subject = tag.marker;
+        }
+
+        if (!subject.valid()) {
+            if (!add_with_artificial_variable(row)) {
+                throw std::runtime_error("Unsatisfiable constraint");
+            }
+        } else {
+            row.solve_for(subject);
+            substitute(subject, row);
+            rows_.emplace(subject, std::move(row));
+        }
+
+        constraints_.emplace(constraint.id(), ConstraintEntry{tag, constraint});
+        optimize(objective_);
+    }
+
+    void remove_constraint(const LayoutConstraint& constraint) {
+        auto entry = constraints_.find(constraint.id());
+        if (entry == constraints_.end()) {
+            throw std::runtime_error("Unknown constraint");
+        }
+
+        Tag tag = entry->second.tag;
+        double strength = entry->second.constraint.strength();
+        constraints_.erase(entry);
+
+        if (tag.marker.type == Symbol::Type::error) remove_marker_effects(tag.marker, strength);
+        if (tag.other.type == Symbol::Type::error) remove_marker_effects(tag.other, strength);
+
+        auto it = rows_.find(tag.marker);
+        if (it != rows_.end()) {
+            rows_.erase(it);
+        } else {
+            auto leaving = marker_leaving_row(tag.marker);
+            if (leaving == rows_.end()) {
+                throw std::runtime_error("Failed to find leaving row");
+            }
+            pivot(leaving, leaving->first, tag.marker);
+            rows_.erase(tag.marker);
+        }
+
+        optimize(objective_);
+    }
+
+    bool has_constraint(const LayoutConstraint& constraint) const {
+        return constraints_.count(constraint.id()) != 0;
+    }
+
+    size_t constraint_count() const { return constraints_.size(); }
+
+    // === Edit Variables ===
+
+    /**
+     * @brief Make a variable suggestible; strength must be below required
+     */
+    void add_edit_variable(const LayoutVariable& variable, double strength = strength::strong) {
+        if (edits_.count(variable.id())) {
+            throw std::runtime_error("Duplicate edit variable");
+        }
+        strength = std::min(strength, strength::strong);
+
+        LayoutConstraint constraint(variable, RelationalOperator::equal, 0.0, strength);
+        add_constraint(constraint);
+        edits_.emplace(variable.id(), Edit{constraints_.at(constraint.id()).tag, constraint, 0.0});
+    }
+
+    void remove_edit_variable(const LayoutVariable& variable) {
+        auto it = edits_.find(variable.id());
+        if (it == edits_.end()) {
+            throw std::runtime_error("Unknown edit variable");
+        }
+        remove_constraint(it->second.constraint);
+        edits_.erase(it);
+    }
+
+    bool has_edit_variable(const LayoutVariable& variable) const {
+        return edits_.count(variable.id()) != 0;
+    }
+
+    /**
+     * @brief Move an edit variable toward a value
+     * Only rows that reference the edit's marker change; the dual simplex
+     * then pivots just the rows that became infeasible.
+     */
+    void suggest_value(const LayoutVariable& variable, double value) {
+        auto it = edits_.find(variable.id());
+        if (it == edits_.end()) {
+            throw std::runtime_error("Unknown edit variable");
+        }
+
+        Edit& edit = it->second;
+        double delta = value - edit.constant;
+        edit.constant = value;
+
+        auto marker = rows_.find(edit.tag.marker);
+        if (marker != rows_.end()) {
+            if (marker->second.add(-delta) < 0.0) infeasible_rows_.push_back(marker->first);
+            dual_optimize();
+            return;
+        }
+
+        auto other = rows_.find(edit.tag.other);
+        if (other != rows_.end()) {
+            if (other->second.add(delta) < 0.0) infeasible_rows_.push_back(other->first);
+            dual_optimize();
+            return;
+        }
+
+        for (auto& [basic, row] : rows_) {
+            double coefficient = row.coefficient_for(edit.tag.marker);
+            if (coefficient != 0.0 && row.add(delta * coefficient) < 0.0 &&
+                basic.type != Symbol::Type::external) {
+                infeasible_rows_.push_back(basic);
+            }
+        }
+        dual_optimize();
+    }
+
+    // === Results ===
+
+    /**
+     * @brief Approximate heap held by the tableau and the solver's maps
+     */
+    size_t heap_bytes() const {
+        constexpr size_t node = 4 * sizeof(void*);  // Tree links and color of a map node
+        size_t bytes = objective_.cells.capacity() * sizeof(Cell) + infeasible_rows_.capacity() * sizeof(Symbol);
+        for (const auto& [symbol, row] : rows_) {
+            bytes += node + sizeof(std::pair<const Symbol, Row>) + row.cells.capacity() * sizeof(Cell);
+        }
+        bytes += constraints_.size() * (node + sizeof(std::pair<const void* const, ConstraintEntry>));
+        bytes += variables_.size() * (node + sizeof(std::pair<const void* const, std::pair<LayoutVariable, Symbol>>));
+        bytes += edits_.size() * (node + sizeof(std::pair<const void* const, Edit>));
+        return bytes;
+    }
+
+    /**
+     * @brief Copy the current solution into the variables
+     */
+    void update_variables() {
+        for (auto& [id, entry] : variables_) {
+            auto it = rows_.find(entry.second);
+            entry.first.set_value(it != rows_.end() ? it->second.constant : 0.0);
+        }
+    }
+
+    /**
+     * @brief Drop all constraints and variables
+     */
+    void reset() {
+        constraints_.clear();
+        rows_.clear();
+        variables_.clear();
+        edits_.clear();
+        infeasible_rows_.clear();
+        objective_ = Row();
+        artificial_.reset();
+        next_id_ = 1;
+    }
+};
+
+} // namespace zuu::widget
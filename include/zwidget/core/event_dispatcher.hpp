@@ -7,8 +7,10 @@
  * @date 2025-11-29
  */
 
+#include "zwidget/core/memory.hpp"
 #include "zwidget/unit/event.hpp"
 #include <algorithm>
+#include <deque>
 #include <queue>
 #include <functional>
 #include <unordered_map>
@@ -38,7 +40,7 @@ struct PrioritizedListener {
  */
 class EventDispatcher {
 private:
-    std::queue<Event> event_queue_;
+    std::queue<Event, std::deque<Event, TrackingAllocator<Event, MemoryTag::events>>> event_queue_;
     
     // Listeners per event type
     std::unordered_map<event_type, std::vector<PrioritizedListener>> listeners_;
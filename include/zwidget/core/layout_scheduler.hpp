@@ -0,0 +1,191 @@
+#pragma once
+
+/**
+ * @file layout_scheduler.hpp
+ * @brief Time-sliced layout: resumable across frames under a per-frame budget
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Replaces the per-frame root->update_layout() call. Containers of
+ * at least min_subtree widgets place their children but postpone the
+ * children's own layout to a queue, so the work is split per subtree and
+ * run() can stop at its deadline and resume next frame. Subtrees that
+ * intersect the viewport are laid out first; postponed subtrees are not
+ * drawn until they are placed, while everything already placed renders
+ * normally.
+ *
+ * A container with at least min_subtree children is itself split with
+ * Widget::resume_layout(): its children are measured ahead and then placed
+ * a slice at a time, so even a single very wide container cannot hold a
+ * frame much past the deadline. Only its own measure over the measured
+ * children and one arrange_content() pass, which just computes rects, run
+ * unsplit. HBox and VBox place the children in the viewport while the rest
+ * are still being measured, so a long list shows its first rows in the
+ * first frame.
+ */
+
+#include "zwidget/core/widget.hpp"
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+
+namespace zuu::widget {
+
+/**
+ * @brief Counters of the last run()
+ */
+struct LayoutSliceStats {
+    size_t steps = 0;      // Subtrees laid out
+    size_t deferred = 0;   // Subtrees postponed during the run
+    size_t remaining = 0;  // Still queued when the run stopped
+};
+
+/**
+ * @brief Incremental layout driver for one root; the root must outlive it
+ */
+class LayoutScheduler : public LayoutDeferral {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Widget& root_;
+    std::deque<std::weak_ptr<Widget>> visible_;    // Intersect the viewport
+    std::deque<std::weak_ptr<Widget>> offscreen_;
+    std::optional<Rectf> viewport_;
+    LayoutSliceStats stats_;
+    Clock::time_point deadline_;
+
+    // A container stopped at the deadline; the root is not necessarily owned by a shared_ptr
+    std::weak_ptr<Widget> resuming_;
+    bool resuming_root_ = false;
+    LayoutProgress progress_;
+
+    /**
+     * @brief Lay out widget, or as much as fits; false if it is to be resumed
+     */
+    bool step(Widget& widget) {
+        if (widget.resume_layout(progress_, *this)) return true;
+        resuming_root_ = &widget == &root_;
+        if (!resuming_root_) resuming_ = widget.weak_from_this();
+        return false;
+    }
+
+    bool resuming() const { return resuming_root_ || !resuming_.expired(); }
+
+    void stop_resuming() {
+        resuming_.reset();
+        resuming_root_ = false;
+        progress_.reset();
+    }
+
+    WidgetPtr pop() {
+        for (auto* queue : {&visible_, &offscreen_}) {
+            while (!queue->empty()) {
+                WidgetPtr widget = queue->front().lock();
+                queue->pop_front();
+                if (widget && widget->needs_layout() && attached(*widget)) {
+                    return widget;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Still under the root (it may have been removed since it was queued)
+     */
+    bool attached(const Widget& widget) const {
+        for (const Widget* w = &widget; w; w = w->parent()) {
+            if (w == &root_) return true;
+        }
+        return false;
+    }
+
+public:
+    explicit LayoutScheduler(Widget& root, size_t min_subtree = 256) : root_(root) {
+        this->min_subtree = min_subtree;
+    }
+
+    LayoutScheduler(const LayoutScheduler&) = delete;
+    LayoutScheduler& operator=(const LayoutScheduler&) = delete;
+
+    /**
+     * @brief Area to lay out first, in root coordinates (default: everything)
+     */
+    void set_viewport(const Rectf& viewport) { viewport_ = viewport; }
+
+    void defer(Widget& widget) override {
+        bool visible = true;
+        if (viewport_) {
+            visible = Rectf{widget.absolute_position(), widget.size()}.intersects(*viewport_);
+        }
+        (visible ? visible_ : offscreen_).push_back(widget.weak_from_this());
+        stats_.deferred++;
+    }
+
+    bool expired() const override { return Clock::now() >= deadline_; }
+    
+    std::optional<Rectf> viewport() const override { return viewport_; }
+
+    /**
+     * @brief Start over from the root, e.g. after the window was resized
+     */
+    void relayout() {
+        stop_resuming();
+        visible_.clear();
+        offscreen_.clear();
+        root_.invalidate_layout();
+    }
+
+    /**
+     * @brief Whether layout work is left
+     */
+    bool pending() const {
+        return resuming() || !visible_.empty() || !offscreen_.empty() || root_.needs_layout();
+    }
+
+    /**
+     * @brief Lay out until done or the budget is spent; true when done
+     * At least one step runs, so progress is made even with a tiny budget.
+     */
+    bool run(std::chrono::microseconds budget) {
+        deadline_ = Clock::now() + budget;
+        stats_ = LayoutSliceStats{};
+
+        for (;;) {
+            WidgetPtr held = resuming_.lock();
+            Widget* next = resuming_root_ ? &root_ : held.get();
+            resuming_.reset();
+            resuming_root_ = false;
+            if (!next || !attached(*next)) {
+                progress_.reset();
+                next = (held = pop()).get();
+                // Otherwise new invalidations, or stale flags on paths to finished subtrees
+                if (!next && root_.needs_layout()) next = &root_;
+                if (!next) return true;
+            }
+
+            bool finished = step(*next);
+            stats_.steps++;
+
+            if (!finished || expired()) {
+                stats_.remaining = visible_.size() + offscreen_.size();
+                return !pending();
+            }
+        }
+    }
+
+    /**
+     * @brief Finish all remaining layout now
+     */
+    void finish() {
+        stop_resuming();
+        root_.update_layout();
+        visible_.clear();
+        offscreen_.clear();
+    }
+
+    const LayoutSliceStats& stats() const { return stats_; }
+};
+
+} // namespace zuu::widget
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file line_scan.hpp
+ * @brief Finding and counting line feeds in byte ranges
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Large-file readers spend most of their time looking for '\n'.
+ * With SSE2 sixteen bytes are compared at once and the matches come back
+ * as a bit mask, which is popcounted to count lines or scanned for its
+ * lowest bit to find one; without it a byte loop does the same.
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZWIDGET_LINE_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace zuu::widget::line_scan {
+
+#ifdef ZWIDGET_LINE_SCAN_SSE2
+namespace detail {
+
+/**
+ * @brief Bit i set where p[i] is a line feed
+ */
+inline uint32_t newline_mask(const char* p) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))));
+}
+
+} // namespace detail
+#endif
+
+/**
+ * @brief First line feed in [begin, end), or end
+ */
+inline const char* find(const char* begin, const char* end) {
+#ifdef ZWIDGET_LINE_SCAN_SSE2
+    for (; end - begin >= 16; begin += 16) {
+        if (uint32_t mask = detail::newline_mask(begin)) return begin + std::countr_zero(mask);
+    }
+#endif
+    const void* found = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+/**
+ * @brief Last line feed in [begin, end), or nullptr
+ */
+inline const char* rfind(const char* begin, const char* end) {
+#ifdef ZWIDGET_LINE_SCAN_SSE2
+    for (; end - begin >= 16; end -= 16) {
+        if (uint32_t mask = detail::newline_mask(end - 16)) return end - 16 + (31 - std::countl_zero(mask));
+    }
+#endif
+    while (end != begin) {
+        if (*--end == '\n') return end;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Line feeds in [begin, end)
+ */
+inline size_t count(const char* begin, const char* end) {
+    size_t n = 0;
+#ifdef ZWIDGET_LINE_SCAN_SSE2
+    for (; end - begin >= 64; begin += 64) {
+        uint64_t mask = detail::newline_mask(begin) |
+                        (uint64_t{detail::newline_mask(begin + 16)} << 16) |
+                        (uint64_t{detail::newline_mask(begin + 32)} << 32) |
+                        (uint64_t{detail::newline_mask(begin + 48)} << 48);
+        n += static_cast<size_t>(std::popcount(mask));
+    }
+    for (; end - begin >= 16; begin += 16) {
+        n += static_cast<size_t>(std::popcount(detail::newline_mask(begin)));
+    }
+#endif
+    for (; begin != end; ++begin) n += *begin == '\n';
+    return n;
+}
+
+/**
+ * @brief The line feed with zero-based index n in [begin, end), or end
+ */
+inline const char* nth(const char* begin, const char* end, size_t n) {
+#ifdef ZWIDGET_LINE_SCAN_SSE2
+    for (; end - begin >= 16; begin += 16) {
+        uint32_t mask = detail::newline_mask(begin);
+        size_t found = static_cast<size_t>(std::popcount(mask));
+        if (n >= found) {
+            n -= found;
+            continue;
+        }
+        for (; n > 0; --n) mask &= mask - 1;  // Drop the lower matches
+        return begin + std::countr_zero(mask);
+    }
+#endif
+    for (; begin != end; ++begin) {
+        if (*begin == '\n' && n-- == 0) return begin;
+    }
+    return end;
+}
+
+} // namespace zuu::widget::line_scan
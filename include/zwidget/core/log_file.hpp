@@ -0,0 +1,655 @@
+#pragma once
+
+/**
+ * @file log_file.hpp
+ * @brief Memory-mapped, append-only text file with a background line index and search
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Built for multi-gigabyte logs. The file is mapped, never read
+ * into the heap, and split into 4 MiB chunks that a TaskPool indexes in the
+ * background: each chunk records only how many line feeds precede each of
+ * its 16 KiB blocks, so the index costs 256 KiB per GiB whatever the line
+ * lengths, and finding a line or the line number of an offset scans at
+ * most one block. Lines can be walked from any byte offset without the
+ * index, which is what lets a viewer show the start or the end of the file
+ * before indexing has got there.
+ *
+ * refresh() maps data appended since the last call and indexes only the
+ * chunks it changed; a file that shrank (rotated or truncated) is indexed
+ * again from scratch. Searches run on the same pool, one task per chunk,
+ * and publish each chunk's matches as soon as it is done, so results can
+ * be shown while the rest are found. A chunk keeps the matches that start
+ * in it, or for a regex those in the first max_regex_line bytes of the
+ * lines that start in it, so finding the matches near an offset looks at
+ * no more than the chunk before, however long its line is.
+ *
+ * Everything except the tasks runs on the owning (UI) thread.
+ */
+
+#include "zwidget/core/line_scan.hpp"
+#include "zwidget/core/mapped_file.hpp"
+#include "zwidget/core/task_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Byte range of a search hit
+ */
+struct LogMatch {
+    uint64_t offset;
+    uint32_t length;
+};
+
+struct LogSearchOptions {
+    bool regex = false;        // ECMAScript, matched line by line
+    bool ignore_case = false;  // ASCII case folding for plain text
+    size_t max_matches = size_t{1} << 20;  // Further matches are dropped
+};
+
+/**
+ * @brief Progress and memory counters
+ */
+struct LogFileStats {
+    uint64_t size = 0;
+    size_t chunks = 0;
+    size_t indexed_chunks = 0;   // Leading chunks whose line numbers are known
+    size_t searched_chunks = 0;
+    size_t matches = 0;
+    bool matches_dropped = false;
+    size_t index_bytes = 0;
+    size_t match_bytes = 0;
+};
+
+/**
+ * @brief Read-only view of a growing text file; throws std::runtime_error if it cannot be opened
+ */
+class LogFile {
+public:
+    static constexpr size_t chunk_size = size_t{4} << 20;   // Unit of background work
+    static constexpr size_t block_size = size_t{16} << 10;  // Resolution of the line index
+    static constexpr size_t max_regex_line = size_t{64} << 10;  // Longer lines are cut for regex search
+
+private:
+    using Mapping = std::shared_ptr<const MappedFile>;
+
+    struct Chunk {
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        uint32_t version = 0;          // Bumped when the chunk grows: older index results are stale
+        uint32_t search_version = 0;   // Bumped when the chunk is searched again
+        bool indexed = false;
+        bool searched = false;
+        bool dropped = false;          // Its search stopped at the match budget
+        uint32_t newlines = 0;
+        uint64_t first_line = 0;       // Line feeds before begin; valid below indexed_prefix_
+        std::vector<uint32_t> blocks;  // Line feeds in the chunk before each block
+        std::vector<LogMatch> matches; // By offset; see search_chunk()
+    };
+
+    /**
+     * @brief A compiled search, shared by its tasks
+     */
+    struct Search {
+        struct FoldHash {
+            size_t operator()(char c) const {
+                return static_cast<size_t>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        };
+
+        struct FoldEqual {
+            bool operator()(char a, char b) const {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            }
+        };
+
+        std::string pattern;
+        LogSearchOptions options;
+        std::optional<std::regex> regex;
+        std::optional<std::boyer_moore_horspool_searcher<std::string::const_iterator>> exact;
+        std::optional<std::boyer_moore_horspool_searcher<std::string::const_iterator, FoldHash, FoldEqual>> folded;
+        std::atomic<bool> cancelled{false};
+
+        Search(std::string_view text, const LogSearchOptions& opts) : pattern(text), options(opts) {
+            if (options.regex) {
+                auto flags = std::regex::ECMAScript | std::regex::optimize;
+                if (options.ignore_case) flags |= std::regex::icase;
+                regex.emplace(pattern, flags);  // Throws std::regex_error for a bad pattern
+            } else if (options.ignore_case) {
+                folded.emplace(pattern.begin(), pattern.end());
+            } else {
+                exact.emplace(pattern.begin(), pattern.end());
+            }
+        }
+
+        /**
+         * @brief Append up to limit matches in [first, stop) of data to out; false if more were left
+         */
+        bool find_all(const char* data, uint64_t first, uint64_t stop, size_t limit, std::vector<LogMatch>& out) {
+            if (regex) return find_regex(data, first, stop, limit, out);
+            if (folded) return find_text(*folded, data, first, stop, limit, out);
+            return find_text(*exact, data, first, stop, limit, out);
+        }
+
+        template <typename Searcher>
+        bool find_text(const Searcher& searcher, const char* data, uint64_t first, uint64_t stop, size_t limit,
+                       std::vector<LogMatch>& out) {
+            const char* end = data + stop;
+            for (const char* p = data + first; p < end;) {
+                auto [hit, after] = searcher(p, end);
+                if (hit == end) return true;
+                if (out.size() == limit) return false;
+                out.push_back(LogMatch{static_cast<uint64_t>(hit - data), static_cast<uint32_t>(after - hit)});
+                p = after;
+            }
+            return true;
+        }
+
+        bool find_regex(const char* data, uint64_t first, uint64_t stop, size_t limit, std::vector<LogMatch>& out) {
+            const char* end = data + stop;
+            size_t lines = 0;
+            for (const char* line = data + first; line < end; ++lines) {
+                if ((lines & 1023) == 0 && cancelled.load(std::memory_order_relaxed)) return true;
+
+                const char* line_end = line_scan::find(line, end);
+                const char* cut = line + std::min<size_t>(static_cast<size_t>(line_end - line), max_regex_line);
+                for (std::cregex_iterator it(line, cut, *regex), last; it != last; ++it) {
+                    if (it->length(0) == 0) continue;
+                    if (out.size() == limit) return false;
+                    out.push_back(LogMatch{static_cast<uint64_t>(line + it->position(0) - data),
+                                           static_cast<uint32_t>(it->length(0))});
+                }
+                line = line_end + 1;
+            }
+            return true;
+        }
+    };
+
+    std::string path_;
+    TaskPool& pool_;
+    TaskGroup tasks_;
+    Mapping map_;                     // Replaced by refresh(); tasks keep the one they started on
+
+    mutable std::mutex mutex_;        // Guards what tasks publish into
+    std::vector<Chunk> chunks_;
+    size_t indexed_prefix_ = 0;       // Leading chunks that are indexed
+    std::shared_ptr<Search> search_;
+    size_t match_count_ = 0;
+    std::atomic<uint64_t> generation_{0};  // Bumped when indexing starts over
+    std::atomic<bool> closing_{false};
+
+    const char* bytes() const { return map_ && map_->data() ? reinterpret_cast<const char*>(map_->data()) : ""; }
+
+    // === Tasks ===
+
+    void index_chunk(size_t index, uint32_t version, uint64_t generation, Mapping map, uint64_t begin, uint64_t end) {
+        const char* data = reinterpret_cast<const char*>(map->data());
+        std::vector<uint32_t> blocks;
+        blocks.reserve((end - begin + block_size - 1) / block_size);
+
+        uint32_t newlines = 0;
+        for (uint64_t block = begin; block < end; block += block_size) {
+            if (closing_.load(std::memory_order_relaxed) || generation_.load(std::memory_order_relaxed) != generation) {
+                return;
+            }
+            blocks.push_back(newlines);
+            newlines += static_cast<uint32_t>(line_scan::count(data + block, data + std::min<uint64_t>(end, block + block_size)));
+        }
+
+        std::lock_guard lock(mutex_);
+        if (generation_.load(std::memory_order_relaxed) != generation || index >= chunks_.size() ||
+            chunks_[index].version != version) {
+            return;
+        }
+        Chunk& chunk = chunks_[index];
+        chunk.blocks = std::move(blocks);
+        chunk.newlines = newlines;
+        chunk.indexed = true;
+
+        // Line numbers are known up to the first chunk still being indexed
+        while (indexed_prefix_ < chunks_.size() && chunks_[indexed_prefix_].indexed) {
+            if (indexed_prefix_ > 0) {
+                const Chunk& previous = chunks_[indexed_prefix_ - 1];
+                chunks_[indexed_prefix_].first_line = previous.first_line + previous.newlines;
+            }
+            ++indexed_prefix_;
+        }
+    }
+
+    void search_chunk(size_t index, uint32_t version, uint64_t generation, std::shared_ptr<Search> search,
+                      Mapping map, uint64_t begin, uint64_t end, size_t limit) {
+        if (search->cancelled.load(std::memory_order_relaxed) || closing_.load(std::memory_order_relaxed)) return;
+
+        // Plain text: the matches that start in [begin, end). Regex: the lines
+        // that start there, each read up to max_regex_line
+        const char* data = reinterpret_cast<const char*>(map->data());
+        const uint64_t size = map->size();
+        uint64_t first = begin;
+        uint64_t stop = std::min<uint64_t>(size, end + search->pattern.size() - 1);
+        if (search->regex) {
+            if (first > 0 && data[first - 1] != '\n') {
+                first = static_cast<uint64_t>(line_scan::find(data + begin, data + end) - data) + 1;
+            }
+            const char* cut = data + std::min<uint64_t>(size, end + max_regex_line);
+            stop = first >= end ? first : std::min<uint64_t>(size, line_scan::find(data + end - 1, cut) - data + 1);
+        }
+
+        std::vector<LogMatch> found;
+        bool complete = true;
+        try {
+            if (first < stop) complete = search->find_all(data, first, stop, limit, found);
+        } catch (const std::exception&) {
+            // std::regex gives up on pathological input; keep what was found
+        }
+
+        std::lock_guard lock(mutex_);
+        if (search_ != search || search->cancelled.load(std::memory_order_relaxed) ||
+            generation_.load(std::memory_order_relaxed) != generation || index >= chunks_.size() ||
+            chunks_[index].search_version != version) {
+            return;
+        }
+        // The budget is what the other chunks have not published; they may have grown since the spawn
+        Chunk& chunk = chunks_[index];
+        size_t room = match_room(chunk);
+        if (found.size() > room) {
+            found.resize(room);
+            complete = false;
+        }
+        match_count_ = match_count_ - chunk.matches.size() + found.size();
+        chunk.matches = std::move(found);
+        chunk.searched = true;
+        chunk.dropped = !complete;
+    }
+
+    /**
+     * @brief Matches the chunk may publish within max_matches; the caller holds mutex_
+     * Its own previous results do not count, so searching it again after an append
+     * replaces them instead of spending the budget twice.
+     */
+    size_t match_room(const Chunk& chunk) const {
+        size_t others = match_count_ - chunk.matches.size();
+        return search_->options.max_matches > others ? search_->options.max_matches - others : 0;
+    }
+
+    /**
+     * @brief How far before an offset the chunk holding matches at it may start; the caller holds mutex_
+     */
+    uint64_t match_lookback() const {
+        return search_ && search_->regex ? max_regex_line : 0;
+    }
+
+    /**
+     * @brief First chunk that may hold matches at or after offset; the caller holds mutex_
+     */
+    size_t first_match_chunk(uint64_t offset) const {
+        uint64_t lookback = match_lookback();
+        return static_cast<size_t>((offset > lookback ? offset - lookback : 0) / chunk_size);
+    }
+
+    /**
+     * @brief Queue indexing of a chunk; the caller holds mutex_
+     */
+    void spawn_index(size_t index) {
+        Chunk& chunk = chunks_[index];
+        pool_.spawn_background(tasks_, [this, index, version = chunk.version, generation = generation_.load(),
+                                        map = map_, begin = chunk.begin, end = chunk.end] {
+            index_chunk(index, version, generation, map, begin, end);
+        });
+    }
+
+    /**
+     * @brief Queue searching a chunk; the caller holds mutex_
+     */
+    void spawn_search(size_t index) {
+        Chunk& chunk = chunks_[index];
+        chunk.searched = false;
+        pool_.spawn_background(tasks_, [this, index, version = ++chunk.search_version, generation = generation_.load(),
+                                        search = search_, map = map_, begin = chunk.begin, end = chunk.end,
+                                        limit = match_room(chunk)] {
+            search_chunk(index, version, generation, search, map, begin, end, limit);
+        });
+    }
+
+    /**
+     * @brief Cover the mapped size with chunks, (re)indexing and searching from old_size on
+     */
+    void extend(uint64_t old_size) {
+        const uint64_t size = this->size();
+        const size_t first_changed = static_cast<size_t>(old_size / chunk_size);
+
+        std::lock_guard lock(mutex_);
+        // A match may now run past the old end, or a regex see more of the last line
+        const size_t first_searched = search_ ? first_match_chunk(old_size > search_->pattern.size()
+                                                                  ? old_size - search_->pattern.size() : 0)
+                                              : first_changed;
+        chunks_.resize(static_cast<size_t>((size + chunk_size - 1) / chunk_size));
+        indexed_prefix_ = std::min(indexed_prefix_, first_changed);
+        for (size_t i = first_changed; i < chunks_.size(); ++i) {
+            Chunk& chunk = chunks_[i];
+            chunk.begin = static_cast<uint64_t>(i) * chunk_size;
+            chunk.end = std::min<uint64_t>(size, chunk.begin + chunk_size);
+            chunk.version++;
+            chunk.indexed = false;
+            spawn_index(i);
+        }
+        if (search_) {
+            for (size_t i = std::min(first_searched, first_changed); i < chunks_.size(); ++i) spawn_search(i);
+        }
+    }
+
+public:
+    LogFile(std::string path, TaskPool& pool) : path_(std::move(path)), pool_(pool) {
+        map_ = std::make_shared<const MappedFile>(path_);
+        extend(0);
+    }
+
+    /**
+     * @brief Cancels outstanding work and waits for the tasks already running
+     */
+    ~LogFile() {
+        closing_.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex_);
+            if (search_) search_->cancelled.store(true, std::memory_order_relaxed);
+        }
+        pool_.wait(tasks_);
+    }
+
+    LogFile(const LogFile&) = delete;
+    LogFile& operator=(const LogFile&) = delete;
+
+    const std::string& path() const { return path_; }
+
+    uint64_t size() const { return map_ ? map_->size() : 0; }
+
+    /**
+     * @brief Bytes [begin, end) of the file; valid until the next refresh()
+     */
+    std::string_view text(uint64_t begin, uint64_t end) const {
+        end = std::min(end, size());
+        begin = std::min(begin, end);
+        return std::string_view(bytes() + begin, static_cast<size_t>(end - begin));
+    }
+
+    // === Lines without the index ===
+    //
+    // With a limit, no call reads more than limit bytes of the file: a line
+    // longer than that is split into rows of at most limit bytes, and each
+    // row counts as a line of its own. Rows are cut from wherever the walk
+    // entered the line, so inside such a line the breaks found scrolling up
+    // can differ from those found scrolling down.
+
+    static constexpr uint64_t unbounded = static_cast<uint64_t>(-1);
+
+    /**
+     * @brief Start of the line containing offset
+     */
+    uint64_t line_begin(uint64_t offset, uint64_t limit = unbounded) const {
+        const char* data = bytes();
+        offset = std::min(offset, size());
+        uint64_t floor = offset >= limit ? offset - limit + 1 : 0;
+        const char* feed = line_scan::rfind(data + floor, data + offset);
+        return feed ? static_cast<uint64_t>(feed - data) + 1 : floor;
+    }
+
+    /**
+     * @brief Offset of the line feed ending the line at offset, or where it is cut, or size()
+     */
+    uint64_t line_end(uint64_t offset, uint64_t limit = unbounded) const {
+        const char* data = bytes();
+        offset = std::min(offset, size());
+        uint64_t ceiling = size() - offset > limit ? offset + limit : size();
+        return static_cast<uint64_t>(line_scan::find(data + offset, data + ceiling) - data);
+    }
+
+    /**
+     * @brief Start of the line after the one at offset, or size() if there is none
+     */
+    uint64_t next_line(uint64_t offset, uint64_t limit = unbounded) const {
+        uint64_t end = line_end(offset, limit);
+        return end < size() && bytes()[end] == '\n' ? end + 1 : end;
+    }
+
+    /**
+     * @brief Start of the line before the one starting at line_start, or 0
+     */
+    uint64_t previous_line(uint64_t line_start, uint64_t limit = unbounded) const {
+        return line_start > 0 ? line_begin(line_start - 1, limit) : 0;
+    }
+
+    /**
+     * @brief Start of the last line that has text
+     */
+    uint64_t last_line(uint64_t limit = unbounded) const {
+        uint64_t end = size();
+        if (end > 0 && bytes()[end - 1] == '\n') --end;
+        return line_begin(end, limit);
+    }
+
+    // === Line Index ===
+
+    bool indexing() const {
+        std::lock_guard lock(mutex_);
+        return indexed_prefix_ < chunks_.size();
+    }
+
+    /**
+     * @brief Length of the leading part of the file whose line numbers are known
+     */
+    uint64_t indexed_bytes() const {
+        std::lock_guard lock(mutex_);
+        return indexed_prefix_ < chunks_.size() ? chunks_[indexed_prefix_].begin : size();
+    }
+
+    /**
+     * @brief Line feeds in the indexed part, i.e. complete lines known so far
+     */
+    uint64_t indexed_lines() const {
+        std::lock_guard lock(mutex_);
+        if (indexed_prefix_ == 0) return 0;
+        const Chunk& last = chunks_[indexed_prefix_ - 1];
+        return last.first_line + last.newlines;
+    }
+
+    /**
+     * @brief Number of lines once indexing is done; a final line without a line feed counts
+     */
+    std::optional<uint64_t> line_count() const {
+        if (indexing()) return std::nullopt;
+        uint64_t lines = indexed_lines();
+        if (size() > 0 && bytes()[size() - 1] != '\n') ++lines;
+        return lines;
+    }
+
+    /**
+     * @brief Zero-based line number of the line containing offset, once indexed that far
+     */
+    std::optional<uint64_t> line_of(uint64_t offset) const {
+        std::lock_guard lock(mutex_);
+        size_t index = static_cast<size_t>(offset / chunk_size);
+        if (offset >= size() || index >= indexed_prefix_) return std::nullopt;
+
+        const Chunk& chunk = chunks_[index];
+        size_t block = static_cast<size_t>((offset - chunk.begin) / block_size);
+        const char* from = bytes() + chunk.begin + block * block_size;
+        return chunk.first_line + chunk.blocks[block] + line_scan::count(from, bytes() + offset);
+    }
+
+    /**
+     * @brief Offset where a zero-based line starts, once indexed that far
+     */
+    std::optional<uint64_t> line_start(uint64_t line) const {
+        if (line == 0) return 0;
+        std::lock_guard lock(mutex_);
+
+        // Line n starts after line feed n - 1
+        uint64_t feed = line - 1;
+        auto prefix_end = chunks_.begin() + static_cast<std::ptrdiff_t>(indexed_prefix_);
+        auto it = std::upper_bound(chunks_.begin(), prefix_end, feed,
+                                   [](uint64_t value, const Chunk& chunk) { return value < chunk.first_line; });
+        if (it == chunks_.begin()) return std::nullopt;
+        const Chunk& chunk = *--it;
+        if (feed >= chunk.first_line + chunk.newlines) return std::nullopt;
+
+        uint32_t local = static_cast<uint32_t>(feed - chunk.first_line);
+        size_t block = static_cast<size_t>(std::upper_bound(chunk.blocks.begin(), chunk.blocks.end(), local) -
+                                           chunk.blocks.begin()) - 1;
+        const char* from = bytes() + chunk.begin + block * block_size;
+        const char* to = bytes() + std::min<uint64_t>(chunk.end, chunk.begin + (block + 1) * block_size);
+        return static_cast<uint64_t>(line_scan::nth(from, to, local - chunk.blocks[block]) - bytes()) + 1;
+    }
+
+    // === Following ===
+
+    /**
+     * @brief Map data appended since the last call
+     * A file that shrank is taken to be a new one and indexed from the start.
+     * Rotation by renaming or deleting the file works everywhere; truncating
+     * it in place fails on Windows while it is mapped (see MappedFile).
+     * @return true if the contents changed; false also while the file cannot be read
+     */
+    bool refresh() {
+        std::error_code error;
+        uint64_t current = std::filesystem::file_size(path_, error);
+        if (error || current == size()) return false;
+
+        Mapping map;
+        try {
+            map = std::make_shared<const MappedFile>(path_);
+        } catch (const std::runtime_error&) {
+            return false;  // Being rotated; try again next time
+        }
+
+        uint64_t old_size = size();
+        if (map->size() < old_size) {
+            std::lock_guard lock(mutex_);
+            generation_.fetch_add(1, std::memory_order_relaxed);
+            chunks_.clear();
+            indexed_prefix_ = 0;
+            match_count_ = 0;
+            old_size = 0;
+        }
+        map_ = std::move(map);
+        extend(old_size);
+        return true;
+    }
+
+    // === Search ===
+
+    /**
+     * @brief Start searching for pattern, replacing the previous search
+     * An empty pattern clears it. Throws std::regex_error for an invalid regex.
+     */
+    void search(std::string_view pattern, const LogSearchOptions& options = {}) {
+        auto next = pattern.empty() ? nullptr : std::make_shared<Search>(pattern, options);
+
+        std::lock_guard lock(mutex_);
+        if (search_) search_->cancelled.store(true, std::memory_order_relaxed);
+        search_ = std::move(next);
+        match_count_ = 0;
+        for (size_t i = 0; i < chunks_.size(); ++i) {
+            chunks_[i].matches = {};
+            chunks_[i].searched = false;
+            chunks_[i].dropped = false;
+            if (search_) spawn_search(i);
+        }
+    }
+
+    void clear_search() { search(""); }
+
+    bool has_search() const {
+        std::lock_guard lock(mutex_);
+        return search_ != nullptr;
+    }
+
+    bool searching() const {
+        std::lock_guard lock(mutex_);
+        return search_ && std::any_of(chunks_.begin(), chunks_.end(), [](const Chunk& c) { return !c.searched; });
+    }
+
+    size_t match_count() const {
+        std::lock_guard lock(mutex_);
+        return match_count_;
+    }
+
+    /**
+     * @brief Matches found so far that start in [begin, end), in order
+     */
+    void matches_in(uint64_t begin, uint64_t end, std::vector<LogMatch>& out) const {
+        out.clear();
+        if (begin >= end) return;
+
+        std::lock_guard lock(mutex_);
+        if (!search_) return;
+        for (size_t i = first_match_chunk(begin); i < chunks_.size() && chunks_[i].begin < end; ++i) {
+            const std::vector<LogMatch>& matches = chunks_[i].matches;
+            auto it = std::lower_bound(matches.begin(), matches.end(), begin,
+                                       [](const LogMatch& m, uint64_t offset) { return m.offset < offset; });
+            for (; it != matches.end() && it->offset < end; ++it) out.push_back(*it);
+        }
+    }
+
+    /**
+     * @brief First match found so far at or after offset
+     */
+    std::optional<LogMatch> next_match(uint64_t offset) const {
+        std::lock_guard lock(mutex_);
+        if (!search_) return std::nullopt;
+        for (size_t i = first_match_chunk(offset); i < chunks_.size(); ++i) {
+            const std::vector<LogMatch>& matches = chunks_[i].matches;
+            auto it = std::lower_bound(matches.begin(), matches.end(), offset,
+                                       [](const LogMatch& m, uint64_t value) { return m.offset < value; });
+            if (it != matches.end()) return *it;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Last match found so far before offset
+     */
+    std::optional<LogMatch> previous_match(uint64_t offset) const {
+        std::lock_guard lock(mutex_);
+        size_t last = std::min(chunks_.size(), static_cast<size_t>(offset / chunk_size) + 1);
+        for (size_t i = last; i-- > 0;) {
+            const std::vector<LogMatch>& matches = chunks_[i].matches;
+            auto it = std::lower_bound(matches.begin(), matches.end(), offset,
+                                       [](const LogMatch& m, uint64_t value) { return m.offset < value; });
+            if (it != matches.begin()) return *--it;
+        }
+        return std::nullopt;
+    }
+
+    LogFileStats stats() const {
+        std::lock_guard lock(mutex_);
+        LogFileStats stats;
+        stats.size = size();
+        stats.chunks = chunks_.size();
+        stats.indexed_chunks = indexed_prefix_;
+        stats.matches = match_count_;
+        stats.index_bytes = chunks_.capacity() * sizeof(Chunk);
+        for (const Chunk& chunk : chunks_) {
+            stats.searched_chunks += chunk.searched;
+            stats.matches_dropped |= chunk.dropped;
+            stats.index_bytes += chunk.blocks.capacity() * sizeof(uint32_t);
+            stats.match_bytes += chunk.matches.capacity() * sizeof(LogMatch);
+        }
+        return stats;
+    }
+};
+
+} // namespace zuu::widget
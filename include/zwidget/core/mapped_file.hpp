@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory-mapped file
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Maps a whole file into memory so parsers can read it in place;
+ * pages are loaded on first touch and shared with the OS file cache.
+ * Win32 file mappings on Windows, mmap elsewhere.
+ *
+ * While mapped, the file can still be appended to, renamed or deleted by
+ * other processes, so logs can be rotated under a reader. On Windows it
+ * cannot be truncated in place: shrinking a file with a mapped view fails
+ * in the writer, so rotation there has to rename or delete it.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#undef min
+#undef max
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace zuu::widget {
+
+/**
+ * @brief Move-only view of a mapped file; throws std::runtime_error if it cannot be opened
+ */
+class MappedFile {
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+    void close() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+        mapping_ = nullptr;
+#else
+        if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        // Sharing writes lets append-only files (caches, logs) grow while mapped, sharing delete
+        // lets them be renamed or deleted (rotated)
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        LARGE_INTEGER size;
+        GetFileSizeEx(file_, &size);
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ > 0) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_) {
+                data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            }
+            if (!data_) {
+                close();
+                throw std::runtime_error("Cannot map " + path);
+            }
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                throw std::runtime_error("Cannot map " + path);
+            }
+            data_ = static_cast<const uint8_t*>(mapped);
+        }
+        ::close(fd);  // The mapping keeps the file alive
+#endif
+    }
+
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+            file_ = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+};
+
+} // namespace zuu::widget
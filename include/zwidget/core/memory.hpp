@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+ * @file memory.hpp
+ * @brief Allocation accounting tagged by subsystem
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Containers opt in by using TrackingAllocator with a MemoryTag;
+ * each allocation updates two relaxed atomic counters for that tag.
+ * Define ZWIDGET_MEMORY_TRACKING=0 to compile the counters out entirely.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#ifndef ZWIDGET_MEMORY_TRACKING
+#define ZWIDGET_MEMORY_TRACKING 1
+#endif
+
+namespace zuu::widget {
+
+/**
+ * @brief Subsystem an allocation is charged to
+ */
+enum class MemoryTag : uint8_t {
+    widgets,       // Widget objects (with their shared_ptr control block)
+    children,      // Child lists
+    strings,       // Text owned by widgets (measured by the tree walk, not by allocator)
+    events,        // Event queue storage
+    render_cache,  // Canvas and culling scratch buffers
+    other,
+    count
+};
+
+inline constexpr const char* memory_tag_name(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::widgets:      return "widgets";
+        case MemoryTag::children:     return "children";
+        case MemoryTag::strings:      return "strings";
+        case MemoryTag::events:       return "events";
+        case MemoryTag::render_cache: return "render_cache";
+        case MemoryTag::other:        return "other";
+        default:                      return "?";
+    }
+}
+
+/**
+ * @brief Live usage of one tag
+ */
+struct MemoryUsage {
+    int64_t bytes = 0;
+    int64_t allocations = 0;
+};
+
+/**
+ * @brief Process-wide counters per tag
+ */
+class MemoryAccounting {
+private:
+    struct Counter {
+        std::atomic<int64_t> bytes{0};
+        std::atomic<int64_t> allocations{0};
+    };
+
+    static constexpr size_t tag_count = static_cast<size_t>(MemoryTag::count);
+
+    static std::array<Counter, tag_count>& counters() {
+        static std::array<Counter, tag_count> instance;
+        return instance;
+    }
+
+public:
+    static void record_alloc(MemoryTag tag, size_t bytes) {
+#if ZWIDGET_MEMORY_TRACKING
+        auto& counter = counters()[static_cast<size_t>(tag)];
+        counter.bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        counter.allocations.fetch_add(1, std::memory_order_relaxed);
+#else
+        (void)tag;
+        (void)bytes;
+#endif
+    }
+
+    static void record_free(MemoryTag tag, size_t bytes) {
+#if ZWIDGET_MEMORY_TRACKING
+        auto& counter = counters()[static_cast<size_t>(tag)];
+        counter.bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        counter.allocations.fetch_sub(1, std::memory_order_relaxed);
+#else
+        (void)tag;
+        (void)bytes;
+#endif
+    }
+
+    static MemoryUsage usage(MemoryTag tag) {
+        const auto& counter = counters()[static_cast<size_t>(tag)];
+        return MemoryUsage{
+            counter.bytes.load(std::memory_order_relaxed),
+            counter.allocations.load(std::memory_order_relaxed)
+        };
+    }
+
+    static int64_t total_bytes() {
+        int64_t total = 0;
+        for (const auto& counter : counters()) {
+            total += counter.bytes.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Standard allocator that charges its allocations to a tag
+ */
+template <typename T, MemoryTag Tag>
+class TrackingAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackingAllocator<U, Tag>;
+    };
+
+    TrackingAllocator() noexcept = default;
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t n) {
+        T* ptr = std::allocator<T>{}.allocate(n);
+        MemoryAccounting::record_alloc(Tag, n * sizeof(T));
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        MemoryAccounting::record_free(Tag, n * sizeof(T));
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U, Tag>&) const noexcept { return true; }
+};
+
+/**
+ * @brief Heap bytes owned by a string (0 while it fits the small buffer)
+ */
+template <typename CharT, typename Traits, typename Alloc>
+inline size_t string_heap_bytes(const std::basic_string<CharT, Traits, Alloc>& str) {
+    static const size_t inline_capacity = std::basic_string<CharT, Traits, Alloc>().capacity();
+    return str.capacity() > inline_capacity ? (str.capacity() + 1) * sizeof(CharT) : 0;
+}
+
+} // namespace zuu::widget
@@ -0,0 +1,190 @@
+#pragma once
+
+/**
+ * @file memory_report.hpp
+ * @brief Widget-tree memory report: bytes per subtree and per concrete type
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include "zwidget/core/memory.hpp"
+#include "zwidget/core/widget.hpp"
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace zuu::widget {
+
+/**
+ * @brief Readable concrete type name of a widget
+ */
+inline std::string widget_type_name(const Widget& widget) {
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(typeid(widget).name(), nullptr, nullptr, &status);
+    std::string full = status == 0 ? demangled : typeid(widget).name();
+    std::free(demangled);
+    std::string_view name = full;
+#else
+    std::string_view name = typeid(widget).name();
+#endif
+
+    // MSVC spells names as "class zuu::widget::Label"
+    for (std::string_view prefix : {"class ", "struct "}) {
+        if (name.starts_with(prefix)) name.remove_prefix(prefix.size());
+    }
+    if (name.starts_with("zuu::widget::")) {
+        name.remove_prefix(13);
+    }
+    return std::string(name);
+}
+
+/**
+ * @brief Aggregate of all widgets of one concrete type
+ */
+struct TypeMemory {
+    std::string type;
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief One subtree of the report (pre-order)
+ */
+struct SubtreeMemory {
+    const Widget* widget = nullptr;
+    std::string type;
+    size_t depth = 0;
+    size_t widgets = 0;  // Widgets in the subtree, including the root
+    size_t bytes = 0;    // Bytes of the subtree, including the root
+};
+
+/**
+ * @brief Snapshot of the memory held by a widget tree
+ * Hidden pages cached by a StackView are charged to the StackView itself.
+ */
+class MemoryReport {
+private:
+    WidgetMemory totals_;
+    size_t widget_count_ = 0;
+    std::vector<TypeMemory> by_type_;
+    std::vector<SubtreeMemory> subtrees_;
+
+    struct Builder {
+        MemoryReport& report;
+        size_t max_depth;
+        std::unordered_map<std::string, size_t> type_index;
+
+        // Returns {widgets, bytes} of the subtree
+        std::pair<size_t, size_t> visit(const Widget& widget, size_t depth) {
+            WidgetMemory own;
+            widget.measure_memory(own);
+
+            report.totals_.object += own.object;
+            report.totals_.children += own.children;
+            report.totals_.strings += own.strings;
+            report.totals_.other += own.other;
+            report.widget_count_++;
+
+            std::string type = widget_type_name(widget);
+            auto [it, inserted] = type_index.try_emplace(type, report.by_type_.size());
+            if (inserted) {
+                report.by_type_.push_back(TypeMemory{type, 0, 0});
+            }
+            report.by_type_[it->second].count++;
+            report.by_type_[it->second].bytes += own.total();
+
+            // Reserve the pre-order slot; sizes are known after the children
+            size_t slot = static_cast<size_t>(-1);
+            if (depth <= max_depth) {
+                slot = report.subtrees_.size();
+                report.subtrees_.push_back(SubtreeMemory{&widget, std::move(type), depth, 0, 0});
+            }
+
+            size_t widgets = 1;
+            size_t bytes = own.total();
+            for (const auto& child : widget.children()) {
+                auto [child_widgets, child_bytes] = visit(*child, depth + 1);
+                widgets += child_widgets;
+                bytes += child_bytes;
+            }
+
+            if (slot != static_cast<size_t>(-1)) {
+                report.subtrees_[slot].widgets = widgets;
+                report.subtrees_[slot].bytes = bytes;
+            }
+            return {widgets, bytes};
+        }
+    };
+
+public:
+    /**
+     * @brief Walk a tree
+     * @param subtree_depth Deepest level listed in subtrees() (root is 0)
+     */
+    static MemoryReport build(const Widget& root, size_t subtree_depth = 2) {
+        MemoryReport report;
+        Builder{report, subtree_depth, {}}.visit(root, 0);
+
+        std::sort(report.by_type_.begin(), report.by_type_.end(),
+            [](const TypeMemory& a, const TypeMemory& b) { return a.bytes > b.bytes; });
+        return report;
+    }
+
+    size_t total_bytes() const { return totals_.total(); }
+    size_t widget_count() const { return widget_count_; }
+
+    /**
+     * @brief Bytes summed per category over the whole tree
+     */
+    const WidgetMemory& totals() const { return totals_; }
+
+    /**
+     * @brief Per concrete type, largest first
+     */
+    const std::vector<TypeMemory>& by_type() const { return by_type_; }
+
+    /**
+     * @brief Subtrees down to the requested depth, in pre-order
+     */
+    const std::vector<SubtreeMemory>& subtrees() const { return subtrees_; }
+
+    /**
+     * @brief Human readable dump, including the global allocation counters
+     */
+    void print(std::ostream& os) const {
+        os << "Widget tree: " << widget_count_ << " widgets, " << total_bytes() << " bytes"
+           << " (objects " << totals_.object << ", children " << totals_.children
+           << ", strings " << totals_.strings << ", other " << totals_.other << ")\n";
+
+        os << "By type:\n";
+        for (const auto& entry : by_type_) {
+            os << "  " << entry.type << ": " << entry.count << " x, " << entry.bytes << " bytes\n";
+        }
+
+        os << "Subtrees:\n";
+        for (const auto& entry : subtrees_) {
+            os << "  " << std::string(entry.depth * 2, ' ') << entry.type << ": "
+               << entry.widgets << " widgets, " << entry.bytes << " bytes\n";
+        }
+
+        os << "Allocations by tag:\n";
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::count); ++i) {
+            auto tag = static_cast<MemoryTag>(i);
+            MemoryUsage usage = MemoryAccounting::usage(tag);
+            os << "  " << memory_tag_name(tag) << ": " << usage.bytes << " bytes in "
+               << usage.allocations << " blocks\n";
+        }
+    }
+};
+
+} // namespace zuu::widget
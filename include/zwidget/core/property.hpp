@@ -0,0 +1,271 @@
+#pragma once
+
+/**
+ * @file property.hpp
+ * @brief Observable properties with per-frame batched notification and widget bindings
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Property<T>::set() never notifies directly; it queues the property
+ * on the PropertyScheduler. flush() (once per frame, before layout/render)
+ * notifies each changed property once with its latest value. A property
+ * set again after it was notified in the current tick is deferred to the
+ * next flush, so dependents are never re-notified twice in one tick.
+ *
+ * A scheduler belongs to one thread. A property that is still pending must
+ * be destroyed on that thread: the owner's flush() may be notifying it at
+ * that very moment, which no cancellation could make safe.
+ */
+
+#include "zwidget/core/signal.hpp"
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zuu::widget {
+
+class PropertyBase;
+
+/**
+ * @brief Per-thread queue of changed properties
+ */
+class PropertyScheduler {
+private:
+    std::vector<PropertyBase*> queue_;
+    std::vector<PropertyBase*> deferred_;  // Changed again after being notified this tick
+    uint64_t tick_ = 0;
+    bool flushing_ = false;
+    std::thread::id owner_ = std::this_thread::get_id();
+
+    PropertyScheduler() = default;
+
+    /**
+     * @brief Give every queued property its current index again
+     */
+    inline void reindex();
+
+public:
+    static PropertyScheduler& get() {
+        thread_local PropertyScheduler instance;
+        return instance;
+    }
+
+    /**
+     * @brief Properties still queued at thread exit stop pointing here
+     */
+    inline ~PropertyScheduler();
+
+    PropertyScheduler(const PropertyScheduler&) = delete;
+    PropertyScheduler& operator=(const PropertyScheduler&) = delete;
+
+    inline void schedule(PropertyBase* property);
+    inline void cancel(PropertyBase* property);
+
+    /**
+     * @brief Notify all changed properties once
+     * @return Number of properties notified
+     */
+    inline size_t flush();
+
+    /**
+     * @brief Properties waiting for the next flush()
+     */
+    size_t pending() const { return queue_.size() + deferred_.size(); }
+
+    uint64_t tick() const { return tick_; }
+};
+
+/**
+ * @brief Non-template part of Property<T> used by the scheduler
+ */
+class PropertyBase {
+private:
+    bool pending_ = false;
+    bool deferred_ = false;                   // Queued in deferred_ rather than queue_
+    size_t slot_ = 0;                         // Index in that queue while pending
+    uint64_t notified_tick_ = 0;
+    PropertyScheduler* scheduler_ = nullptr;  // Queue it is pending on
+
+    friend class PropertyScheduler;
+
+protected:
+    void schedule() {
+        PropertyScheduler::get().schedule(this);
+    }
+
+    /**
+     * @brief Emit the change signal with the current value
+     */
+    virtual void notify() = 0;
+
+public:
+    PropertyBase() = default;
+
+    /**
+     * @brief Leaves the queue it was scheduled on
+     * While pending, only the scheduler's own thread may destroy it.
+     */
+    virtual ~PropertyBase() {
+        if (pending_) {
+            scheduler_->cancel(this);
+        }
+    }
+
+    PropertyBase(const PropertyBase&) = delete;
+    PropertyBase& operator=(const PropertyBase&) = delete;
+
+    bool is_pending() const { return pending_; }
+};
+
+inline void PropertyScheduler::schedule(PropertyBase* property) {
+    if (property->pending_) return;  // Deduplicate within a tick
+
+    property->pending_ = true;
+    property->scheduler_ = this;
+    property->deferred_ = flushing_ && property->notified_tick_ == tick_;
+    auto& queue = property->deferred_ ? deferred_ : queue_;
+    property->slot_ = queue.size();
+    queue.push_back(property);
+}
+
+inline void PropertyScheduler::cancel(PropertyBase* property) {
+    assert(owner_ == std::this_thread::get_id() && "pending property destroyed off its scheduler's thread");
+    (property->deferred_ ? deferred_ : queue_)[property->slot_] = nullptr;
+    property->pending_ = false;
+}
+
+inline void PropertyScheduler::reindex() {
+    for (size_t i = 0; i < queue_.size(); ++i) {
+        if (PropertyBase* property = queue_[i]) {
+            property->deferred_ = false;
+            property->slot_ = i;
+        }
+    }
+}
+
+inline PropertyScheduler::~PropertyScheduler() {
+    for (auto* queue : {&queue_, &deferred_}) {
+        for (PropertyBase* property : *queue) {
+            if (property) property->pending_ = false;
+        }
+    }
+}
+
+inline size_t PropertyScheduler::flush() {
+    if (flushing_) return 0;
+
+    tick_++;
+    size_t notified = 0;
+    size_t next = 0;
+
+    // Drops what was notified even if a slot throws; the rest waits for the next flush
+    struct Flushing {
+        PropertyScheduler& scheduler;
+        size_t& next;
+        explicit Flushing(PropertyScheduler& s, size_t& n) : scheduler(s), next(n) { scheduler.flushing_ = true; }
+        ~Flushing() {
+            auto& queue = scheduler.queue_;
+            queue.erase(queue.begin(), queue.begin() + static_cast<ptrdiff_t>(next));
+            queue.insert(queue.end(), scheduler.deferred_.begin(), scheduler.deferred_.end());
+            scheduler.deferred_.clear();
+            scheduler.reindex();
+            scheduler.flushing_ = false;
+        }
+    } flushing(*this, next);
+
+    // Index loop: bindings may change other properties, which join this pass
+    while (next < queue_.size()) {
+        PropertyBase* property = queue_[next++];
+        if (!property) continue;
+
+        property->pending_ = false;
+        property->notified_tick_ = tick_;
+        property->notify();
+        notified++;
+    }
+    return notified;
+}
+
+/**
+ * @brief Observable value; dependents connect to changed()
+ */
+template <typename T>
+class Property : public PropertyBase {
+private:
+    T value_{};
+    Signal<const T&> changed_;
+
+    void notify() override {
+        changed_.emit(value_);
+    }
+
+public:
+    Property() = default;
+    explicit Property(T value) : value_(std::move(value)) {}
+
+    const T& get() const { return value_; }
+    operator const T&() const { return value_; }
+
+    /**
+     * @brief Update the value; dependents are notified on the next flush
+     */
+    void set(T value) {
+        if constexpr (std::equality_comparable<T>) {
+            if (value_ == value) return;
+        }
+        value_ = std::move(value);
+        schedule();
+    }
+
+    Property& operator=(T value) {
+        set(std::move(value));
+        return *this;
+    }
+
+    /**
+     * @brief Batched change notification, emitted from PropertyScheduler::flush()
+     */
+    Signal<const T&>& changed() { return changed_; }
+};
+
+namespace _binding {
+
+    template <typename Setter, typename Fallback>
+    struct target {
+        using type = Fallback;
+    };
+
+    template <typename R, typename C, typename A, typename Fallback>
+    struct target<R (C::*)(A), Fallback> {
+        using type = C;
+    };
+
+} // namespace _binding
+
+/**
+ * @brief Drive a widget property from a model property
+ * The setter runs immediately with the current value and then once per
+ * flush in which the source changed. The widget is held weakly; the binding
+ * becomes a no-op once the widget is destroyed.
+ * @param setter Member setter (e.g. &Label::set_text) or callable(W&, const T&)
+ */
+template <typename T, typename W, typename Setter>
+Connection bind_property(Property<T>& source, const std::shared_ptr<W>& widget, Setter setter) {
+    using Target = typename _binding::target<Setter, W>::type;
+
+    auto apply = [weak = std::weak_ptr<W>(widget), setter](const T& value) {
+        if (auto target = weak.lock()) {
+            std::invoke(setter, static_cast<Target&>(*target), value);
+        }
+    };
+
+    apply(source.get());
+    return source.changed().connect(std::move(apply));
+}
+
+} // namespace zuu::widget
@@ -0,0 +1,216 @@
+#pragma once
+
+/**
+ * @file signal.hpp
+ * @brief Multi-subscriber signals with disconnectable connections
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace zuu::widget {
+
+namespace _signal {
+
+    /**
+     * @brief Type-erased slot list so Connection doesn't depend on signal arguments
+     */
+    class SlotListBase {
+    public:
+        virtual ~SlotListBase() = default;
+        virtual void disconnect(uint64_t id) = 0;
+        virtual bool contains(uint64_t id) const = 0;
+    };
+
+    template <typename... Args>
+    class SlotList final : public SlotListBase {
+    public:
+        struct Slot {
+            uint64_t id;
+            std::shared_ptr<std::function<void(Args...)>> callback;  // Null once disconnected
+        };
+
+        std::vector<Slot> slots;
+        uint64_t next_id = 1;
+        int emitting = 0;
+        bool has_dead = false;
+
+        void disconnect(uint64_t id) override {
+            for (auto it = slots.begin(); it != slots.end(); ++it) {
+                if (it->id != id) continue;
+
+                if (emitting > 0) {
+                    // Keep indices stable while emit() iterates
+                    it->callback.reset();
+                    has_dead = true;
+                } else {
+                    slots.erase(it);
+                }
+                return;
+            }
+        }
+
+        bool contains(uint64_t id) const override {
+            for (const auto& slot : slots) {
+                if (slot.id == id) return static_cast<bool>(slot.callback);
+            }
+            return false;
+        }
+
+        void compact() {
+            if (has_dead && emitting == 0) {
+                std::erase_if(slots, [](const Slot& s) { return !s.callback; });
+                has_dead = false;
+            }
+        }
+    };
+
+} // namespace _signal
+
+/**
+ * @brief Handle to a signal subscription - does not disconnect on destruction
+ */
+class Connection {
+private:
+    std::weak_ptr<_signal::SlotListBase> slots_;
+    uint64_t id_ = 0;
+
+public:
+    Connection() = default;
+
+    Connection(std::weak_ptr<_signal::SlotListBase> slots, uint64_t id)
+        : slots_(std::move(slots)), id_(id) {}
+
+    /**
+     * @brief Remove the subscription (safe if the signal is already gone)
+     */
+    void disconnect() {
+        if (auto slots = slots_.lock()) {
+            slots->disconnect(id_);
+        }
+        slots_.reset();
+    }
+
+    bool connected() const {
+        auto slots = slots_.lock();
+        return slots && slots->contains(id_);
+    }
+};
+
+/**
+ * @brief RAII connection - disconnects when destroyed
+ */
+class ScopedConnection {
+private:
+    Connection connection_;
+
+public:
+    ScopedConnection() = default;
+    ScopedConnection(Connection connection) : connection_(std::move(connection)) {}
+
+    ~ScopedConnection() {
+        connection_.disconnect();
+    }
+
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator=(const ScopedConnection&) = delete;
+
+    ScopedConnection(ScopedConnection&& other) noexcept
+        : connection_(std::exchange(other.connection_, Connection{})) {}
+
+    ScopedConnection& operator=(ScopedConnection&& other) noexcept {
+        if (this != &other) {
+            connection_.disconnect();
+            connection_ = std::exchange(other.connection_, Connection{});
+        }
+        return *this;
+    }
+
+    void disconnect() { connection_.disconnect(); }
+    bool connected() const { return connection_.connected(); }
+};
+
+/**
+ * @brief Signal with any number of subscribers, called in connection order
+ * Slots may connect or disconnect while the signal is being emitted;
+ * slots connected during emit() are first called on the next emit(). An
+ * exception from a slot skips the remaining slots and leaves emit().
+ */
+template <typename... Args>
+class Signal {
+public:
+    using Callback = std::function<void(Args...)>;
+
+private:
+    using Slots = _signal::SlotList<Args...>;
+
+    std::shared_ptr<Slots> slots_;  // Allocated on first connect()
+
+public:
+    Signal() = default;
+
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+    Signal(Signal&&) noexcept = default;
+    Signal& operator=(Signal&&) noexcept = default;
+
+    /**
+     * @brief Subscribe to the signal
+     */
+    Connection connect(Callback callback) {
+        if (!slots_) {
+            slots_ = std::make_shared<Slots>();
+        }
+
+        uint64_t id = slots_->next_id++;
+        slots_->slots.push_back({id, std::make_shared<Callback>(std::move(callback))});
+        return Connection(slots_, id);
+    }
+
+    /**
+     * @brief Call every connected slot
+     */
+    void emit(Args... args) {
+        if (!slots_) return;
+
+        // Keep slot list alive even if a slot destroys the signal's owner
+        auto slots = slots_;
+        size_t count = slots->slots.size();
+
+        // Ends the emit even if a slot throws, so later disconnects erase again
+        struct Emitting {
+            Slots& slots;
+            explicit Emitting(Slots& s) : slots(s) { slots.emitting++; }
+            ~Emitting() {
+                slots.emitting--;
+                slots.compact();
+            }
+        } emitting(*slots);
+
+        for (size_t i = 0; i < count; ++i) {
+            // Hold a reference: the vector may grow or the slot disconnect inside the call
+            if (auto callback = slots->slots[i].callback) {
+                (*callback)(args...);
+            }
+        }
+    }
+
+    void disconnect_all() {
+        slots_.reset();
+    }
+
+    bool empty() const {
+        return !slots_ || slots_->slots.empty();
+    }
+
+    size_t size() const {
+        return slots_ ? slots_->slots.size() : 0;
+    }
+};
+
+} // namespace zuu::widget
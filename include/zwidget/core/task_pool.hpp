@@ -0,0 +1,242 @@
+#pragma once
+
+/**
+ * @file task_pool.hpp
+ * @brief Work-stealing thread pool for fork-join work such as parallel layout
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Each worker owns a deque: it pushes and pops its own tasks at the
+ * back (depth first, cache warm) while idle workers steal from the front of
+ * other deques, which holds the oldest and usually largest tasks. Threads
+ * outside the pool share queue 0. wait() never blocks while work is queued:
+ * the waiting thread runs its own or stolen tasks until its group is done,
+ * so nested spawns cannot deadlock.
+ *
+ * Long work nobody waits on within a frame, such as indexing a log file,
+ * goes through spawn_background() into a separate FIFO queue. Workers take
+ * it only when no fork-join task is left, and wait() never runs it (unless
+ * the pool has no workers), so a frame waiting on parallel layout, on the
+ * UI thread or nested in a worker, never stalls behind it.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Set of spawned tasks that can be waited on together
+ */
+class TaskGroup {
+private:
+    friend class TaskPool;
+    std::atomic<size_t> pending_{0};
+    bool background_ = false;  // Spawned with spawn_background()
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+};
+
+/**
+ * @brief Fixed set of worker threads with per-thread stealing deques
+ * Tasks must not throw.
+ */
+class TaskPool {
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct Current {
+        const TaskPool* pool;
+        size_t queue;
+    };
+
+    static inline thread_local Current current_{};
+
+    std::vector<std::unique_ptr<Queue>> queues_;  // [0] outside threads, [i + 1] worker i
+    Queue background_;                            // spawn_background(), oldest first
+    std::vector<std::thread> workers_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<bool> stopping_{false};
+
+    size_t own_queue() const {
+        return current_.pool == this ? current_.queue : 0;
+    }
+
+    /**
+     * @brief Take the newest task of a deque
+     */
+    bool pop(size_t index, Task& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest task of another deque
+     */
+    bool steal(size_t thief, Task& task) {
+        for (size_t i = 1; i < queues_.size(); ++i) {
+            Queue& queue = *queues_[(thief + i) % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool pop_background(Task& task) {
+        std::lock_guard lock(background_.mutex);
+        if (background_.tasks.empty()) return false;
+
+        task = std::move(background_.tasks.front());
+        background_.tasks.pop_front();
+        return true;
+    }
+
+    /**
+     * @brief Run one fork-join task, or failing that a background one if allowed
+     */
+    bool run_one(size_t index, bool background) {
+        Task task;
+        if (!pop(index, task) && !steal(index, task) && !(background && pop_background(task))) return false;
+
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        task.run();
+        task.group->pending_.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void push(Queue& queue, TaskGroup& group, std::function<void()> run) {
+        group.pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(Task{std::move(run), &group});
+        }
+        queued_.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            // A worker between its predicate check and sleeping holds this
+            // mutex; taking it here keeps the wakeup from being lost
+            std::lock_guard lock(sleep_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    void worker_loop(size_t index) {
+        current_ = Current{this, index};
+
+        while (!stopping_.load(std::memory_order_acquire)) {
+            if (run_one(index, true)) continue;
+
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] {
+                return stopping_.load(std::memory_order_acquire) ||
+                       queued_.load(std::memory_order_relaxed) > 0;
+            });
+        }
+    }
+
+public:
+    /**
+     * @brief Threads besides the caller; defaults to one per spare core
+     */
+    static size_t default_threads() {
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 1;
+    }
+
+    explicit TaskPool(size_t threads = default_threads()) {
+        queues_.reserve(threads + 1);
+        for (size_t i = 0; i <= threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i + 1); });
+        }
+    }
+
+    ~TaskPool() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_.store(true, std::memory_order_release);
+        }
+        wake_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * @brief Worker threads, not counting callers of wait()
+     */
+    size_t thread_count() const { return workers_.size(); }
+
+    /**
+     * @brief Queue a fork-join task on the calling thread's deque
+     */
+    void spawn(TaskGroup& group, std::function<void()> run) {
+        push(*queues_[own_queue()], group, std::move(run));
+    }
+
+    /**
+     * @brief Queue long-running work behind every fork-join task
+     * A group should hold either background tasks or fork-join ones, not both.
+     */
+    void spawn_background(TaskGroup& group, std::function<void()> run) {
+        group.background_ = true;
+        push(background_, group, std::move(run));
+    }
+
+    /**
+     * @brief Run queued fork-join tasks until every task of the group has finished
+     * Background tasks are left to the workers, so waiting on a background
+     * group only helps with other work; without workers, the waiting thread
+     * runs them itself.
+     */
+    void wait(TaskGroup& group) {
+        size_t index = own_queue();
+        bool background = group.background_ && workers_.empty();
+        while (!group.done()) {
+            if (!run_one(index, background)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+} // namespace zuu::widget
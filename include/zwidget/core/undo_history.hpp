@@ -0,0 +1,268 @@
+#pragma once
+
+/**
+ * @file undo_history.hpp
+ * @brief Undo/redo for text editors with typing coalescing and a byte budget
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Each entry is one replacement: a position, the characters it
+ * removed and the characters it inserted, so memory grows with what was
+ * edited rather than with the document. Consecutive keystrokes merge into
+ * one entry: typing that continues where the last insertion ended, and
+ * backspace or delete runs that continue the last removal, until the
+ * cursor moves, a line ends or the user pauses. When the entries exceed
+ * the byte budget the oldest are dropped; an edit bigger than the whole
+ * budget clears the history instead of being recorded.
+ *
+ * Editors call record() from their single replace path and apply undo and
+ * redo steps through that same path, inside which record() is ignored.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief A replacement for the editor to perform on undo or redo
+ */
+struct UndoStep {
+    size_t position;          // Where to replace
+    size_t remove;            // Characters to remove at position
+    std::wstring_view insert; // Characters to insert there
+    size_t cursor;            // Cursor position afterwards
+};
+
+/**
+ * @brief Counters for tuning the budget
+ */
+struct UndoStats {
+    size_t entries = 0;
+    size_t redo_entries = 0;
+    size_t bytes = 0;
+    size_t budget = 0;
+    size_t coalesced = 0;  // Edits merged into the previous entry
+    size_t dropped = 0;    // Entries dropped to stay within the budget
+};
+
+/**
+ * @brief Bounded undo/redo stack of text replacements - not thread-safe
+ */
+class UndoHistory {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Entry {
+        size_t position;
+        std::wstring removed;
+        std::wstring inserted;
+        size_t cursor_before;
+        Clock::time_point time;
+
+        size_t bytes() const {
+            return sizeof(Entry) + (removed.capacity() + inserted.capacity()) * sizeof(wchar_t);
+        }
+    };
+
+    std::deque<Entry> undo_;   // Oldest first
+    std::vector<Entry> redo_;  // Most recently undone last
+    size_t bytes_ = 0;
+    size_t budget_;
+    Clock::duration pause_ = std::chrono::milliseconds(1000);
+    bool sealed_ = true;       // Next edit starts a new entry
+    bool applying_ = false;    // Inside undo()/redo(): edits are ours
+    size_t epoch_ = 0;         // Bumped by clear()
+    UndoStats stats_;
+
+    static bool is_single_char(std::wstring_view text) {
+        return text.size() == 1 || (text.size() == 2 && text[0] >= 0xD800 && text[0] <= 0xDBFF);
+    }
+
+    /**
+     * @brief Merge the edit into the last entry if it continues the same burst
+     */
+    bool coalesce(size_t position, std::wstring_view removed, std::wstring_view inserted, Clock::time_point now) {
+        if (sealed_ || undo_.empty()) return false;
+        Entry& last = undo_.back();
+        if (now - last.time > pause_) return false;
+        size_t before = last.bytes();
+
+        if (removed.empty() && last.removed.empty() && is_single_char(inserted) &&
+            position == last.position + last.inserted.size()) {
+            // Typing: a line feed ends the burst after itself
+            last.inserted.append(inserted);
+            sealed_ = inserted[0] == L'\n';
+        } else if (inserted.empty() && last.inserted.empty() && is_single_char(removed) &&
+                   position + removed.size() == last.position) {
+            // Backspace run
+            last.removed.insert(0, removed);
+            last.position = position;
+        } else if (inserted.empty() && last.inserted.empty() && is_single_char(removed) &&
+                   position == last.position) {
+            // Delete run
+            last.removed.append(removed);
+        } else {
+            return false;
+        }
+
+        last.time = now;
+        bytes_ += last.bytes() - before;
+        stats_.coalesced++;
+        return true;
+    }
+
+    void trim() {
+        while (bytes_ > budget_ && !undo_.empty()) {
+            bytes_ -= undo_.front().bytes();
+            undo_.pop_front();
+            stats_.dropped++;
+        }
+    }
+
+    void clear_redo() {
+        for (const Entry& e : redo_) bytes_ -= e.bytes();
+        redo_.clear();
+    }
+
+    /**
+     * @brief Pop an entry off from and push it onto to, applying step through apply
+     * The entry is moved out first: apply reaches user callbacks, which may
+     * clear the history, and then the entry is dropped instead of kept.
+     */
+    template <typename From, typename To, typename Apply>
+    bool replay(From& from, To& to, bool undoing, Apply&& apply) {
+        if (from.empty()) return false;
+
+        Entry entry = std::move(from.back());
+        from.pop_back();
+        const size_t epoch = epoch_;
+        UndoStep step = undoing
+            ? UndoStep{entry.position, entry.inserted.size(), entry.removed, entry.cursor_before}
+            : UndoStep{entry.position, entry.removed.size(), entry.inserted, entry.position + entry.inserted.size()};
+        try {
+            // The editor's replace path calls record(), which must not see this edit
+            struct Applying {
+                bool& flag;
+                explicit Applying(bool& f) : flag(f) { flag = true; }
+                ~Applying() { flag = false; }
+            } applying(applying_);
+            apply(step);
+        } catch (...) {
+            if (epoch == epoch_) from.push_back(std::move(entry));
+            throw;
+        }
+
+        if (epoch == epoch_) {
+            to.push_back(std::move(entry));
+        }
+        sealed_ = true;
+        return true;
+    }
+
+public:
+    explicit UndoHistory(size_t budget_bytes = size_t{4} << 20) : budget_(budget_bytes) {}
+
+    UndoHistory(const UndoHistory&) = delete;
+    UndoHistory& operator=(const UndoHistory&) = delete;
+
+    // === Recording ===
+
+    /**
+     * @brief Record a replacement of removed by inserted at position
+     * Ignored while an undo or redo step is being applied.
+     * @param cursor_before Cursor position to restore when this is undone
+     */
+    void record(size_t position, std::wstring_view removed, std::wstring_view inserted, size_t cursor_before,
+                Clock::time_point now = Clock::now()) {
+        if (applying_ || (removed.empty() && inserted.empty())) return;
+        clear_redo();
+
+        if (coalesce(position, removed, inserted, now)) {
+            trim();
+            return;
+        }
+
+        size_t needed = sizeof(Entry) + (removed.size() + inserted.size()) * sizeof(wchar_t);
+        if (needed > budget_) {
+            // Too big to keep: what came before can no longer be replayed either
+            stats_.dropped += undo_.size();
+            clear();
+            return;
+        }
+
+        undo_.push_back(Entry{position, std::wstring(removed), std::wstring(inserted), cursor_before, now});
+        bytes_ += undo_.back().bytes();
+        sealed_ = is_single_char(inserted) && inserted[0] == L'\n';
+        trim();
+    }
+
+    /**
+     * @brief End the current burst: the next edit gets its own entry
+     * Editors call this when the cursor moves other than by typing.
+     */
+    void seal() { sealed_ = true; }
+
+    // === Undo and Redo ===
+
+    bool can_undo() const { return !undo_.empty(); }
+    bool can_redo() const { return !redo_.empty(); }
+
+    /**
+     * @brief Revert the last entry by calling apply(const UndoStep&)
+     * @return false if there was nothing to undo
+     */
+    template <typename Apply>
+    bool undo(Apply&& apply) {
+        return replay(undo_, redo_, true, apply);
+    }
+
+    /**
+     * @brief Reapply the last undone entry by calling apply(const UndoStep&)
+     */
+    template <typename Apply>
+    bool redo(Apply&& apply) {
+        return replay(redo_, undo_, false, apply);
+    }
+
+    // === Budget ===
+
+    void clear() {
+        undo_.clear();
+        redo_.clear();
+        bytes_ = 0;
+        epoch_++;
+        sealed_ = true;
+    }
+
+    /**
+     * @brief Byte budget for recorded text; oldest entries go first
+     */
+    void set_budget(size_t bytes) {
+        budget_ = bytes;
+        trim();
+    }
+
+    /**
+     * @brief Longest pause between keystrokes that still merge
+     */
+    void set_coalesce_pause(Clock::duration pause) { pause_ = pause; }
+
+    size_t bytes() const { return bytes_; }
+
+    UndoStats stats() const {
+        UndoStats stats = stats_;
+        stats.entries = undo_.size();
+        stats.redo_entries = redo_.size();
+        stats.bytes = bytes_;
+        stats.budget = budget_;
+        return stats;
+    }
+};
+
+} // namespace zuu::widget
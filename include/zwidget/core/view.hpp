@@ -0,0 +1,413 @@
+#pragma once
+
+/**
+ * @file view.hpp
+ * @brief Declarative widget descriptions with keyed reconciliation
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details A ViewNode describes a widget type, its properties and children.
+ * ViewTree keeps the last description and brings the live Widget tree to a
+ * new one with the minimal set of child insertions, moves and removals and
+ * setter invocations. Reused widgets keep their identity, caches and dirty state.
+ *
+ * Children that keep their relative order stay put: only those outside the
+ * longest increasing run of old positions count as moved, so reversing n
+ * children is n - 1 moves and moving one child is one. The new order is
+ * applied in a single Widget::reorder_children() pass, linear in the
+ * number of children.
+ *
+ * A description states values, not a full widget: a property left out of
+ * the next description keeps the value last set on the widget. Setters
+ * have no known default to go back to, so to reset one, describe it with
+ * the value wanted.
+ */
+
+#include "zwidget/core/widget.hpp"
+#include <algorithm>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zuu::widget {
+
+namespace _view {
+
+    /**
+     * @brief Extracts widget and value type from a setter member pointer
+     */
+    template <auto Setter>
+    struct setter_traits;
+
+    template <typename W, typename A, void (W::*S)(A)>
+    struct setter_traits<S> {
+        using widget_type = W;
+        using value_type = std::remove_cvref_t<A>;
+    };
+
+} // namespace _view
+
+/**
+ * @brief Type-erased property assignment of a ViewNode
+ */
+class ViewProp {
+public:
+    virtual ~ViewProp() = default;
+
+    /**
+     * @brief Identity of the setter - props with equal id target the same property
+     */
+    virtual const void* id() const = 0;
+
+    /**
+     * @brief Compare values of two props with the same id
+     */
+    virtual bool equals(const ViewProp& other) const = 0;
+
+    /**
+     * @brief Invoke the setter on a live widget
+     */
+    virtual void apply(Widget& widget) const = 0;
+};
+
+/**
+ * @brief Property bound to a specific setter, e.g. ViewPropValue<&Label::set_text>
+ */
+template <auto Setter>
+class ViewPropValue final : public ViewProp {
+public:
+    using widget_type = typename _view::setter_traits<Setter>::widget_type;
+    using value_type = typename _view::setter_traits<Setter>::value_type;
+
+private:
+    static inline const char tag_ = 0;
+    value_type value_;
+
+public:
+    explicit ViewPropValue(value_type value) : value_(std::move(value)) {}
+
+    const void* id() const override { return &tag_; }
+
+    bool equals(const ViewProp& other) const override {
+        if constexpr (std::equality_comparable<value_type>) {
+            return value_ == static_cast<const ViewPropValue&>(other).value_;
+        } else {
+            return false;  // e.g. callbacks - always reassigned
+        }
+    }
+
+    void apply(Widget& widget) const override {
+        (static_cast<widget_type&>(widget).*Setter)(value_);
+    }
+};
+
+/**
+ * @brief Reconciliation counters for one ViewTree::update()
+ */
+struct ReconcileStats {
+    size_t created = 0;        // Widgets constructed
+    size_t reused = 0;         // Widgets kept from the previous tree
+    size_t removed = 0;        // remove_child calls
+    size_t moved = 0;          // Reused children placed out of their old order
+    size_t inserted = 0;       // New children attached
+    size_t props_applied = 0;  // Setter invocations
+};
+
+/**
+ * @brief Description of a widget: type, optional key, properties and children
+ */
+class ViewNode {
+public:
+    using Factory = WidgetPtr (*)();
+
+private:
+    Factory factory_ = nullptr;  // Also identifies the widget type
+    std::string key_;
+    std::vector<std::shared_ptr<const ViewProp>> props_;
+    std::vector<ViewNode> children_;
+    WidgetPtr widget_;           // Live widget, set once mounted by ViewTree
+
+    friend class ViewTree;
+
+public:
+    template <typename T>
+    static WidgetPtr create() {
+        return make_widget<T>();
+    }
+
+    ViewNode(Factory factory, std::string key)
+        : factory_(factory), key_(std::move(key)) {}
+
+    const std::string& key() const { return key_; }
+    Factory factory() const { return factory_; }
+    const std::vector<ViewNode>& children() const { return children_; }
+
+    /**
+     * @brief Assign a property through its setter
+     */
+    template <auto Setter, typename V>
+    ViewNode& prop(V&& value) & {
+        props_.push_back(std::make_shared<ViewPropValue<Setter>>(
+            typename ViewPropValue<Setter>::value_type(std::forward<V>(value))));
+        return *this;
+    }
+
+    template <auto Setter, typename V>
+    ViewNode&& prop(V&& value) && {
+        prop<Setter>(std::forward<V>(value));
+        return std::move(*this);
+    }
+
+    /**
+     * @brief Append a child description
+     */
+    ViewNode& child(ViewNode node) & {
+        children_.push_back(std::move(node));
+        return *this;
+    }
+
+    ViewNode&& child(ViewNode node) && {
+        children_.push_back(std::move(node));
+        return std::move(*this);
+    }
+};
+
+/**
+ * @brief Describe a widget of type T
+ * @param key Stable identity among siblings; unkeyed nodes match by position
+ */
+template <typename T>
+inline ViewNode view(std::string key = {}) {
+    return ViewNode(&ViewNode::create<T>, std::move(key));
+}
+
+/**
+ * @brief Owns the last description and reconciles the live tree against new ones
+ * Children of described widgets are managed by the tree; widgets added to
+ * them imperatively end up after the described ones.
+ */
+class ViewTree {
+private:
+    ViewNode current_{nullptr, {}};
+    ReconcileStats stats_;
+
+    void apply_props(Widget& widget, const ViewNode& old, const ViewNode& next) {
+        for (size_t i = 0; i < next.props_.size(); ++i) {
+            const auto& prop = next.props_[i];
+            const ViewProp* prev = nullptr;
+
+            // Props usually come in the same order, so try the same slot first
+            if (i < old.props_.size() && old.props_[i]->id() == prop->id()) {
+                prev = old.props_[i].get();
+            } else {
+                for (const auto& candidate : old.props_) {
+                    if (candidate->id() == prop->id()) {
+                        prev = candidate.get();
+                        break;
+                    }
+                }
+            }
+
+            if (prev != prop.get() && (!prev || !prop->equals(*prev))) {
+                prop->apply(widget);
+                stats_.props_applied++;
+            }
+        }
+    }
+
+    void mount(ViewNode& node) {
+        node.widget_ = node.factory_();
+        stats_.created++;
+
+        for (const auto& prop : node.props_) {
+            prop->apply(*node.widget_);
+            stats_.props_applied++;
+        }
+
+        for (auto& child : node.children_) {
+            mount(child);
+            node.widget_->add_child(child.widget_);
+        }
+    }
+
+    void patch(ViewNode& old, ViewNode& next) {
+        next.widget_ = std::move(old.widget_);
+        stats_.reused++;
+
+        apply_props(*next.widget_, old, next);
+        reconcile_children(*next.widget_, old.children_, next.children_);
+    }
+
+    void reconcile_children(Widget& parent, std::vector<ViewNode>& old, std::vector<ViewNode>& next) {
+        constexpr size_t npos = static_cast<size_t>(-1);
+
+        // Index old children: keyed by key, unkeyed by position
+        std::unordered_map<std::string_view, size_t> keyed;
+        std::vector<size_t> unkeyed;
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (old[i].key_.empty()) {
+                unkeyed.push_back(i);
+            } else {
+                keyed.emplace(old[i].key_, i);
+            }
+        }
+
+        // Match new children, reusing widgets of the same type
+        std::vector<bool> matched(old.size(), false);
+        std::vector<size_t> source(next.size(), npos);  // Old index of a reused child
+        size_t next_unkeyed = 0;
+
+        for (size_t i = 0; i < next.size(); ++i) {
+            ViewNode& node = next[i];
+            size_t match = npos;
+
+            if (node.key_.empty()) {
+                if (next_unkeyed < unkeyed.size()) {
+                    match = unkeyed[next_unkeyed++];
+                }
+            } else if (auto it = keyed.find(node.key_); it != keyed.end()) {
+                match = it->second;
+            }
+
+            if (match != npos && !matched[match] && old[match].factory_ == node.factory_) {
+                matched[match] = true;
+                source[i] = match;
+                patch(old[match], node);
+            } else {
+                mount(node);
+            }
+        }
+
+        // Drop widgets that are no longer described
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (!matched[i] && old[i].widget_) {
+                parent.remove_child(old[i].widget_.get());
+                stats_.removed++;
+            }
+        }
+
+        // New children go at the end for now; one reorder then puts everything
+        // in described order
+        for (auto& node : next) {
+            if (node.widget_->parent() != &parent) {
+                parent.add_child(node.widget_);
+                stats_.inserted++;
+            }
+        }
+
+        // Reused children in the longest run of increasing old positions keep
+        // their relative order; only the others count as moved
+        std::vector<bool> stays = increasing_run(source);
+        for (size_t i = 0; i < next.size(); ++i) {
+            if (source[i] != npos && !stays[i]) stats_.moved++;
+        }
+
+        const auto& live = parent.children();
+        std::unordered_map<const Widget*, size_t> at;
+        at.reserve(live.size());
+        for (size_t i = 0; i < live.size(); ++i) {
+            at.emplace(live[i].get(), i);
+        }
+
+        // Described children first, then any the description does not own
+        std::vector<size_t> order;
+        order.reserve(live.size());
+        std::vector<bool> taken(live.size(), false);
+        for (const auto& node : next) {
+            size_t from = at.find(node.widget_.get())->second;  // Every described child is parented above
+            order.push_back(from);
+            taken[from] = true;
+        }
+        for (size_t i = 0; i < live.size(); ++i) {
+            if (!taken[i]) order.push_back(i);
+        }
+
+        bool identity = true;
+        for (size_t i = 0; i < order.size() && identity; ++i) {
+            identity = order[i] == i;
+        }
+        if (!identity) parent.reorder_children(order);
+    }
+
+    /**
+     * @brief Marks a longest subsequence of reused children whose old indices increase
+     * Linear when the reused children kept their order, else patience sorting: O(n log n).
+     */
+    static std::vector<bool> increasing_run(const std::vector<size_t>& source) {
+        constexpr size_t npos = static_cast<size_t>(-1);
+
+        // Unchanged, appended to or only trimmed: every reused child stays
+        bool in_order = true;
+        for (size_t i = 0, last = 0; i < source.size() && in_order; ++i) {
+            if (source[i] == npos) continue;
+            in_order = source[i] >= last;
+            last = source[i];
+        }
+        if (in_order) {
+            std::vector<bool> stays(source.size());
+            for (size_t i = 0; i < source.size(); ++i) {
+                stays[i] = source[i] != npos;
+            }
+            return stays;
+        }
+
+        std::vector<size_t> tails;                        // Per run length, the index ending it
+        std::vector<size_t> previous(source.size(), npos);
+        for (size_t i = 0; i < source.size(); ++i) {
+            if (source[i] == npos) continue;
+            auto it = std::lower_bound(tails.begin(), tails.end(), source[i],
+                                       [&](size_t tail, size_t value) { return source[tail] < value; });
+            if (it != tails.begin()) previous[i] = *(it - 1);
+            if (it == tails.end()) {
+                tails.push_back(i);
+            } else {
+                *it = i;
+            }
+        }
+
+        std::vector<bool> stays(source.size(), false);
+        for (size_t i = tails.empty() ? npos : tails.back(); i != npos; i = previous[i]) {
+            stays[i] = true;
+        }
+        return stays;
+    }
+
+public:
+    ViewTree() = default;
+
+    ViewTree(const ViewTree&) = delete;
+    ViewTree& operator=(const ViewTree&) = delete;
+
+    /**
+     * @brief Reconcile the live tree against a new description
+     * @return Root widget; a new instance only if the root type changed
+     */
+    WidgetPtr update(ViewNode next) {
+        stats_ = ReconcileStats{};
+
+        if (current_.widget_ && current_.factory_ == next.factory_) {
+            patch(current_, next);
+        } else {
+            mount(next);
+        }
+
+        current_ = std::move(next);
+        return current_.widget_;
+    }
+
+    /**
+     * @brief Root widget of the last update (null before the first one)
+     */
+    const WidgetPtr& root() const { return current_.widget_; }
+
+    /**
+     * @brief Counters from the last update()
+     */
+    const ReconcileStats& stats() const { return stats_; }
+};
+
+} // namespace zuu::widget
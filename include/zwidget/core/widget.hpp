@@ -7,22 +7,79 @@
  * @date 2025-11-29
  */
 
+#include "zwidget/core/attached.hpp"
+#include "zwidget/core/memory.hpp"
+#include "zwidget/core/task_pool.hpp"
 #include "zwidget/unit/rect.hpp"
 #include "zwidget/unit/color.hpp"
 #include "zwidget/unit/event.hpp"
 #include "zwidget/unit/align.hpp"
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/occlusion.hpp"
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace zuu::widget {
 
 // Forward declarations
 class Widget;
-class Canvas;
-class RenderContext;
 
 using WidgetPtr = std::shared_ptr<Widget>;
-using WidgetList = std::vector<WidgetPtr>;
+using WidgetList = std::vector<WidgetPtr, TrackingAllocator<WidgetPtr, MemoryTag::children>>;
+
+/**
+ * @brief Receives the subtrees a time-sliced layout pass postpones
+ * Only containers with at least min_subtree widgets split their children
+ * off; see LayoutScheduler.
+ */
+class LayoutDeferral {
+public:
+    size_t min_subtree = 256;
+    
+    virtual void defer(Widget& widget) = 0;
+    
+    /**
+     * @brief Whether the current slice is out of time; checked inside long child loops
+     */
+    virtual bool expired() const { return false; }
+    
+    /**
+     * @brief Area to lay out first, in root coordinates; none if there is no such area
+     */
+    virtual std::optional<Rectf> viewport() const { return std::nullopt; }
+    
+protected:
+    ~LayoutDeferral() = default;
+};
+
+/**
+ * @brief Where a container's layout stopped, for Widget::resume_layout()
+ * Children are first measured ahead of the container, then the rects its
+ * arrange_content() gave them are applied, both a slice at a time. While
+ * measuring, the children up to the end of the viewport are already placed
+ * where the measured ones before them put them.
+ */
+struct LayoutProgress {
+    size_t measured = 0;                              // Children measured ahead
+    bool leading = true;                              // Still placing measured children early
+    std::optional<Rectf> last_leading;                // Rect of the last child placed early
+    std::vector<std::pair<Widget*, Rectf>> placements;
+    size_t placed = 0;
+    bool collected = false;                           // arrange_content() has run
+    
+    void reset() {
+        measured = 0;
+        leading = true;
+        last_leading.reset();
+        placements.clear();
+        placed = 0;
+        collected = false;
+    }
+};
 
 /**
  * @brief Widget state flags
@@ -53,6 +110,40 @@ inline constexpr bool has_state(WidgetState flags, WidgetState check) {
     return (flags & check) == check;
 }
 
+/**
+ * @brief Result of the occlusion pre-pass for one widget
+ */
+enum class Occlusion : uint8_t {
+    none,     // Visible, draw normally
+    self,     // Own content hidden, children still rendered
+    subtree   // Widget and all descendants hidden
+};
+
+/**
+ * @brief Bytes attributed to one widget, filled by Widget::measure_memory()
+ */
+struct WidgetMemory {
+    size_t object = 0;    // sizeof the concrete widget
+    size_t children = 0;  // Child list storage
+    size_t strings = 0;   // Heap owned by strings
+    size_t other = 0;     // Other owned heap (caches, detached pages)
+    
+    size_t total() const { return object + children + strings + other; }
+};
+
+/**
+ * @brief Rarely changed widget fields, kept in sparse side storage
+ * A widget only gets an entry once one of these differs from the default;
+ * the colors default to what most widgets set in their constructors.
+ */
+struct WidgetExtras {
+    Sizef min_size{0, 0};
+    Sizef max_size{FLT_MAX, FLT_MAX};
+    Align alignment;
+    Color background = Color::transparent();
+    Color foreground = Color::black();
+};
+
 /**
  * @brief Base widget class - all UI components inherit from this
  */
@@ -62,20 +153,290 @@ protected:
     WidgetList children_;
     
     Rectf bounds_;           // Position and size
-    Color background_;
-    Color foreground_;
+    Sizef preferred_size_{100, 100};  // Layout hint read by every layout pass
+    
+    // Last measure() result and the available size it was computed for
+    Sizef desired_size_;
+    Sizef measured_available_;
+    
+    // State and subtree size share one word; subtrees are limited to 2^24 - 1 widgets
+    WidgetState state_ : 8 = WidgetState::visible | WidgetState::enabled;
+    
+private:
+    uint32_t subtree_size_ : 24 = 1;  // This widget and all descendants
+    
+protected:
+    
+    // Cached visual-overflow box of the whole subtree, in local coordinates
+    mutable Rectf visual_bounds_;
+    
+    // Per-frame occlusion result; low 32 bits of the frame are enough to
+    // tell this frame's result from an older one
+    uint32_t occlusion_frame_ = 0;
+    Occlusion occlusion_ = Occlusion::none;
+    
+    mutable bool visual_bounds_valid_ = false;
+    bool clip_children_ = false;
+    bool opaque_ = false;
+    
+private:
+    enum LayoutFlag : uint8_t {
+        layout_measured   = 1 << 0,  // desired_size_ is valid for measured_available_
+        layout_arranged   = 1 << 1,  // Children are placed for the current bounds
+        layout_descendant = 1 << 2,  // Some descendant needs arranging
+        layout_boundary   = 1 << 3,  // Explicit relayout boundary
+        layout_deferred   = 1 << 4,  // Placed, children not yet: not drawn
+        layout_placing    = 1 << 5   // resume_layout() is placing the children
+    };
+    
+    uint8_t layout_flags_ = 0;
+    
+    /**
+     * @brief Children of one parallel arrange_content(), batched into tasks
+     */
+    struct ParallelFrame {
+        TaskGroup group;
+        std::vector<std::pair<Widget*, Rectf>> batch;
+        size_t batch_size = 0;  // Widgets in the batch's subtrees
+        bool spawned = false;
+    };
+    
+    /**
+     * @brief Per-thread state of a parallel layout pass
+     * Inside a task, upward walks (mark_dirty, visual bounds) stop below
+     * the widget that spawned it; that widget propagates after the join.
+     */
+    struct ParallelLayout {
+        TaskPool* pool;
+        size_t min_subtree;         // Widgets per task
+        const Widget* spawner;      // Parent of this task's root widgets
+        ParallelFrame* frame;       // Set while a large arrange_content() runs
+    };
+    
+    static inline thread_local ParallelLayout parallel_{};
+    static inline thread_local LayoutDeferral* deferral_ = nullptr;
+    static inline thread_local std::vector<std::pair<Widget*, Rectf>>* placements_ = nullptr;
+    
+    class ParallelScope {
+    private:
+        ParallelLayout saved_;
     
-    WidgetState state_ = WidgetState::visible | WidgetState::enabled;
+    public:
+        explicit ParallelScope(const ParallelLayout& context) : saved_(std::exchange(parallel_, context)) {}
+        ~ParallelScope() { parallel_ = saved_; }
+        ParallelScope(const ParallelScope&) = delete;
+        ParallelScope& operator=(const ParallelScope&) = delete;
+    };
     
-    Align alignment_;
+    /**
+     * @brief Parent for upward propagation; null at the root of a layout task
+     */
+    Widget* propagation_parent() const {
+        return parent_ && parent_ == parallel_.spawner ? nullptr : parent_;
+    }
     
-    // Layout hints
-    Sizef min_size_{0, 0};
-    Sizef max_size_{FLT_MAX, FLT_MAX};
-    Sizef preferred_size_{100, 100};
+    void add_subtree_size(const Widget& child, bool add) {
+        for (Widget* w = this; w; w = w->parent_) {
+            w->subtree_size_ = add ? w->subtree_size_ + child.subtree_size_
+                                   : w->subtree_size_ - child.subtree_size_;
+        }
+    }
+    
+    void spawn_batch(ParallelFrame& frame) {
+        ParallelLayout context{parallel_.pool, parallel_.min_subtree, this, nullptr};
+        parallel_.pool->spawn(frame.group, [batch = std::move(frame.batch), context] {
+            ParallelScope scope(context);
+            for (const auto& [child, rect] : batch) {
+                child->arrange(rect);
+            }
+        });
+        frame.batch.clear();
+        frame.batch_size = 0;
+        frame.spawned = true;
+    }
+    
+    /**
+     * @brief arrange_content(), joined with any subtrees it handed to the pool
+     * Only subtrees big enough for two tasks fan out; the last partial
+     * batch runs here while the pool works on the others.
+     */
+    void run_arrange_content() {
+        if (!parallel_.pool) {
+            arrange_content();
+            return;
+        }
+        
+        if (subtree_size_ < parallel_.min_subtree * 2) {
+            ParallelFrame* outer = std::exchange(parallel_.frame, nullptr);
+            arrange_content();
+            parallel_.frame = outer;
+            return;
+        }
+        
+        ParallelFrame frame;
+        ParallelFrame* outer = std::exchange(parallel_.frame, &frame);
+        arrange_content();
+        parallel_.frame = nullptr;
+        
+        for (const auto& [child, rect] : frame.batch) {
+            child->arrange(rect);
+        }
+        parallel_.pool->wait(frame.group);
+        parallel_.frame = outer;
+        
+        if (!frame.spawned) return;
+        for (const auto& child : children_) {
+            if (!child->visual_bounds_valid_) invalidate_visual_bounds();
+            if (child->is_dirty() && !is_dirty()) mark_dirty();
+        }
+    }
+    
+    bool resume_layout_slice(LayoutProgress& progress, LayoutDeferral& deferral) {
+        if ((progress.collected || progress.last_leading) && !(layout_flags_ & layout_placing)) {
+            // Laid out or invalidated by something else since the last slice
+            progress.reset();
+            if (!needs_layout()) return true;
+        }
+        
+        size_t work = 0;
+        if (!progress.collected) {
+            if ((layout_flags_ & layout_arranged) || children_.size() < deferral.min_subtree) {
+                update_layout();
+                return true;
+            }
+            
+            // The space update_layout() would measure with
+            Sizef available = parent_ && parent_->uses_child_measure(*this) ? measured_available_ : bounds_.size;
+            if (!((layout_flags_ & layout_measured) && measured_available_ == available)) {
+                if (std::optional<Sizef> space = child_measure_space(available)) {
+                    // The viewport in local coordinates, while children are still placed early
+                    Rectf view{};
+                    if (progress.leading) {
+                        std::optional<Rectf> area = deferral.viewport();
+                        progress.leading = area.has_value();
+                        if (area) view = Rectf{area->pos - absolute_position(), area->size};
+                    }
+                    
+                    for (; progress.measured < children_.size(); ++progress.measured) {
+                        if ((++work & 63) == 0 && deferral.expired()) return false;
+                        Widget& child = *children_[progress.measured];
+                        if (!child.is_visible()) continue;
+                        child.measure(*space);
+                        if (progress.leading) place_leading(child, view, progress);
+                    }
+                }
+            }
+            
+            measure(available);
+            layout_flags_ = static_cast<uint8_t>((layout_flags_ | layout_arranged | layout_placing) &
+                                                 ~(layout_descendant | layout_deferred));
+            auto* outer = std::exchange(placements_, &progress.placements);
+            arrange_content();
+            placements_ = outer;
+            progress.collected = true;
+            
+            // Not arranged until every child is placed; keep the path to it flagged
+            layout_flags_ = static_cast<uint8_t>(layout_flags_ & ~layout_arranged);
+            for (Widget* w = parent_; w && !(w->layout_flags_ & layout_descendant); w = w->parent_) {
+                w->layout_flags_ |= layout_descendant;
+            }
+            if (deferral.expired()) return false;
+        }
+        
+        for (; progress.placed < progress.placements.size(); ++progress.placed) {
+            if ((++work & 63) == 0 && deferral.expired()) return false;
+            auto [child, rect] = progress.placements[progress.placed];
+            arrange_child(*child, rect);
+        }
+        layout_flags_ = static_cast<uint8_t>((layout_flags_ | layout_arranged) & ~layout_placing);
+        progress.reset();
+        return true;
+    }
+    
+    /**
+     * @brief Place a just measured child where leading_rect() says, unless it lies past view
+     * The first one shows this widget with only its placed children.
+     */
+    void place_leading(Widget& child, const Rectf& view, LayoutProgress& progress) {
+        std::optional<Rectf> rect = leading_rect(child, progress.last_leading);
+        if (!rect || rect->top() >= view.bottom() || rect->left() >= view.right()) {
+            progress.leading = false;
+            return;
+        }
+        
+        if (!progress.last_leading) {
+            layout_flags_ = static_cast<uint8_t>((layout_flags_ | layout_placing) & ~layout_deferred);
+            for (Widget* w = parent_; w && !(w->layout_flags_ & layout_descendant); w = w->parent_) {
+                w->layout_flags_ |= layout_descendant;
+            }
+        }
+        child.arrange(*rect);
+        progress.last_leading = rect;
+    }
+    
+    /**
+     * @brief Not drawn or hit: placed before its children, or not yet placed by resume_layout()
+     */
+    bool layout_pending() const {
+        return (layout_flags_ & layout_deferred) ||
+               (parent_ && (parent_->layout_flags_ & layout_placing) && !(layout_flags_ & layout_arranged));
+    }
+    
+    using ExtrasStorage = AttachedStorage<Widget, WidgetExtras>;
+    
+    enum ExtraField : uint8_t {
+        extra_min_size   = 1 << 0,
+        extra_max_size   = 1 << 1,
+        extra_alignment  = 1 << 2,
+        extra_background = 1 << 3,
+        extra_foreground = 1 << 4
+    };
+    
+    uint8_t extras_ = 0;  // ExtraField bits that differ from the defaults
+    
+    static ExtrasStorage& extras_storage() {
+        // Leaked so widgets destroyed during static teardown can still unregister
+        static ExtrasStorage* storage = new ExtrasStorage;
+        return *storage;
+    }
+    
+    template <typename T>
+    const T& get_extra(T WidgetExtras::*member, uint8_t field) const {
+        if (extras_ & field) {
+            return extras_storage().get(this).*member;
+        }
+        return ExtrasStorage::defaults().*member;
+    }
+    
+    template <typename T>
+    void set_extra(T WidgetExtras::*member, uint8_t field, const T& value) {
+        const T& fallback = ExtrasStorage::defaults().*member;
+        
+        if (value == fallback) {
+            if (!(extras_ & field)) return;
+            extras_ &= static_cast<uint8_t>(~field);
+            if (extras_ == 0) {
+                extras_storage().erase(this);
+            } else {
+                extras_storage().edit(this).*member = fallback;
+            }
+        } else {
+            extras_storage().edit(this).*member = value;
+            extras_ |= field;
+        }
+    }
     
 public:
-    virtual ~Widget() = default;
+    virtual ~Widget() {
+        if (extras_) {
+            extras_storage().erase(this);
+        }
+    }
+    
+    /**
+     * @brief Number of widgets that currently hold sparse extras
+     */
+    static size_t extras_count() { return extras_storage().size(); }
     
     // === Hierarchy Management ===
     
@@ -85,11 +446,61 @@ public:
     virtual void add_child(WidgetPtr child) {
         if (child && child.get() != this) {
             child->parent_ = this;
+            add_subtree_size(*child, true);
             children_.push_back(std::move(child));
-            mark_dirty();
+            invalidate_visual_bounds();
+            invalidate_layout();
         }
     }
     
+    /**
+     * @brief Insert child widget at index (clamped to the end)
+     */
+    virtual void insert_child(size_t index, WidgetPtr child) {
+        if (child && child.get() != this) {
+            child->parent_ = this;
+            add_subtree_size(*child, true);
+            index = std::min(index, children_.size());
+            children_.insert(children_.begin() + index, std::move(child));
+            invalidate_visual_bounds();
+            invalidate_layout();
+        }
+    }
+    
+    /**
+     * @brief Move an existing child to a new index, keeping its identity
+     */
+    virtual void move_child(Widget* child, size_t index) {
+        auto it = std::find_if(children_.begin(), children_.end(),
+            [child](const WidgetPtr& ptr) { return ptr.get() == child; });
+        
+        if (it == children_.end()) return;
+        
+        auto from = static_cast<size_t>(it - children_.begin());
+        index = std::min(index, children_.size() - 1);
+        if (from == index) return;
+        
+        if (from < index) {
+            std::rotate(it, it + 1, children_.begin() + index + 1);
+        } else {
+            std::rotate(children_.begin() + index, it, it + 1);
+        }
+        invalidate_layout();
+    }
+
+    /**
+     * @brief Put every child in a new order at once, keeping identities
+     * order[i] is the current index of the child that goes to index i and
+     * must be a permutation of all children; anything else is ignored.
+     * One pass and one invalidation, however many children move.
+     */
+    virtual void reorder_children(std::span<const size_t> order) {
+        if (!is_permutation_of_children(order)) return;
+
+        permute(children_, order);
+        invalidate_layout();
+    }
+
     /**
      * @brief Remove child widget
      */
@@ -98,9 +509,11 @@ public:
             [child](const WidgetPtr& ptr) { return ptr.get() == child; });
         
         if (it != children_.end()) {
+            add_subtree_size(**it, false);
             (*it)->parent_ = nullptr;
             children_.erase(it);
-            mark_dirty();
+            invalidate_visual_bounds();
+            invalidate_layout();
         }
     }
     
@@ -118,7 +531,13 @@ public:
     
     void set_bounds(const Rectf& bounds) {
         if (bounds_.pos != bounds.pos || bounds_.size != bounds.size) {
+            bool resized = bounds_.size != bounds.size;
             bounds_ = bounds;
+            if (resized) {
+                invalidate_visual_bounds();
+            } else if (Widget* parent = propagation_parent()) {
+                parent->invalidate_visual_bounds();
+            }
             on_resize(bounds.size);
             mark_dirty();
         }
@@ -129,6 +548,9 @@ public:
     void set_position(const Pointf& pos) {
         if (bounds_.pos != pos) {
             bounds_.pos = pos;
+            if (Widget* parent = propagation_parent()) {
+                parent->invalidate_visual_bounds();
+            }
             mark_dirty();
         }
     }
@@ -138,6 +560,7 @@ public:
     void set_size(const Sizef& size) {
         if (bounds_.size != size) {
             bounds_.size = size;
+            invalidate_visual_bounds();
             on_resize(size);
             mark_dirty();
         }
@@ -161,49 +584,512 @@ public:
         return pos;
     }
     
+    // === Visual Bounds ===
+    
+    /**
+     * @brief Area this widget paints itself, in local coordinates
+     * Override when draw() paints outside {0, 0, width, height}, and call
+     * invalidate_visual_bounds() whenever that area changes.
+     */
+    virtual Rectf visual_overflow() const {
+        return Rectf{0.0f, 0.0f, width(), height()};
+    }
+    
+    /**
+     * @brief Area painted by this widget and all visible descendants (local coordinates)
+     * Cached; recomputed lazily after invalidate_visual_bounds().
+     */
+    const Rectf& visual_bounds() const {
+        if (!visual_bounds_valid_) {
+            Rectf children_area;
+            
+            for (const auto& child : children_) {
+                if (!child->is_visible()) continue;
+                
+                Rectf child_area = child->visual_bounds();
+                child_area.pos += child->bounds_.pos;
+                children_area = children_area.united(child_area);
+            }
+            
+            if (clip_children_) {
+                children_area = children_area.intersected(Rectf{0.0f, 0.0f, width(), height()});
+            }
+            
+            visual_bounds_ = visual_overflow().united(children_area);
+            visual_bounds_valid_ = true;
+        }
+        return visual_bounds_;
+    }
+    
+    /**
+     * @brief Drop cached visual bounds of this widget and its ancestors
+     * Stops early at the first ancestor that is already invalid, since
+     * its own ancestors are then guaranteed to be invalid too.
+     */
+    void invalidate_visual_bounds() {
+        for (Widget* w = this; w && w->visual_bounds_valid_; w = w->propagation_parent()) {
+            w->visual_bounds_valid_ = false;
+        }
+    }
+    
+    /**
+     * @brief Clip children to this widget's bounds (e.g. scrollable panels)
+     */
+    void set_clip_children(bool clip) {
+        if (clip_children_ != clip) {
+            clip_children_ = clip;
+            invalidate_visual_bounds();
+            mark_dirty();
+        }
+    }
+    
+    bool clip_children() const { return clip_children_; }
+    
+    // === Memory ===
+    
+    /**
+     * @brief Report memory owned by this widget, excluding its children
+     * Overrides set object to their own sizeof and add owned heap blocks.
+     */
+    virtual void measure_memory(WidgetMemory& out) const {
+        out.object = sizeof(Widget);
+        out.children += children_.capacity() * sizeof(WidgetPtr);
+        if (extras_) {
+            out.other += ExtrasStorage::entry_bytes;
+        }
+    }
+    
+    /**
+     * @brief Total bytes of this widget and all descendants
+     */
+    size_t subtree_memory() const {
+        WidgetMemory memory;
+        measure_memory(memory);
+        
+        size_t total = memory.total();
+        for (const auto& child : children_) {
+            total += child->subtree_memory();
+        }
+        return total;
+    }
+    
+    // === Occlusion ===
+    
+    /**
+     * @brief Declare that draw() covers the whole bounds with opaque pixels
+     */
+    void set_opaque(bool opaque) {
+        opaque_ = opaque;
+        mark_dirty();
+    }
+    
+    bool is_opaque() const { return opaque_; }
+    
+    /**
+     * @brief Area this widget fully covers with opaque pixels (local coordinates)
+     * Empty when nothing is guaranteed opaque. Widgets that know their fill
+     * (e.g. solid backgrounds) override this instead of relying on set_opaque().
+     */
+    virtual Rectf opaque_rect() const {
+        return opaque_ ? Rectf{0.0f, 0.0f, width(), height()} : Rectf{};
+    }
+    
+    /**
+     * @brief Occlusion state computed by the last cull_occluded() for this frame
+     */
+    Occlusion occlusion(const Canvas& canvas) const {
+        return occlusion_frame_ == static_cast<uint32_t>(canvas.frame()) ? occlusion_ : Occlusion::none;
+    }
+    
+    /**
+     * @brief Front-to-back pre-pass marking widgets hidden under opaque ones
+     * Call on the root after Canvas::begin_frame() and before render().
+     */
+    void cull_occluded(Canvas& canvas) {
+        OcclusionRegion covered;
+        occlusion_pass(covered, canvas.origin(), canvas.visible_rect(), canvas.frame());
+    }
+    
     // === Layout ===
     
-    void set_min_size(const Sizef& size) { min_size_ = size; mark_dirty(); }
-    void set_max_size(const Sizef& size) { max_size_ = size; mark_dirty(); }
-    void set_preferred_size(const Sizef& size) { preferred_size_ = size; mark_dirty(); }
+    void set_min_size(const Sizef& size) { set_extra(&WidgetExtras::min_size, extra_min_size, size); invalidate_size(); }
+    void set_max_size(const Sizef& size) { set_extra(&WidgetExtras::max_size, extra_max_size, size); invalidate_size(); }
+    void set_preferred_size(const Sizef& size) { preferred_size_ = size; invalidate_size(); }
     
-    const Sizef& min_size() const { return min_size_; }
-    const Sizef& max_size() const { return max_size_; }
+    /**
+     * @brief Pin the size: min, max and preferred all equal
+     * Fixed-size widgets are relayout boundaries.
+     */
+    void set_fixed_size(const Sizef& size) {
+        preferred_size_ = size;
+        set_extra(&WidgetExtras::min_size, extra_min_size, size);
+        set_extra(&WidgetExtras::max_size, extra_max_size, size);
+        invalidate_size();
+    }
+    
+    const Sizef& min_size() const { return get_extra(&WidgetExtras::min_size, extra_min_size); }
+    const Sizef& max_size() const { return get_extra(&WidgetExtras::max_size, extra_max_size); }
     const Sizef& preferred_size() const { return preferred_size_; }
     
-    void set_alignment(const Align& align) { alignment_ = align; mark_dirty(); }
-    const Align& alignment() const { return alignment_; }
+    void set_alignment(const Align& align) { set_extra(&WidgetExtras::alignment, extra_alignment, align); invalidate_size(); }
+    const Align& alignment() const { return get_extra(&WidgetExtras::alignment, extra_alignment); }
+    
+    /**
+     * @brief Size this widget wants within the available space (first pass)
+     * Cached: a second call with the same available size returns the last
+     * result until invalidate_layout(). FLT_MAX means unbounded.
+     */
+    Sizef measure(const Sizef& available) {
+        if ((layout_flags_ & layout_measured) && measured_available_ == available) {
+            return desired_size_;
+        }
+        
+        Sizef desired = measure_content(available);
+        const Sizef& lo = min_size();
+        const Sizef& hi = max_size();
+        desired_size_ = Sizef{std::clamp(desired.w, lo.w, std::max(lo.w, hi.w)),
+                              std::clamp(desired.h, lo.h, std::max(lo.h, hi.h))};
+        measured_available_ = available;
+        layout_flags_ |= layout_measured;
+        return desired_size_;
+    }
+    
+    /**
+     * @brief Result of the last measure()
+     */
+    const Sizef& desired_size() const { return desired_size_; }
+    
+    /**
+     * @brief Place this widget and lay out its children (second pass)
+     * Children are skipped when the rect is unchanged and nothing inside
+     * was invalidated.
+     */
+    void arrange(const Rectf& rect) {
+        if ((layout_flags_ & layout_arranged) && bounds_ == rect) {
+            if (layout_flags_ & layout_descendant) {
+                update_layout();
+            }
+            return;
+        }
+        
+        set_bounds(rect);
+        if (!(layout_flags_ & layout_measured)) {
+            measure(rect.size);  // Parent places it without measuring
+        }
+        layout_flags_ = static_cast<uint8_t>((layout_flags_ | layout_arranged) & ~(layout_descendant | layout_deferred | layout_placing));
+        run_arrange_content();
+    }
+    
+    /**
+     * @brief Lay out this subtree within its current bounds
+     * Always re-arranges this widget; cached results are reused below it.
+     */
+    void layout() {
+        layout_flags_ = static_cast<uint8_t>(layout_flags_ & ~layout_arranged);
+        update_layout();
+    }
+    
+    /**
+     * @brief Redo only invalidated layout - call on the root before rendering
+     * Descends along invalidated paths and re-arranges each invalidated
+     * relayout boundary inside its current bounds.
+     */
+    void update_layout() {
+        if (!(layout_flags_ & layout_arranged)) {
+            // Topmost invalid widget on a path: a boundary, so its size stands.
+            // Measure with the space its parent offered last time to keep
+            // that parent's cached measure of it consistent.
+            measure(parent_ && parent_->uses_child_measure(*this) ? measured_available_ : bounds_.size);
+            layout_flags_ = static_cast<uint8_t>((layout_flags_ | layout_arranged) & ~(layout_descendant | layout_deferred | layout_placing));
+            run_arrange_content();
+            return;
+        }
+        
+        if (layout_flags_ & layout_descendant) {
+            layout_flags_ = static_cast<uint8_t>(layout_flags_ & ~layout_descendant);
+            for (auto& child : children_) {
+                if (child->is_visible() && child->needs_layout() && !defer_child(*child)) {
+                    child->update_layout();
+                }
+            }
+        }
+    }
+    
+    /**
+     * @brief layout() with large sibling subtrees arranged on a task pool
+     * Children of at least min_subtree widgets become tasks; the result is
+     * identical to layout(). on_resize() and arrange_content() overrides
+     * then run on pool threads and must only touch their own subtree.
+     */
+    void layout(TaskPool& pool, size_t min_subtree = 512) {
+        ParallelScope scope(ParallelLayout{&pool, std::max<size_t>(min_subtree, 1), nullptr, nullptr});
+        layout();
+    }
+    
+    /**
+     * @brief update_layout() with the same parallelism as layout(TaskPool&)
+     */
+    void update_layout(TaskPool& pool, size_t min_subtree = 512) {
+        ParallelScope scope(ParallelLayout{&pool, std::max<size_t>(min_subtree, 1), nullptr, nullptr});
+        update_layout();
+    }
+    
+    /**
+     * @brief update_layout() that postpones large subtrees to a LayoutScheduler
+     */
+    void update_layout(LayoutDeferral& deferral) {
+        LayoutDeferral* outer = std::exchange(deferral_, &deferral);
+        update_layout();
+        deferral_ = outer;
+    }
+    
+    /**
+     * @brief update_layout(deferral) that stops when deferral.expired(); false if it did
+     * A container with at least min_subtree children measures them ahead of
+     * its own measure(), then places them from the rects arrange_content()
+     * gave, checking the time every 64 children. Those up to the end of
+     * deferral.viewport() are placed as soon as they are measured, where
+     * leading_rect() puts them. Call again with the same
+     * progress to go on; until then the children not yet placed are not
+     * drawn, and anything else that lays this widget out starts it over.
+     */
+    bool resume_layout(LayoutProgress& progress, LayoutDeferral& deferral) {
+        LayoutDeferral* outer = std::exchange(deferral_, &deferral);
+        bool done = resume_layout_slice(progress, deferral);
+        deferral_ = outer;
+        return done;
+    }
+    
+    /**
+     * @brief Number of widgets in this subtree, this one included
+     */
+    size_t subtree_size() const { return subtree_size_; }
+    
+    /**
+     * @brief Whether this widget or a descendant waits for update_layout()
+     */
+    bool needs_layout() const {
+        return !(layout_flags_ & layout_arranged) || (layout_flags_ & layout_descendant);
+    }
+    
+    /**
+     * @brief Content of this widget changed: drop cached layout up to the nearest boundary
+     * Ancestors above the boundary only get flagged so update_layout() can find it.
+     */
+    void invalidate_layout() {
+        Widget* w = this;
+        for (;;) {
+            w->layout_flags_ = static_cast<uint8_t>(w->layout_flags_ & ~(layout_measured | layout_arranged | layout_placing));
+            if (!w->parent_ || w->is_relayout_boundary()) break;
+            w = w->parent_;
+        }
+        
+        for (Widget* p = w->parent_; p; p = p->parent_) {
+            p->layout_flags_ |= layout_descendant;
+        }
+        mark_dirty();
+    }
+    
+    /**
+     * @brief Declare that this widget's size never depends on its content
+     */
+    void set_relayout_boundary(bool boundary) {
+        if (boundary) {
+            layout_flags_ |= layout_boundary;
+        } else {
+            layout_flags_ = static_cast<uint8_t>(layout_flags_ & ~layout_boundary);
+        }
+    }
+    
+    /**
+     * @brief Layout changes inside stop here instead of reaching the parent
+     * True when marked explicitly, when min and max size pin the size, or
+     * when the parent places it without measuring it.
+     */
+    bool is_relayout_boundary() const {
+        if (layout_flags_ & layout_boundary) return true;
+        if ((extras_ & (extra_min_size | extra_max_size)) && min_size() == max_size()) return true;
+        return parent_ && !parent_->uses_child_measure(*this);
+    }
+    
+protected:
+    /**
+     * @brief Whether order names every child index exactly once
+     */
+    bool is_permutation_of_children(std::span<const size_t> order) const {
+        if (order.size() != children_.size()) return false;
+        std::vector<bool> seen(order.size(), false);
+        for (size_t from : order) {
+            if (from >= seen.size() || seen[from]) return false;
+            seen[from] = true;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Apply a reorder_children() order to per-child data kept alongside children_
+     */
+    template <typename T, typename Alloc>
+    static void permute(std::vector<T, Alloc>& items, std::span<const size_t> order) {
+        std::vector<T, Alloc> reordered;
+        reordered.reserve(items.size());
+        for (size_t from : order) {
+            reordered.push_back(std::move(items[from]));
+        }
+        items = std::move(reordered);
+    }
+
+    /**
+     * @brief Desired size before min/max clamping - override in containers
+     * Containers measure their children here; leaves report preferred_size.
+     */
+    virtual Sizef measure_content(const Sizef& /*available*/) {
+        return preferred_size_;
+    }
+    
+    /**
+     * @brief Space measure_content() offers every child, when it is the same for all
+     * Lets resume_layout() measure the children ahead, in slices.
+     */
+    virtual std::optional<Sizef> child_measure_space(const Sizef& /*available*/) const {
+        return std::nullopt;
+    }
+    
+    /**
+     * @brief Rect arrange_content() will give a measured child, judged from the children before it
+     * Lets resume_layout() place the children in view before the rest are
+     * measured. previous is the rect it got for the last visible child before
+     * this one, if any. None when it cannot be told that early; a child put
+     * in the wrong place is moved by the arrange_content() pass.
+     */
+    virtual std::optional<Rectf> leading_rect(const Widget& /*child*/,
+                                              const std::optional<Rectf>& /*previous*/) const {
+        return std::nullopt;
+    }
     
     /**
-     * @brief Perform layout - override in containers
+     * @brief Arrange children inside bounds() - override in containers
+     * The default keeps each child where it was put with set_bounds().
      */
-    virtual void layout() {
+    virtual void arrange_content() {
         for (auto& child : children_) {
             if (child->is_visible()) {
-                child->layout();
+                arrange_child(*child, child->bounds_);
             }
         }
     }
     
+    /**
+     * @brief child.arrange(rect), from arrange_content()
+     * In a parallel layout, children are gathered into batches of about
+     * min_subtree widgets that the pool arranges before this widget's
+     * arrange() returns; do not touch the child again in the same
+     * arrange_content().
+     */
+    void arrange_child(Widget& child, const Rectf& rect) {
+        if (placements_) {
+            // Collected for resume_layout(); hidden at the old place until applied
+            bool placed = (child.layout_flags_ & layout_arranged) && child.bounds_ == rect;
+            if (!placed) child.layout_flags_ |= layout_deferred;
+            if (!placed || (child.layout_flags_ & layout_descendant)) placements_->emplace_back(&child, rect);
+            return;
+        }
+        
+        if (deferral_ && !((child.layout_flags_ & layout_arranged) && child.bounds_ == rect) &&
+            can_defer(child)) {
+            child.set_bounds(rect);
+            child.layout_flags_ = static_cast<uint8_t>((child.layout_flags_ & ~layout_arranged) | layout_deferred);
+            defer_child(child);
+            return;
+        }
+        
+        ParallelFrame* frame = parallel_.frame;
+        if (!frame) {
+            child.arrange(rect);
+            return;
+        }
+        
+        // What child.set_bounds() would have propagated past the task root
+        if (child.bounds_ != rect) {
+            invalidate_visual_bounds();
+            mark_dirty();
+        }
+        
+        frame->batch.emplace_back(&child, rect);
+        frame->batch_size += child.subtree_size_;
+        if (frame->batch_size >= parallel_.min_subtree) {
+            spawn_batch(*frame);
+        }
+    }
+    
+    bool can_defer(const Widget& child) const {
+        return deferral_ && !child.children_.empty() && subtree_size_ >= deferral_->min_subtree;
+    }
+    
+    /**
+     * @brief Queue a child that needs layout on the time-sliced pass, if one runs
+     * Flags the path to it so a later update_layout() still finds it.
+     */
+    bool defer_child(Widget& child) {
+        if (!can_defer(child)) return false;
+        
+        for (Widget* w = this; w && !(w->layout_flags_ & layout_descendant); w = w->parent_) {
+            w->layout_flags_ |= layout_descendant;
+        }
+        deferral_->defer(child);
+        return true;
+    }
+    
+    /**
+     * @brief Whether arrange_content() sizes this child from its measure()
+     * Children for which it does not are relayout boundaries.
+     */
+    virtual bool uses_child_measure(const Widget& /*child*/) const { return false; }
+    
+    /**
+     * @brief A child's preferred, min or max size or alignment was set
+     * For parents that read these outside measure(), e.g. as constraints.
+     */
+    virtual void child_size_changed(Widget& /*child*/) {}
+    
+    /**
+     * @brief A sizing property changed: a parent that measures it must lay out again too
+     */
+    void invalidate_size() {
+        invalidate_layout();
+        if (parent_) {
+            if (parent_->uses_child_measure(*this)) {
+                parent_->invalidate_layout();
+            }
+            parent_->child_size_changed(*this);
+        }
+    }
+    
+public:
     // === Appearance ===
     
     void set_background(const Color& color) {
-        background_ = color;
+        set_extra(&WidgetExtras::background, extra_background, color);
         mark_dirty();
     }
     
-    const Color& background() const { return background_; }
+    const Color& background() const { return get_extra(&WidgetExtras::background, extra_background); }
     
     void set_foreground(const Color& color) {
-        foreground_ = color;
+        set_extra(&WidgetExtras::foreground, extra_foreground, color);
         mark_dirty();
     }
     
-    const Color& foreground() const { return foreground_; }
+    const Color& foreground() const { return get_extra(&WidgetExtras::foreground, extra_foreground); }
     
     // === State Management ===
     
     void set_state(WidgetState state, bool value) {
+        if (has_state(state, WidgetState::visible) && parent_ && is_visible() != value) {
+            parent_->invalidate_visual_bounds();
+            parent_->invalidate_layout();
+        }
+        
         if (value) {
             state_ = state_ | state;
         } else {
@@ -227,8 +1113,8 @@ public:
     
     void mark_dirty() {
         state_ = state_ | WidgetState::dirty;
-        if (parent_) {
-            parent_->mark_dirty();
+        if (Widget* parent = propagation_parent()) {
+            parent->mark_dirty();
         }
     }
     
@@ -251,7 +1137,7 @@ public:
      * @brief Find widget at point (recursive)
      */
     virtual Widget* hit_test(const Pointf& point) {
-        if (!is_visible() || !contains(point)) {
+        if (!is_visible() || layout_pending() || !contains(point)) {
             return nullptr;
         }
         
@@ -340,16 +1226,51 @@ public:
     
     /**
      * @brief Render widget and children
+     * Canvas origin is expected at the parent's top-left corner. Subtrees whose
+     * visual bounds miss the visible area (viewport or active clip) are skipped,
+     * as are widgets marked hidden by cull_occluded() for the current frame.
      */
     virtual void render(Canvas& canvas) {
-        if (!is_visible()) return;
+        if (!is_visible() || layout_pending()) return;
+        
+        Rectf area = visual_bounds();
+        area.pos += bounds_.pos;
+        if (!canvas.is_visible(area)) {
+            canvas.stats().culled_subtrees++;
+            return;
+        }
+        
+        Occlusion hidden = occlusion(canvas);
+        if (hidden == Occlusion::subtree) {
+            canvas.stats().occluded_subtrees++;
+            return;
+        }
+        
+        CanvasTranslate translate(canvas, bounds_.pos);
         
         // Draw self
-        draw(canvas);
+        if (hidden == Occlusion::self) {
+            canvas.stats().occluded_widgets++;
+        } else {
+            draw(canvas);
+            
+            Rectf painted = visual_overflow();
+            painted.pos += canvas.origin();
+            painted = painted.intersected(canvas.visible_rect());
+            canvas.stats().drawn_widgets++;
+            canvas.stats().painted_area += painted.width() * painted.height();
+        }
         
         // Draw children
-        for (auto& child : children_) {
-            child->render(canvas);
+        if (clip_children_) {
+            CanvasClip clip(canvas, Rectf{0.0f, 0.0f, width(), height()});
+            for (auto& child : children_) {
+                child->render(canvas);
+            }
+        } else {
+            for (auto& child : children_) {
+                child->render(canvas);
+            }
         }
         
         clear_dirty();
@@ -362,14 +1283,63 @@ public:
         // Default: fill background
         // Canvas implementation akan di-implement nanti
     }
+    
+private:
+    /**
+     * @brief Visit subtree in reverse paint order, accumulating opaque areas
+     * @param covered Opaque region painted after this widget (target coordinates)
+     * @param origin Parent's top-left corner in target coordinates
+     * @param clip Visible area this widget paints into
+     */
+    void occlusion_pass(OcclusionRegion& covered, const Pointf& origin,
+                        const Rectf& clip, uint64_t frame) {
+        occlusion_frame_ = static_cast<uint32_t>(frame);
+        occlusion_ = Occlusion::none;
+        
+        if (!is_visible() || layout_pending()) return;
+        
+        Pointf local = origin + bounds_.pos;
+        
+        Rectf area = visual_bounds();
+        area.pos += local;
+        area = area.intersected(clip);
+        if (area.is_empty()) return;  // Culled by render() anyway
+        
+        if (covered.covers(area)) {
+            occlusion_ = Occlusion::subtree;
+            return;
+        }
+        
+        // Children paint on top of this widget, so they are visited first
+        Rectf child_clip = clip_children_ ? clip.intersected(Rectf{local, size()}) : clip;
+        for (auto it = children_.rbegin(); it != children_.rend(); ++it) {
+            (*it)->occlusion_pass(covered, local, child_clip, frame);
+        }
+        
+        Rectf own = visual_overflow();
+        own.pos += local;
+        if (covered.covers(own.intersected(clip))) {
+            occlusion_ = Occlusion::self;
+        }
+        
+        Rectf opaque = opaque_rect();
+        opaque.pos += local;
+        covered.add(opaque.intersected(clip));
+    }
 };
 
+// Two widgets per cache-line pair; a new field has to fit the existing padding
+static_assert(sizeof(void*) != 8 || sizeof(WidgetList) != 24 || sizeof(Widget) == 128,
+              "Widget grew past 128 bytes");
+
 /**
  * @brief Helper to create widgets
+ * Same as std::make_shared, but the allocation is charged to MemoryTag::widgets.
  */
 template <typename T, typename... Args>
-inline WidgetPtr make_widget(Args&&... args) {
-    return std::make_shared<T>(std::forward<Args>(args)...);
+inline std::shared_ptr<T> make_widget(Args&&... args) {
+    return std::allocate_shared<T>(TrackingAllocator<T, MemoryTag::widgets>{},
+                                   std::forward<Args>(args)...);
 }
 
 } // namespace zuu::widget
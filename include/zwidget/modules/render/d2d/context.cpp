@@ -489,7 +489,7 @@ void D2DContext::fill_polygon(
 }
 
 void D2DContext::draw_text(
-    const std::wstring& text,
+    std::wstring_view text,
     const Pointf& position,
     const Color& color,
     const TextStyle& style
@@ -497,7 +497,7 @@ void D2DContext::draw_text(
     std::lock_guard lock(mutex_);
     if (!is_drawing_) return;
     
-    auto format = create_text_format(style);
+    auto* format = get_text_format(style);
     auto* brush = get_solid_brush(color);
     
     // Measure text to create rect
@@ -505,16 +505,16 @@ void D2DContext::draw_text(
     Rectf rect{position.x, position.y, size.w, size.h};
     
     d2d_context_->DrawText(
-        text.c_str(),
+        text.data(),
         static_cast<UINT32>(text.length()),
-        format.Get(),
+        format,
         to_d2d_rect(rect),
         brush
     );
 }
 
 void D2DContext::draw_text(
-    const std::wstring& text,
+    std::wstring_view text,
     const Rectf& rect,
     const Color& color,
     const TextStyle& style
@@ -522,31 +522,31 @@ void D2DContext::draw_text(
     std::lock_guard lock(mutex_);
     if (!is_drawing_) return;
     
-    auto format = create_text_format(style);
+    auto* format = get_text_format(style);
     auto* brush = get_solid_brush(color);
     
     d2d_context_->DrawText(
-        text.c_str(),
+        text.data(),
         static_cast<UINT32>(text.length()),
-        format.Get(),
+        format,
         to_d2d_rect(rect),
         brush
     );
 }
 
 Sizef D2DContext::measure_text(
-    const std::wstring& text,
+    std::wstring_view text,
     const TextStyle& style
 ) {
     std::lock_guard lock(mutex_);
     
-    auto format = create_text_format(style);
+    auto* format = get_text_format(style);
     
     ComPtr<IDWriteTextLayout> layout;
     dwrite_factory_->CreateTextLayout(
-        text.c_str(),
+        text.data(),
         static_cast<UINT32>(text.length()),
-        format.Get(),
+        format,
         FLT_MAX,
         FLT_MAX,
         &layout
@@ -558,6 +558,46 @@ Sizef D2DContext::measure_text(
     return Sizef{metrics.width, metrics.height};
 }
 
+float D2DContext::measure_advances(
+    std::wstring_view text,
+    const TextStyle& style,
+    std::vector<float>& advances
+) {
+    std::lock_guard lock(mutex_);
+    
+    auto* format = get_text_format(style);
+    advances.assign(text.size(), 0.0f);
+    
+    ComPtr<IDWriteTextLayout> layout;
+    dwrite_factory_->CreateTextLayout(
+        text.data(),
+        static_cast<UINT32>(text.length()),
+        format,
+        FLT_MAX,
+        FLT_MAX,
+        &layout
+    );
+    
+    // One shaping pass: cluster widths, each credited to its first unit
+    UINT32 count = 0;
+    layout->GetClusterMetrics(nullptr, 0, &count);
+    std::vector<DWRITE_CLUSTER_METRICS> clusters(count);
+    if (count > 0 && SUCCEEDED(layout->GetClusterMetrics(clusters.data(), count, &count))) {
+        size_t pos = 0;
+        for (const auto& cluster : clusters) {
+            if (pos < advances.size()) {
+                advances[pos] = cluster.width;
+            }
+            pos += cluster.length;
+        }
+    }
+    
+    DWRITE_LINE_METRICS line{};
+    UINT32 lines = 0;
+    layout->GetLineMetrics(&line, 1, &lines);
+    return line.height;
+}
+
 // Stub implementations for image and gradient methods
 void D2DContext::draw_image(const Image&, const Pointf&, float) {}
 void D2DContext::draw_image(const Image&, const Rectf&, float) {}
@@ -662,6 +702,19 @@ ComPtr<IDWriteTextFormat> D2DContext::create_text_format(const TextStyle& style)
     return format;
 }
 
+IDWriteTextFormat* D2DContext::get_text_format(const TextStyle& style) {
+    if (auto it = text_format_cache_.find(style); it != text_format_cache_.end()) {
+        return it->second.Get();
+    }
+    
+    if (text_format_cache_.size() >= max_cached_text_formats_) {
+        text_format_cache_.clear();
+    }
+    
+    auto format = create_text_format(style);
+    return text_format_cache_.emplace(style, std::move(format)).first->second.Get();
+}
+
 D2D1_COLOR_F D2DContext::to_d2d_color(const Color& color) {
     return D2D1::ColorF(
         color.r / 255.0f,
@@ -0,0 +1,1044 @@
+#include "zwidget/render/soft/context.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+
+namespace zuu::widget {
+
+namespace {
+
+constexpr float pi = 3.14159265f;
+
+// Estimates used before any font is registered, matching TextShaper's fallback
+constexpr float fallback_advance = 0.52f;
+constexpr float fallback_space = 0.28f;
+constexpr float fallback_line_height = 1.33f;
+
+inline unsigned mul255(unsigned a, unsigned b) {
+    unsigned t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * @brief Code point at text[i], advancing i past a surrogate pair
+ */
+inline char32_t next_code_point(std::wstring_view text, size_t& i) {
+    char32_t cp = static_cast<char32_t>(text[i++]);
+    if constexpr (sizeof(wchar_t) == 2) {
+        if (cp >= 0xD800 && cp <= 0xDBFF && i < text.size() &&
+            text[i] >= 0xDC00 && text[i] <= 0xDFFF) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (static_cast<char32_t>(text[i++]) - 0xDC00);
+        }
+    }
+    return cp;
+}
+
+/**
+ * @brief Calls fn(line) for each '\n'-separated line, dropping a trailing '\r'
+ */
+template <typename Fn>
+void for_each_line(std::wstring_view text, Fn&& fn) {
+    size_t begin = 0;
+    while (true) {
+        size_t end = text.find(L'\n', begin);
+        std::wstring_view line = text.substr(begin, end == std::wstring_view::npos ? end : end - begin);
+        if (!line.empty() && line.back() == L'\r') line.remove_suffix(1);
+        fn(line);
+        if (end == std::wstring_view::npos) break;
+        begin = end + 1;
+    }
+}
+
+} // namespace
+
+// === Transform ===
+
+float SoftContext::Transform::scale() const {
+    return std::sqrt(std::fabs(a * d - b * c));
+}
+
+bool SoftContext::Transform::invert(Transform& out) const {
+    float det = a * d - b * c;
+    if (std::fabs(det) < 1e-12f) return false;
+    float inv = 1.0f / det;
+    out.a = d * inv;
+    out.b = -b * inv;
+    out.c = -c * inv;
+    out.d = a * inv;
+    out.e = (c * f - d * e) * inv;
+    out.f = (b * e - a * f) * inv;
+    return true;
+}
+
+// === SoftContext Implementation ===
+
+SoftContext::SoftContext(const Size& size, float dpi_scale)
+    : size_(size),
+      pixels_(static_cast<size_t>(size.w) * size.h, 0xFF000000u),
+      dpi_scale_(dpi_scale) {
+    transform_ = base_transform();
+}
+
+SoftContext::Transform SoftContext::base_transform() const {
+    return Transform{dpi_scale_, 0.0f, 0.0f, dpi_scale_, 0.0f, 0.0f};
+}
+
+SoftContext::ClipBox SoftContext::clip() const {
+    if (clip_stack_.empty()) return ClipBox{0, 0, static_cast<int>(size_.w), static_cast<int>(size_.h)};
+    return clip_stack_.back();
+}
+
+void SoftContext::add_font(FontFamily family, std::shared_ptr<const TrueTypeFont> font, bool bold, bool italic) {
+    std::lock_guard lock(mutex_);
+    if (!font) return;
+    fonts_.push_back(SoftFontFace{family, bold, italic, std::move(font)});
+    runs_.clear();  // A style may now resolve to the new face
+}
+
+void SoftContext::add_font(FontFamily family, const std::string& path, bool bold, bool italic) {
+    add_font(family, TrueTypeFont::load(path), bold, italic);
+}
+
+uint64_t SoftContext::font_identity() const {
+    std::lock_guard lock(mutex_);
+    uint64_t identity = TextCacheFile::hash(nullptr, 0);
+    for (const auto& face : fonts_) {
+        const std::wstring& name = face.family.name();
+        uint64_t style = (face.bold ? 1u : 0u) | (face.italic ? 2u : 0u);
+        identity = TextCacheFile::hash(name.data(), name.size() * sizeof(wchar_t), identity);
+        identity = TextCacheFile::combine(identity, style);
+        identity = TextCacheFile::combine(identity, face.font->identity());
+    }
+    return identity;
+}
+
+void SoftContext::set_text_cache(TextCacheFile* cache) {
+    std::lock_guard lock(mutex_);
+    atlas_.set_store(cache);
+}
+
+AtlasStats SoftContext::atlas_stats() const {
+    std::lock_guard lock(mutex_);
+    return atlas_.stats();
+}
+
+TextRunStats SoftContext::text_run_stats() const {
+    std::lock_guard lock(mutex_);
+    return runs_.stats();
+}
+
+void SoftContext::set_text_run_budget(size_t bytes) {
+    std::lock_guard lock(mutex_);
+    runs_.set_budget(bytes);
+}
+
+void SoftContext::set_dpi_scale(float scale) {
+    std::lock_guard lock(mutex_);
+    if (is_drawing_) {
+        throw std::runtime_error("Cannot change DPI while drawing");
+    }
+    // Atlas glyphs are keyed by pixel size and age out at its next reset; rendered
+    // runs are larger, so they are dropped now
+    if (scale != dpi_scale_) runs_.clear();
+    dpi_scale_ = scale;
+    transform_ = base_transform();
+}
+
+void SoftContext::begin_draw() {
+    std::lock_guard lock(mutex_);
+
+    if (is_drawing_) {
+        throw std::runtime_error("Already drawing");
+    }
+
+    transform_ = base_transform();
+    state_stack_.clear();
+    clip_stack_.clear();
+    atlas_.begin_frame();
+    runs_.begin_frame();
+    is_drawing_ = true;
+}
+
+void SoftContext::end_draw() {
+    std::lock_guard lock(mutex_);
+    is_drawing_ = false;
+}
+
+void SoftContext::clear(const Color& color) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    ClipBox box = clip();
+    uint32_t value = static_cast<uint32_t>(color.a) << 24 | static_cast<uint32_t>(color.r) << 16 |
+                     static_cast<uint32_t>(color.g) << 8 | color.b;
+    for (int y = box.y0; y < box.y1; ++y) {
+        uint32_t* row = pixels_.data() + static_cast<size_t>(y) * size_.w;
+        std::fill(row + box.x0, row + box.x1, value);
+    }
+}
+
+void SoftContext::save_state() {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    state_stack_.push_back(transform_);
+}
+
+void SoftContext::restore_state() {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_ || state_stack_.empty()) return;
+
+    transform_ = state_stack_.back();
+    state_stack_.pop_back();
+}
+
+void SoftContext::translate(float x, float y) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    transform_ = transform_.then(Transform{1.0f, 0.0f, 0.0f, 1.0f, x, y});
+}
+
+void SoftContext::scale(float sx, float sy) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    transform_ = transform_.then(Transform{sx, 0.0f, 0.0f, sy, 0.0f, 0.0f});
+}
+
+void SoftContext::rotate(float radians) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    transform_ = transform_.then(Transform{c, s, -s, c, 0.0f, 0.0f});
+}
+
+void SoftContext::reset_transform() {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    transform_ = base_transform();
+}
+
+void SoftContext::set_clip_rect(const Rectf& rect) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    // Axis-aligned: a rotated clip clips to its bounding box
+    Pointf corners[4] = {
+        transform_.apply(Pointf{rect.pos.x, rect.pos.y}),
+        transform_.apply(Pointf{rect.pos.x + rect.size.w, rect.pos.y}),
+        transform_.apply(Pointf{rect.pos.x, rect.pos.y + rect.size.h}),
+        transform_.apply(Pointf{rect.pos.x + rect.size.w, rect.pos.y + rect.size.h}),
+    };
+    float x0 = corners[0].x, x1 = x0, y0 = corners[0].y, y1 = y0;
+    for (const auto& p : corners) {
+        x0 = std::min(x0, p.x); x1 = std::max(x1, p.x);
+        y0 = std::min(y0, p.y); y1 = std::max(y1, p.y);
+    }
+
+    ClipBox parent = clip();
+    ClipBox box{
+        std::max(parent.x0, static_cast<int>(std::lround(x0))),
+        std::max(parent.y0, static_cast<int>(std::lround(y0))),
+        std::min(parent.x1, static_cast<int>(std::lround(x1))),
+        std::min(parent.y1, static_cast<int>(std::lround(y1))),
+    };
+    box.x1 = std::max(box.x1, box.x0);
+    box.y1 = std::max(box.y1, box.y0);
+    clip_stack_.push_back(box);
+}
+
+void SoftContext::reset_clip() {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_ || clip_stack_.empty()) return;
+
+    clip_stack_.pop_back();
+}
+
+// === Paths ===
+
+void SoftContext::begin_contour() {
+    if (!path_.empty() && (contour_ends_.empty() || contour_ends_.back() != path_.size())) {
+        contour_ends_.push_back(path_.size());
+    }
+}
+
+void SoftContext::add_point(const Pointf& p) {
+    path_.push_back(transform_.apply(p));
+}
+
+int SoftContext::arc_segments(float radius) const {
+    // Chord error under a quarter pixel on the device
+    float r = radius * transform_.scale();
+    if (r <= 1.0f) return 8;
+    float half_step = std::acos(std::max(1.0f - 0.25f / r, -1.0f));
+    return std::clamp(static_cast<int>(std::ceil(pi / half_step)), 8, 512);
+}
+
+void SoftContext::add_ellipse(const Pointf& center, float rx, float ry, bool reverse) {
+    begin_contour();
+    int n = arc_segments(std::max(rx, ry));
+    for (int i = 0; i < n; ++i) {
+        float t = 2.0f * pi * static_cast<float>(reverse ? n - i : i) / static_cast<float>(n);
+        add_point(Pointf{center.x + rx * std::cos(t), center.y + ry * std::sin(t)});
+    }
+}
+
+void SoftContext::add_rounded_rect(const Rectf& rect, float rx, float ry, bool reverse) {
+    begin_contour();
+    size_t first = path_.size();
+    float left = rect.pos.x, top = rect.pos.y;
+    float right = left + rect.size.w, bottom = top + rect.size.h;
+    rx = std::clamp(rx, 0.0f, rect.size.w * 0.5f);
+    ry = std::clamp(ry, 0.0f, rect.size.h * 0.5f);
+
+    if (rx <= 0.0f || ry <= 0.0f) {
+        add_point(Pointf{left, top});
+        add_point(Pointf{right, top});
+        add_point(Pointf{right, bottom});
+        add_point(Pointf{left, bottom});
+    } else {
+        // Quarter arcs clockwise from the top-right corner
+        const Pointf centers[4] = {
+            {right - rx, top + ry}, {right - rx, bottom - ry},
+            {left + rx, bottom - ry}, {left + rx, top + ry},
+        };
+        int n = std::max(arc_segments(std::max(rx, ry)) / 4, 2);
+        for (int corner = 0; corner < 4; ++corner) {
+            float start = -0.5f * pi + 0.5f * pi * static_cast<float>(corner);
+            for (int i = 0; i <= n; ++i) {
+                float t = start + 0.5f * pi * static_cast<float>(i) / static_cast<float>(n);
+                add_point(Pointf{centers[corner].x + rx * std::cos(t), centers[corner].y + ry * std::sin(t)});
+            }
+        }
+    }
+
+    if (reverse) {
+        std::reverse(path_.begin() + static_cast<ptrdiff_t>(first), path_.end());
+    }
+}
+
+void SoftContext::add_segment(const Pointf& p0, const Pointf& p1, float width) {
+    float dx = p1.x - p0.x;
+    float dy = p1.y - p0.y;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    // Every segment winds the same way, so overlaps saturate instead of cancelling
+    float nx = -dy / length * width * 0.5f;
+    float ny = dx / length * width * 0.5f;
+    begin_contour();
+    add_point(Pointf{p0.x + nx, p0.y + ny});
+    add_point(Pointf{p1.x + nx, p1.y + ny});
+    add_point(Pointf{p1.x - nx, p1.y - ny});
+    add_point(Pointf{p0.x - nx, p0.y - ny});
+}
+
+void SoftContext::fill_path(const Color& color) {
+    begin_contour();
+    if (path_.empty() || color.a == 0) {
+        path_.clear();
+        contour_ends_.clear();
+        return;
+    }
+
+    float min_x = path_[0].x, max_x = min_x, min_y = path_[0].y, max_y = min_y;
+    for (const auto& p : path_) {
+        min_x = std::min(min_x, p.x); max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y); max_y = std::max(max_y, p.y);
+    }
+
+    ClipBox box = clip();
+    int x0 = std::max(box.x0, static_cast<int>(std::floor(min_x)));
+    int y0 = std::max(box.y0, static_cast<int>(std::floor(min_y)));
+    int x1 = std::min(box.x1, static_cast<int>(std::ceil(max_x)));
+    int y1 = std::min(box.y1, static_cast<int>(std::ceil(max_y)));
+
+    if (x0 < x1 && y0 < y1) {
+        int w = x1 - x0;
+        int h = y1 - y0;
+        Pointf offset{static_cast<float>(x0), static_cast<float>(y0)};
+
+        rasterizer_.reset(w, h);
+        size_t begin = 0;
+        for (size_t end : contour_ends_) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t next = i + 1 == end ? begin : i + 1;
+                rasterizer_.line(Pointf{path_[i].x - offset.x, path_[i].y - offset.y},
+                                 Pointf{path_[next].x - offset.x, path_[next].y - offset.y});
+            }
+            begin = end;
+        }
+
+        mask_.resize(static_cast<size_t>(w) * h);
+        rasterizer_.resolve(mask_.data(), static_cast<size_t>(w));
+        for (int y = 0; y < h; ++y) {
+            blend_span(pixels_.data() + static_cast<size_t>(y0 + y) * size_.w + x0,
+                       mask_.data() + static_cast<size_t>(y) * w, w, color);
+        }
+    }
+
+    path_.clear();
+    contour_ends_.clear();
+}
+
+// === Blending ===
+
+void SoftContext::blend_pixel(uint32_t& dst, const Color& color, unsigned coverage) {
+    unsigned alpha = mul255(color.a, coverage);
+    if (alpha == 0) return;
+    if (alpha == 255) {
+        dst = 0xFF000000u | static_cast<uint32_t>(color.r) << 16 | static_cast<uint32_t>(color.g) << 8 | color.b;
+        return;
+    }
+
+    unsigned inverse = 255 - alpha;
+    unsigned a = (dst >> 24) & 0xFF, r = (dst >> 16) & 0xFF, g = (dst >> 8) & 0xFF, b = dst & 0xFF;
+    a = alpha + mul255(a, inverse);
+    r = mul255(color.r, alpha) + mul255(r, inverse);
+    g = mul255(color.g, alpha) + mul255(g, inverse);
+    b = mul255(color.b, alpha) + mul255(b, inverse);
+    dst = a << 24 | r << 16 | g << 8 | b;
+}
+
+void SoftContext::blend_span(uint32_t* dst, const uint8_t* coverage, int count, const Color& color) {
+    // Two channels per multiply: red/blue and alpha/green, 8 bits of headroom each
+    const uint32_t src = 0xFF000000u | static_cast<uint32_t>(color.r) << 16 |
+                         static_cast<uint32_t>(color.g) << 8 | color.b;
+    const uint32_t src_rb = src & 0x00FF00FFu;
+    const uint32_t src_ag = (src >> 8) & 0x00FF00FFu;
+    const bool opaque = color.a == 255;
+
+    for (int i = 0; i < count; ++i) {
+        unsigned c = coverage[i];
+        if (!c) continue;
+        unsigned alpha = opaque ? c : mul255(color.a, c);
+        if (alpha == 255) {
+            dst[i] = src;
+            continue;
+        }
+
+        uint32_t w = alpha + (alpha >> 7);  // 0..256
+        uint32_t d = dst[i];
+        uint32_t rb = ((src_rb * w + (d & 0x00FF00FFu) * (256 - w)) >> 8) & 0x00FF00FFu;
+        uint32_t ag = ((src_ag * w + ((d >> 8) & 0x00FF00FFu) * (256 - w)) >> 8) & 0x00FF00FFu;
+        dst[i] = rb | ag << 8;
+    }
+}
+
+// === Shapes ===
+
+void SoftContext::draw_line(
+    const Pointf& start,
+    const Pointf& end,
+    const Color& color,
+    float width
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    add_segment(start, end, width);
+    fill_path(color);
+}
+
+void SoftContext::draw_rect(const Rectf& rect, const Color& color, float width) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    // Outer edge, then the inner edge wound the other way to cut the hole
+    float half = width * 0.5f;
+    add_rounded_rect(Rectf{rect.pos.x - half, rect.pos.y - half, rect.size.w + width, rect.size.h + width},
+                     0.0f, 0.0f, false);
+    if (rect.size.w > width && rect.size.h > width) {
+        add_rounded_rect(Rectf{rect.pos.x + half, rect.pos.y + half, rect.size.w - width, rect.size.h - width},
+                         0.0f, 0.0f, true);
+    }
+    fill_path(color);
+}
+
+void SoftContext::fill_rect(const Rectf& rect, const Color& color) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    if (transform_.b != 0.0f || transform_.c != 0.0f) {
+        add_rounded_rect(rect, 0.0f, 0.0f, false);
+        fill_path(color);
+        return;
+    }
+
+    // Axis-aligned: coverage is separable, so only the edge rows and columns are partial
+    Pointf p0 = transform_.apply(rect.pos);
+    Pointf p1 = transform_.apply(Pointf{rect.pos.x + rect.size.w, rect.pos.y + rect.size.h});
+    float left = std::min(p0.x, p1.x), right = std::max(p0.x, p1.x);
+    float top = std::min(p0.y, p1.y), bottom = std::max(p0.y, p1.y);
+
+    ClipBox box = clip();
+    int x0 = std::max(box.x0, static_cast<int>(std::floor(left)));
+    int x1 = std::min(box.x1, static_cast<int>(std::ceil(right)));
+    int y0 = std::max(box.y0, static_cast<int>(std::floor(top)));
+    int y1 = std::min(box.y1, static_cast<int>(std::ceil(bottom)));
+    if (x0 >= x1 || y0 >= y1) return;
+
+    auto overlap = [](int cell, float from, float to) {
+        return std::clamp(std::min(to, static_cast<float>(cell + 1)) - std::max(from, static_cast<float>(cell)),
+                          0.0f, 1.0f);
+    };
+
+    int w = x1 - x0;
+    mask_.resize(static_cast<size_t>(w) * 2);
+    uint8_t* columns = mask_.data();
+    uint8_t* row = mask_.data() + w;
+    for (int x = 0; x < w; ++x) {
+        columns[x] = static_cast<uint8_t>(overlap(x0 + x, left, right) * 255.0f + 0.5f);
+    }
+
+    for (int y = y0; y < y1; ++y) {
+        float vertical = overlap(y, top, bottom);
+        const uint8_t* coverage = columns;
+        if (vertical < 1.0f) {
+            for (int x = 0; x < w; ++x) {
+                row[x] = static_cast<uint8_t>(static_cast<float>(columns[x]) * vertical + 0.5f);
+            }
+            coverage = row;
+        }
+        blend_span(pixels_.data() + static_cast<size_t>(y) * size_.w + x0, coverage, w, color);
+    }
+}
+
+void SoftContext::draw_rounded_rect(
+    const Rectf& rect,
+    float radius_x,
+    float radius_y,
+    const Color& color,
+    float width
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    float half = width * 0.5f;
+    add_rounded_rect(Rectf{rect.pos.x - half, rect.pos.y - half, rect.size.w + width, rect.size.h + width},
+                     radius_x + half, radius_y + half, false);
+    if (rect.size.w > width && rect.size.h > width) {
+        add_rounded_rect(Rectf{rect.pos.x + half, rect.pos.y + half, rect.size.w - width, rect.size.h - width},
+                         radius_x - half, radius_y - half, true);
+    }
+    fill_path(color);
+}
+
+void SoftContext::fill_rounded_rect(
+    const Rectf& rect,
+    float radius_x,
+    float radius_y,
+    const Color& color
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    add_rounded_rect(rect, radius_x, radius_y, false);
+    fill_path(color);
+}
+
+void SoftContext::draw_ellipse(
+    const Pointf& center,
+    float radius_x,
+    float radius_y,
+    const Color& color,
+    float width
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    float half = width * 0.5f;
+    add_ellipse(center, radius_x + half, radius_y + half, false);
+    if (radius_x > half && radius_y > half) {
+        add_ellipse(center, radius_x - half, radius_y - half, true);
+    }
+    fill_path(color);
+}
+
+void SoftContext::fill_ellipse(
+    const Pointf& center,
+    float radius_x,
+    float radius_y,
+    const Color& color
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    add_ellipse(center, radius_x, radius_y, false);
+    fill_path(color);
+}
+
+void SoftContext::draw_polyline(
+    const std::vector<Pointf>& points,
+    const Color& color,
+    float width,
+    bool closed
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_ || points.size() < 2) return;
+
+    size_t count = closed ? points.size() : points.size() - 1;
+    for (size_t i = 0; i < count; ++i) {
+        add_segment(points[i], points[(i + 1) % points.size()], width);
+    }
+
+    // Round joins; wound like the segments (clockwise on screen)
+    if (width > 1.0f) {
+        size_t first = closed ? 0 : 1;
+        size_t last = closed ? points.size() : points.size() - 1;
+        for (size_t i = first; i < last; ++i) {
+            add_ellipse(points[i], width * 0.5f, width * 0.5f, true);
+        }
+    }
+    fill_path(color);
+}
+
+void SoftContext::fill_polygon(
+    const std::vector<Pointf>& points,
+    const Color& color
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_ || points.size() < 3) return;
+
+    begin_contour();
+    for (const auto& p : points) {
+        add_point(p);
+    }
+    fill_path(color);
+}
+
+// === Text ===
+
+const TrueTypeFont* SoftContext::font_for(const TextStyle& style) const {
+    const SoftFontFace* family_match = nullptr;
+    for (const auto& face : fonts_) {
+        if (face.family != style.font_family) continue;
+        if (face.bold == style.bold && face.italic == style.italic) return face.font.get();
+        if (!family_match) family_match = &face;
+    }
+    if (family_match) return family_match->font.get();
+    return fonts_.empty() ? nullptr : fonts_.front().font.get();
+}
+
+float SoftContext::line_height(const TrueTypeFont* font, float em) const {
+    if (!font) return em * fallback_line_height;
+    return static_cast<float>(font->ascent() - font->descent() + font->line_gap()) * font->scale(em);
+}
+
+float SoftContext::line_width(const TrueTypeFont* font, std::wstring_view line, float em) const {
+    float width = 0.0f;
+    if (!font) {
+        for (wchar_t ch : line) {
+            width += em * (ch == L' ' ? fallback_space : fallback_advance);
+        }
+        return width;
+    }
+
+    float scale = font->scale(em);
+    for (size_t i = 0; i < line.size();) {
+        width += static_cast<float>(font->metrics(font->glyph_index(next_code_point(line, i))).advance) * scale;
+    }
+    return width;
+}
+
+void SoftContext::render_run(const TrueTypeFont& font, std::wstring_view line, float em, TextRun& run) {
+    float scale = font.scale(em);
+
+    // First pass: pen positions and the bounding box of the inked glyphs
+    placed_.clear();
+    int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN;
+    float pen_x = 0.0f;
+    for (size_t i = 0; i < line.size();) {
+        uint16_t glyph = font.glyph_index(next_code_point(line, i));
+        AtlasGlyph placed = atlas_.glyph(font, glyph, em, pen_x);
+        if (placed.width) {
+            int gx = static_cast<int>(std::floor(pen_x)) + placed.left;
+            left = std::min(left, gx);
+            top = std::min(top, static_cast<int>(placed.top));
+            right = std::max(right, gx + placed.width);
+            bottom = std::max(bottom, placed.top + placed.height);
+            placed_.push_back(PlacedGlyph{glyph, pen_x});
+        }
+        pen_x += static_cast<float>(font.metrics(glyph).advance) * scale;
+    }
+
+    run.advance = pen_x;
+    if (placed_.empty()) {
+        run.left = run.top = run.width = run.height = 0;
+        run.coverage.clear();
+        return;
+    }
+    run.left = left;
+    run.top = top;
+    run.width = right - left;
+    run.height = bottom - top;
+    run.coverage.assign(static_cast<size_t>(run.width) * run.height, 0);
+
+    // Second pass: copy each glyph right after looking it up, since a lookup
+    // that fills the atlas clears it and moves the glyphs copied before
+    const uint8_t* atlas = atlas_.pixels();
+    size_t atlas_stride = static_cast<size_t>(atlas_.width());
+    for (const auto& g : placed_) {
+        AtlasGlyph placed = atlas_.glyph(font, g.glyph, em, g.pen_x);
+        int gx = static_cast<int>(std::floor(g.pen_x)) + placed.left - left;
+        int gy = placed.top - top;
+        for (int y = 0; y < placed.height; ++y) {
+            const uint8_t* src = atlas + static_cast<size_t>(placed.y + y) * atlas_stride + placed.x;
+            uint8_t* dst = run.coverage.data() + static_cast<size_t>(gy + y) * run.width + gx;
+            for (int x = 0; x < placed.width; ++x) {
+                dst[x] = std::max(dst[x], src[x]);  // Overlapping glyphs keep the stronger ink
+            }
+        }
+    }
+}
+
+const TextRun& SoftContext::text_run(const TrueTypeFont& font, std::wstring_view line, const TextStyle& style,
+                                     uint16_t size) {
+    if (const TextRun* cached = runs_.find(line, style, size)) {
+        return *cached;
+    }
+
+    render_run(font, line, static_cast<float>(size) / 4.0f, run_scratch_);
+    if (const TextRun* stored = runs_.insert(line, style, size, run_scratch_)) {
+        return *stored;
+    }
+    return run_scratch_;
+}
+
+void SoftContext::draw_glyphs(const TrueTypeFont& font, std::wstring_view line, float em, int x, int y,
+                              const Color& color) {
+    float scale = font.scale(em);
+    ClipBox box = clip();
+    float pen_x = 0.0f;
+    for (size_t i = 0; i < line.size();) {
+        uint16_t glyph = font.glyph_index(next_code_point(line, i));
+        AtlasGlyph placed = atlas_.glyph(font, glyph, em, pen_x);
+        if (placed.width) {
+            // Same placement as render_run(), relative to the run's origin
+            int gx = x + static_cast<int>(std::floor(pen_x)) + placed.left;
+            int gy = y + placed.top;
+            int x0 = std::max(gx, box.x0), x1 = std::min(gx + placed.width, box.x1);
+            int y0 = std::max(gy, box.y0), y1 = std::min(gy + placed.height, box.y1);
+            const uint8_t* atlas = atlas_.pixels();  // Read after the lookup, which may refill the atlas
+            size_t atlas_stride = static_cast<size_t>(atlas_.width());
+            for (int row = y0; row < y1; ++row) {
+                blend_span(pixels_.data() + static_cast<size_t>(row) * size_.w + x0,
+                           atlas + static_cast<size_t>(placed.y + row - gy) * atlas_stride + placed.x + (x0 - gx),
+                           x1 - x0, color);
+            }
+        }
+        pen_x += static_cast<float>(font.metrics(glyph).advance) * scale;
+    }
+}
+
+void SoftContext::draw_line_of_text(
+    const TrueTypeFont* font,
+    std::wstring_view line,
+    Pointf position,
+    float box_width,
+    const Color& color,
+    const TextStyle& style
+) {
+    // Glyphs are rendered at the device size of the em and stay upright under rotation
+    auto size = static_cast<uint16_t>(
+        std::clamp(std::lround(style.font_size * transform_.scale() * 4.0f), 1L, 65535L));
+    float device_scale = std::max(transform_.scale(), 1e-3f);
+
+    // With no run budget nothing would be kept, so glyphs are blended straight
+    // from the atlas instead of being composed into a run first
+    const TextRun* run = nullptr;
+    float width = 0.0f;
+    if (runs_.budget() > 0) {
+        run = &text_run(*font, line, style, size);
+        width = run->advance / device_scale;
+    } else if ((box_width >= 0.0f && style.align != TextAlign::left) || style.underline || style.strikethrough) {
+        width = line_width(font, line, static_cast<float>(size) / 4.0f) / device_scale;
+    }
+
+    // Aligned within box_width when it is given (rect draws)
+    if (box_width >= 0.0f && style.align != TextAlign::left) {
+        float slack = box_width - width;
+        position.x += style.align == TextAlign::center ? slack * 0.5f : slack;
+    }
+
+    float ascent = static_cast<float>(font->ascent()) * font->scale(style.font_size);
+    Pointf origin = transform_.apply(Pointf{position.x, position.y + ascent});
+    int ox = static_cast<int>(std::lround(origin.x));
+    int oy = static_cast<int>(std::lround(origin.y));
+
+    if (run) {
+        int rx = ox + run->left;
+        int ry = oy + run->top;
+        ClipBox box = clip();
+        int x0 = std::max(rx, box.x0), x1 = std::min(rx + run->width, box.x1);
+        int y0 = std::max(ry, box.y0), y1 = std::min(ry + run->height, box.y1);
+        for (int y = y0; y < y1; ++y) {
+            blend_span(pixels_.data() + static_cast<size_t>(y) * size_.w + x0,
+                       run->coverage.data() + static_cast<size_t>(y - ry) * run->width + (x0 - rx), x1 - x0, color);
+        }
+    } else {
+        draw_glyphs(*font, line, static_cast<float>(size) / 4.0f, ox, oy, color);
+    }
+
+    if (style.underline || style.strikethrough) {
+        float thickness = std::max(style.font_size / 14.0f, 1.0f / device_scale);
+        if (style.underline) {
+            add_rounded_rect(Rectf{position.x, position.y + ascent + style.font_size * 0.1f, width, thickness},
+                             0.0f, 0.0f, false);
+        }
+        if (style.strikethrough) {
+            add_rounded_rect(Rectf{position.x, position.y + ascent - style.font_size * 0.3f, width, thickness},
+                             0.0f, 0.0f, false);
+        }
+        fill_path(color);
+    }
+}
+
+void SoftContext::draw_text(
+    std::wstring_view text,
+    const Pointf& position,
+    const Color& color,
+    const TextStyle& style
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    const TrueTypeFont* font = font_for(style);
+    if (!font) return;
+
+    float height = line_height(font, style.font_size);
+    Pointf pen = position;
+    for_each_line(text, [&](std::wstring_view line) {
+        draw_line_of_text(font, line, pen, -1.0f, color, style);
+        pen.y += height;
+    });
+}
+
+void SoftContext::draw_text(
+    std::wstring_view text,
+    const Rectf& rect,
+    const Color& color,
+    const TextStyle& style
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    const TrueTypeFont* font = font_for(style);
+    if (!font) return;
+
+    float height = line_height(font, style.font_size);
+    size_t lines = static_cast<size_t>(std::count(text.begin(), text.end(), L'\n')) + 1;
+    float total = height * static_cast<float>(lines);
+
+    float y = rect.pos.y;
+    if (style.valign == TextVAlign::middle) y += (rect.size.h - total) * 0.5f;
+    else if (style.valign == TextVAlign::bottom) y += rect.size.h - total;
+
+    for_each_line(text, [&](std::wstring_view line) {
+        draw_line_of_text(font, line, Pointf{rect.pos.x, y}, rect.size.w, color, style);
+        y += height;
+    });
+}
+
+Sizef SoftContext::measure_text(
+    std::wstring_view text,
+    const TextStyle& style
+) {
+    std::lock_guard lock(mutex_);
+
+    const TrueTypeFont* font = font_for(style);
+    float width = 0.0f;
+    size_t lines = 0;
+    for_each_line(text, [&](std::wstring_view line) {
+        width = std::max(width, line_width(font, line, style.font_size));
+        ++lines;
+    });
+    return Sizef{width, line_height(font, style.font_size) * static_cast<float>(lines)};
+}
+
+float SoftContext::measure_advances(
+    std::wstring_view text,
+    const TextStyle& style,
+    std::vector<float>& advances
+) {
+    std::lock_guard lock(mutex_);
+
+    const TrueTypeFont* font = font_for(style);
+    advances.assign(text.size(), 0.0f);
+
+    if (!font) {
+        for (size_t i = 0; i < text.size(); ++i) {
+            advances[i] = style.font_size * (text[i] == L' ' ? fallback_space : fallback_advance);
+        }
+        return line_height(nullptr, style.font_size);
+    }
+
+    // A surrogate pair's advance goes to its first unit
+    float scale = font->scale(style.font_size);
+    for (size_t i = 0; i < text.size();) {
+        size_t first = i;
+        uint16_t glyph = font->glyph_index(next_code_point(text, i));
+        advances[first] = static_cast<float>(font->metrics(glyph).advance) * scale;
+    }
+    return line_height(font, style.font_size);
+}
+
+// === Images and Gradients ===
+
+void SoftContext::draw_image(const Image&, const Pointf&, float) {}
+void SoftContext::draw_image(const Image&, const Rectf&, float) {}
+void SoftContext::draw_image(const Image&, const Rectf&, const Rectf&, float) {}
+
+namespace {
+
+inline Color lerp(const Color& from, const Color& to, float t) {
+    auto mix = [t](uint8_t a, uint8_t b) {
+        return static_cast<uint8_t>(std::lround(static_cast<float>(a) + (static_cast<float>(b) - a) * t));
+    };
+    Color c;
+    c.r = mix(from.r, to.r);
+    c.g = mix(from.g, to.g);
+    c.b = mix(from.b, to.b);
+    c.a = mix(from.a, to.a);
+    return c;
+}
+
+} // namespace
+
+void SoftContext::fill_rect_gradient(
+    const Rectf& rect,
+    const Color& start_color,
+    const Color& end_color,
+    const Pointf& start_point,
+    const Pointf& end_point
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_) return;
+
+    float dx = end_point.x - start_point.x;
+    float dy = end_point.y - start_point.y;
+    float length_sq = dx * dx + dy * dy;
+    if (length_sq <= 0.0f) {
+        add_rounded_rect(rect, 0.0f, 0.0f, false);
+        fill_path(end_color);
+        return;
+    }
+
+    // Rasterize the rect's coverage, then shade each covered pixel in user space
+    Transform inverse;
+    if (!transform_.invert(inverse)) return;
+    add_rounded_rect(rect, 0.0f, 0.0f, false);
+
+    float min_x = path_[0].x, max_x = min_x, min_y = path_[0].y, max_y = min_y;
+    for (const auto& p : path_) {
+        min_x = std::min(min_x, p.x); max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y); max_y = std::max(max_y, p.y);
+    }
+    ClipBox box = clip();
+    int x0 = std::max(box.x0, static_cast<int>(std::floor(min_x)));
+    int y0 = std::max(box.y0, static_cast<int>(std::floor(min_y)));
+    int x1 = std::min(box.x1, static_cast<int>(std::ceil(max_x)));
+    int y1 = std::min(box.y1, static_cast<int>(std::ceil(max_y)));
+    if (x0 >= x1 || y0 >= y1) {
+        path_.clear();
+        contour_ends_.clear();
+        return;
+    }
+
+    int w = x1 - x0;
+    int h = y1 - y0;
+    rasterizer_.reset(w, h);
+    for (size_t i = 0; i < path_.size(); ++i) {
+        const Pointf& p = path_[i];
+        const Pointf& q = path_[(i + 1) % path_.size()];
+        rasterizer_.line(Pointf{p.x - x0, p.y - y0}, Pointf{q.x - x0, q.y - y0});
+    }
+    mask_.resize(static_cast<size_t>(w) * h);
+    rasterizer_.resolve(mask_.data(), static_cast<size_t>(w));
+    path_.clear();
+    contour_ends_.clear();
+
+    for (int y = 0; y < h; ++y) {
+        uint32_t* row = pixels_.data() + static_cast<size_t>(y0 + y) * size_.w + x0;
+        const uint8_t* coverage = mask_.data() + static_cast<size_t>(y) * w;
+        for (int x = 0; x < w; ++x) {
+            if (!coverage[x]) continue;
+            Pointf p = inverse.apply(Pointf{x0 + x + 0.5f, y0 + y + 0.5f});
+            float t = ((p.x - start_point.x) * dx + (p.y - start_point.y) * dy) / length_sq;
+            blend_pixel(row[x], lerp(start_color, end_color, std::clamp(t, 0.0f, 1.0f)), coverage[x]);
+        }
+    }
+}
+
+void SoftContext::fill_rect_radial_gradient(
+    const Rectf& rect,
+    const Color& center_color,
+    const Color& edge_color,
+    const Pointf& center,
+    float radius_x,
+    float radius_y
+) {
+    std::lock_guard lock(mutex_);
+    if (!is_drawing_ || radius_x <= 0.0f || radius_y <= 0.0f) return;
+
+    Transform inverse;
+    if (!transform_.invert(inverse)) return;
+
+    Pointf a = transform_.apply(rect.pos);
+    Pointf b = transform_.apply(Pointf{rect.pos.x + rect.size.w, rect.pos.y + rect.size.h});
+    ClipBox box = clip();
+    int x0 = std::max(box.x0, static_cast<int>(std::floor(std::min(a.x, b.x))));
+    int y0 = std::max(box.y0, static_cast<int>(std::floor(std::min(a.y, b.y))));
+    int x1 = std::min(box.x1, static_cast<int>(std::ceil(std::max(a.x, b.x))));
+    int y1 = std::min(box.y1, static_cast<int>(std::ceil(std::max(a.y, b.y))));
+
+    for (int y = y0; y < y1; ++y) {
+        uint32_t* row = pixels_.data() + static_cast<size_t>(y) * size_.w;
+        for (int x = x0; x < x1; ++x) {
+            Pointf p = inverse.apply(Pointf{x + 0.5f, y + 0.5f});
+            if (p.x < rect.pos.x || p.y < rect.pos.y ||
+                p.x >= rect.pos.x + rect.size.w || p.y >= rect.pos.y + rect.size.h) continue;
+            float u = (p.x - center.x) / radius_x;
+            float v = (p.y - center.y) / radius_y;
+            float t = std::min(std::sqrt(u * u + v * v), 1.0f);
+            blend_pixel(row[x], lerp(center_color, edge_color, t), 255);
+        }
+    }
+}
+
+// === Properties ===
+
+Sizef SoftContext::get_size() const {
+    std::lock_guard lock(mutex_);
+    return Sizef{static_cast<float>(size_.w), static_cast<float>(size_.h)};
+}
+
+float SoftContext::get_dpi_scale() const {
+    std::lock_guard lock(mutex_);
+    return dpi_scale_;
+}
+
+bool SoftContext::is_drawing() const {
+    std::lock_guard lock(mutex_);
+    return is_drawing_;
+}
+
+void SoftContext::resize(const Size& new_size) {
+    std::lock_guard lock(mutex_);
+
+    if (is_drawing_) {
+        throw std::runtime_error("Cannot resize while drawing");
+    }
+
+    size_ = new_size;
+    pixels_.assign(static_cast<size_t>(new_size.w) * new_size.h, 0xFF000000u);
+}
+
+void SoftContext::flush() {}
+
+} // namespace zuu::widget
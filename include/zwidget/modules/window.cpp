@@ -114,6 +114,14 @@ LRESULT Window::HandleMessage(UINT msg, WPARAM wp, LPARAM lp) {
             );
             break;
             
+        case WM_MOUSEWHEEL: {
+            // Wheel positions are in screen coordinates
+            POINT pt{GET_X_LPARAM(lp), GET_Y_LPARAM(lp)};
+            ScreenToClient(hwnd_, &pt);
+            event = Event(MouseEvent{Pointf{float(pt.x), float(pt.y)}, GET_WHEEL_DELTA_WPARAM(wp)}, hwnd_);
+            break;
+        }
+            
         case WM_KEYDOWN:
         case WM_SYSKEYDOWN:
             event = make_keyboard_event(
@@ -8,9 +8,35 @@
  */
 
 #include "context.hpp"
+#include "style.hpp"
+#include "text_layout.hpp"
+#include "zwidget/core/memory.hpp"
+#include "zwidget/unit/utf8.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace zuu::widget {
 
+/**
+ * @brief Per-frame rendering statistics
+ */
+struct RenderStats {
+    size_t drawn_widgets = 0;      // Widgets whose draw() was called
+    size_t culled_subtrees = 0;    // Subtrees skipped because they were off-screen or clipped
+    size_t occluded_subtrees = 0;  // Subtrees skipped because opaque widgets cover them
+    size_t occluded_widgets = 0;   // Widgets whose own draw() was skipped, children still rendered
+    float painted_area = 0.0f;     // Sum of visible areas of drawn widgets
+    float target_area = 0.0f;      // Area of the render target
+    
+    /**
+     * @brief Average number of times each target pixel was painted
+     */
+    float overdraw() const {
+        return target_area > 0.0f ? painted_area / target_area : 0.0f;
+    }
+};
+
 /**
  * @brief High-level canvas for widget rendering
  * Provides convenient drawing methods with automatic coordinate translation
@@ -20,8 +46,17 @@ private:
     RenderContext* context_;
     Pointf origin_;  // Current drawing origin
     
+    Rectf viewport_;                 // Render target area, refreshed by begin_frame()
+    std::vector<Rectf, TrackingAllocator<Rectf, MemoryTag::render_cache>> clip_stack_;  // Active clips in target coordinates (already intersected)
+    RenderStats stats_;
+    uint64_t frame_ = 0;
+    std::wstring wide_;              // Reused buffer for UTF-8 text handed to the backend
+    
 public:
-    explicit Canvas(RenderContext& ctx) : context_(&ctx), origin_{0, 0} {}
+    explicit Canvas(RenderContext& ctx)
+        : context_(&ctx)
+        , origin_{0, 0}
+        , viewport_{Pointf{0, 0}, ctx.get_size()} {}
     
     /**
      * @brief Get underlying render context
@@ -49,6 +84,46 @@ public:
      */
     void reset_origin() { origin_ = {0, 0}; }
     
+    // === Frame & Visibility ===
+    
+    /**
+     * @brief Start a new frame - refresh viewport and reset statistics
+     */
+    void begin_frame() {
+        viewport_ = Rectf{Pointf{0, 0}, context_->get_size()};
+        clip_stack_.clear();
+        stats_ = RenderStats{};
+        stats_.target_area = viewport_.width() * viewport_.height();
+        frame_++;
+    }
+    
+    /**
+     * @brief Number of begin_frame() calls so far (per-frame cache key)
+     */
+    uint64_t frame() const { return frame_; }
+    
+    /**
+     * @brief Currently visible area in target coordinates (viewport ∩ active clip)
+     */
+    const Rectf& visible_rect() const {
+        return clip_stack_.empty() ? viewport_ : clip_stack_.back();
+    }
+    
+    /**
+     * @brief Check if rect (relative to current origin) can produce any pixels
+     */
+    bool is_visible(const Rectf& rect) const {
+        Rectf r = rect;
+        r.pos += origin_;
+        return !r.is_empty() && r.intersects(visible_rect());
+    }
+    
+    /**
+     * @brief Statistics collected since last begin_frame()
+     */
+    RenderStats& stats() { return stats_; }
+    const RenderStats& stats() const { return stats_; }
+    
     // === Convenience Drawing Methods ===
     // All coordinates are relative to current origin
     
@@ -143,7 +218,7 @@ public:
      * @brief Draw text at position
      */
     void draw_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const Pointf& position,
         const Color& color,
         const TextStyle& style = TextStyle()
@@ -155,7 +230,7 @@ public:
      * @brief Draw text in rectangle
      */
     void draw_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const Rectf& rect,
         const Color& color,
         const TextStyle& style = TextStyle()
@@ -166,13 +241,34 @@ public:
     }
     
     /**
-     * @brief Measure text
+     * @brief Draw UTF-8 text in rectangle, transcoded for the backend
+     */
+    void draw_text(
+        std::string_view text,
+        const Rectf& rect,
+        const Color& color,
+        const TextStyle& style = TextStyle()
+    ) {
+        utf8::to_wide(text, wide_);
+        draw_text(std::wstring_view(wide_), rect, color, style);
+    }
+    
+    /**
+     * @brief Measure text, answered by the persistent text cache if TextShaper has one for this context
      */
     Sizef measure_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const TextStyle& style = TextStyle()
     ) {
-        return context_->measure_text(text, style);
+        return TextShaper::measure(*context_, text, style);
+    }
+    
+    Sizef measure_text(
+        std::string_view text,
+        const TextStyle& style = TextStyle()
+    ) {
+        utf8::to_wide(text, wide_);
+        return TextShaper::measure(*context_, wide_, style);
     }
     
     /**
@@ -225,13 +321,17 @@ public:
     void set_clip(const Rectf& rect) {
         Rectf r = rect;
         r.pos += origin_;
+        clip_stack_.push_back(visible_rect().intersected(r));
         context_->set_clip_rect(r);
     }
     
     /**
-     * @brief Reset clipping
+     * @brief Reset clipping (pops the most recent clip)
      */
     void reset_clip() {
+        if (!clip_stack_.empty()) {
+            clip_stack_.pop_back();
+        }
         context_->reset_clip();
     }
     
@@ -10,7 +10,11 @@
 #include "zwidget/unit/rect.hpp"
 #include "zwidget/unit/color.hpp"
 #include "zwidget/unit/point.hpp"
+#include "zwidget/render/font_family.hpp"
+#include <bit>
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace zuu::widget {
@@ -77,7 +81,7 @@ struct StrokeStyle {
  * @brief Text rendering options
  */
 struct TextStyle {
-    std::wstring font_family = L"Segoe UI";
+    FontFamily font_family;  // Defaults to Segoe UI
     float font_size = 12.0f;
     bool bold = false;
     bool italic = false;
@@ -87,8 +91,23 @@ struct TextStyle {
     TextVAlign valign = TextVAlign::top;
     
     TextStyle() = default;
-    TextStyle(std::wstring family, float size) 
-        : font_family(std::move(family)), font_size(size) {}
+    TextStyle(FontFamily family, float size) 
+        : font_family(family), font_size(size) {}
+    
+    bool operator==(const TextStyle&) const = default;
+    
+    /**
+     * @brief Cheap hash: the family hash is precomputed by its atom
+     */
+    size_t hash() const {
+        size_t flags = (bold ? 1u : 0u) | (italic ? 2u : 0u) | (underline ? 4u : 0u)
+                     | (strikethrough ? 8u : 0u)
+                     | (static_cast<size_t>(align) << 4) | (static_cast<size_t>(valign) << 8);
+        size_t h = font_family.hash();
+        h ^= std::bit_cast<uint32_t>(font_size) + 0x9e3779b9u + (h << 6) + (h >> 2);
+        h ^= flags + 0x9e3779b9u + (h << 6) + (h >> 2);
+        return h;
+    }
 };
 
 /**
@@ -280,7 +299,7 @@ public:
      * @brief Draw text at position
      */
     virtual void draw_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const Pointf& position,
         const Color& color,
         const TextStyle& style = TextStyle()
@@ -290,7 +309,7 @@ public:
      * @brief Draw text in rectangle with alignment
      */
     virtual void draw_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const Rectf& rect,
         const Color& color,
         const TextStyle& style = TextStyle()
@@ -300,10 +319,29 @@ public:
      * @brief Measure text dimensions
      */
     virtual Sizef measure_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const TextStyle& style = TextStyle()
     ) = 0;
     
+    /**
+     * @brief Advance of every UTF-16 unit when laid out on one line
+     * A cluster's advance goes to its first unit, the rest get 0. The
+     * default measures one unit at a time; backends should override it
+     * with a single shaping pass.
+     * @return Line height
+     */
+    virtual float measure_advances(
+        std::wstring_view text,
+        const TextStyle& style,
+        std::vector<float>& advances
+    ) {
+        advances.assign(text.size(), 0.0f);
+        for (size_t i = 0; i < text.size(); ++i) {
+            advances[i] = measure_text(text.substr(i, 1), style).w;
+        }
+        return measure_text(L"Ag", style).h;
+    }
+    
     // === Image Rendering ===
     
     /**
@@ -460,3 +498,10 @@ public:
 };
 
 } // namespace zuu::widget
+
+template <>
+struct std::hash<zuu::widget::TextStyle> {
+    size_t operator()(const zuu::widget::TextStyle& style) const noexcept {
+        return style.hash();
+    }
+};
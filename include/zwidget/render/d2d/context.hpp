@@ -15,6 +15,7 @@
 #include <wrl/client.h>
 #include <mutex>
 #include <stack>
+#include <unordered_map>
 
 #pragma comment(lib, "d2d1.lib")
 #pragma comment(lib, "d3d11.lib")
@@ -98,6 +99,10 @@ private:
         Color last_color;
     } brush_cache_;
     
+    // Text formats are device-independent; TextStyle hashes via its font atom
+    std::unordered_map<TextStyle, ComPtr<IDWriteTextFormat>> text_format_cache_;
+    static constexpr size_t max_cached_text_formats_ = 64;
+    
     // Helper methods
     void create_device_resources();
     void create_swap_chain(HWND hwnd);
@@ -106,6 +111,7 @@ private:
     
     ID2D1SolidColorBrush* get_solid_brush(const Color& color);
     ComPtr<IDWriteTextFormat> create_text_format(const TextStyle& style);
+    IDWriteTextFormat* get_text_format(const TextStyle& style);
     D2D1_COLOR_F to_d2d_color(const Color& color);
     D2D1_RECT_F to_d2d_rect(const Rectf& rect);
     D2D1_POINT_2F to_d2d_point(const Pointf& point);
@@ -202,24 +208,30 @@ public:
     ) override;
     
     void draw_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const Pointf& position,
         const Color& color,
         const TextStyle& style = TextStyle()
     ) override;
     
     void draw_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const Rectf& rect,
         const Color& color,
         const TextStyle& style = TextStyle()
     ) override;
     
     Sizef measure_text(
-        const std::wstring& text,
+        std::wstring_view text,
         const TextStyle& style = TextStyle()
     ) override;
     
+    float measure_advances(
+        std::wstring_view text,
+        const TextStyle& style,
+        std::vector<float>& advances
+    ) override;
+    
     void draw_image(
         const Image& image,
         const Pointf& position,
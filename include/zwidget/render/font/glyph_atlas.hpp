@@ -0,0 +1,322 @@
+#pragma once
+
+/**
+ * @file glyph_atlas.hpp
+ * @brief Lazily filled glyph coverage atlas with skyline packing
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Glyphs are rasterized on first use at a given (font, glyph, size,
+ * subpixel offset) and stored as 8-bit coverage in one atlas image. The
+ * skyline packer keeps the top edge of the used area as a list of segments
+ * and places each glyph as low as possible, which suits the many similar
+ * heights of text. When a glyph no longer fits the atlas is cleared and
+ * refilled on demand; the stats report how often that happens so the atlas
+ * can be sized for the screens it serves. With a TextCacheFile attached,
+ * glyphs rasterized by earlier runs are copied from it instead.
+ */
+
+#include "zwidget/render/font/rasterizer.hpp"
+#include "zwidget/render/font/text_cache_file.hpp"
+#include "zwidget/render/font/true_type.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Bottom-left skyline rectangle packer
+ */
+class SkylinePacker {
+private:
+    struct Segment {
+        int x;
+        int y;      // Top of the used area over [x, x + width)
+        int width;
+    };
+
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<Segment> skyline_;
+    size_t used_area_ = 0;
+
+    /**
+     * @brief Lowest y at which a w-wide rect can start at segment i, or -1
+     */
+    int fit(size_t i, int w) const {
+        if (skyline_[i].x + w > width_) return -1;
+        int y = 0;
+        for (int left = w; left > 0; ++i) {
+            if (i == skyline_.size()) return -1;
+            y = std::max(y, skyline_[i].y);
+            left -= skyline_[i].width;
+        }
+        return y;
+    }
+
+public:
+    SkylinePacker(int width, int height) : width_(width), height_(height) { clear(); }
+
+    void clear() {
+        skyline_.assign(1, Segment{0, 0, width_});
+        used_area_ = 0;
+    }
+
+    /**
+     * @brief Place a w x h rect; false if the atlas has no room for it
+     */
+    bool pack(int w, int h, int& out_x, int& out_y) {
+        int best_y = INT_MAX;
+        int best_width = INT_MAX;
+        size_t best = skyline_.size();
+        for (size_t i = 0; i < skyline_.size(); ++i) {
+            int y = fit(i, w);
+            if (y < 0 || y + h > height_) continue;
+            // Lowest first, then the narrowest segment to waste less
+            if (y < best_y || (y == best_y && skyline_[i].width < best_width)) {
+                best_y = y;
+                best_width = skyline_[i].width;
+                best = i;
+            }
+        }
+        if (best == skyline_.size()) return false;
+
+        out_x = skyline_[best].x;
+        out_y = best_y;
+
+        // Raise the skyline over [x, x + w): insert the new segment, trim those it covers
+        Segment raised{out_x, best_y + h, w};
+        skyline_.insert(skyline_.begin() + static_cast<ptrdiff_t>(best), raised);
+        size_t i = best + 1;
+        while (i < skyline_.size()) {
+            Segment& s = skyline_[i];
+            int covered = raised.x + raised.width - s.x;
+            if (covered <= 0) break;
+            if (covered < s.width) {
+                s.x += covered;
+                s.width -= covered;
+                break;
+            }
+            skyline_.erase(skyline_.begin() + static_cast<ptrdiff_t>(i));
+        }
+
+        // Merge neighbours of equal height
+        for (size_t k = 0; k + 1 < skyline_.size();) {
+            if (skyline_[k].y == skyline_[k + 1].y) {
+                skyline_[k].width += skyline_[k + 1].width;
+                skyline_.erase(skyline_.begin() + static_cast<ptrdiff_t>(k + 1));
+            } else {
+                ++k;
+            }
+        }
+
+        used_area_ += static_cast<size_t>(w) * h;
+        return true;
+    }
+
+    /**
+     * @brief Fraction of the area taken by packed rects
+     */
+    float occupancy() const {
+        return static_cast<float>(used_area_) / static_cast<float>(std::max(width_ * height_, 1));
+    }
+};
+
+/**
+ * @brief A glyph's place in the atlas and its offset from the pen position
+ * The bitmap's top-left is at (floor(pen x) + left, baseline + top).
+ */
+struct AtlasGlyph {
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint16_t width = 0;   // 0 for blank glyphs
+    uint16_t height = 0;
+    int16_t left = 0;
+    int16_t top = 0;
+};
+
+/**
+ * @brief Counters for sizing the atlas
+ */
+struct AtlasStats {
+    size_t glyphs = 0;            // Currently cached
+    size_t rasterized_frame = 0;  // Rasterized since begin_frame()
+    size_t rasterized_total = 0;
+    size_t loaded = 0;            // Copied from the cache file instead of rasterized
+    size_t evicted = 0;           // Dropped when the atlas was cleared to make room
+    size_t resets = 0;            // Times it was cleared
+    float occupancy = 0.0f;       // Packed area / atlas area
+};
+
+/**
+ * @brief Coverage atlas shared by all text drawn through one context
+ */
+class GlyphAtlas {
+public:
+    static constexpr int subpixel_steps = 4;  // Horizontal pen positions per pixel
+
+private:
+    struct Key {
+        const TrueTypeFont* font;
+        uint16_t glyph;
+        uint16_t size;      // Em size in quarter pixels
+        uint8_t subpixel;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            size_t h = std::hash<const void*>{}(k.font);
+            h ^= (static_cast<size_t>(k.glyph) << 16 | static_cast<size_t>(k.size) << 3 | k.subpixel) +
+                 0x9e3779b9u + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    int width_;
+    int height_;
+    std::vector<uint8_t> pixels_;
+    SkylinePacker packer_;
+    std::unordered_map<Key, AtlasGlyph, KeyHash> glyphs_;
+    CoverageRasterizer rasterizer_;
+    AtlasStats stats_;
+    TextCacheFile* store_ = nullptr;
+
+    /**
+     * @brief Room for a w x h glyph plus gutter, clearing the atlas if it is full
+     */
+    bool allocate(int w, int h, int& x, int& y) {
+        // One pixel of gutter keeps neighbours apart when sampled with filtering
+        if (packer_.pack(w + 1, h + 1, x, y)) return true;
+        stats_.evicted += glyphs_.size();
+        stats_.resets++;
+        glyphs_.clear();
+        packer_.clear();
+        std::fill(pixels_.begin(), pixels_.end(), uint8_t{0});
+        return packer_.pack(w + 1, h + 1, x, y);
+    }
+
+    AtlasGlyph rasterize(const TrueTypeFont& font, uint16_t glyph, uint16_t size, uint8_t subpixel) {
+        if (store_) {
+            if (auto cached = store_->find_glyph(font.identity(), glyph, size, subpixel)) {
+                return load(*cached);
+            }
+        }
+
+        GlyphOutline outline = font.outline(glyph);
+        if (outline.empty()) return AtlasGlyph{};
+
+        float em = static_cast<float>(size) / 4.0f;
+        float offset = static_cast<float>(subpixel) / subpixel_steps;
+        float scale = font.scale(em);
+        float min_x = outline.points[0].x, max_x = min_x;
+        float min_y = outline.points[0].y, max_y = min_y;
+        for (const auto& p : outline.points) {
+            min_x = std::min(min_x, p.x); max_x = std::max(max_x, p.x);
+            min_y = std::min(min_y, p.y); max_y = std::max(max_y, p.y);
+        }
+
+        int left = static_cast<int>(std::floor(min_x * scale + offset));
+        int right = static_cast<int>(std::ceil(max_x * scale + offset));
+        int top = static_cast<int>(std::floor(-max_y * scale));
+        int bottom = static_cast<int>(std::ceil(-min_y * scale));
+        int w = right - left;
+        int h = bottom - top;
+        if (w <= 0 || h <= 0 || w >= width_ || h >= height_) return AtlasGlyph{};
+
+        int x, y;
+        if (!allocate(w, h, x, y)) return AtlasGlyph{};
+
+        uint8_t* target = pixels_.data() + static_cast<size_t>(y) * width_ + x;
+        rasterizer_.reset(w, h);
+        rasterizer_.outline(outline, scale, Pointf{offset - static_cast<float>(left), -static_cast<float>(top)});
+        rasterizer_.resolve(target, static_cast<size_t>(width_));
+
+        stats_.rasterized_frame++;
+        stats_.rasterized_total++;
+        AtlasGlyph placed{static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                          static_cast<uint16_t>(w), static_cast<uint16_t>(h),
+                          static_cast<int16_t>(left), static_cast<int16_t>(top)};
+        if (store_) {
+            store_->store_glyph(font.identity(), glyph, size, subpixel,
+                                CachedGlyph{placed.left, placed.top, placed.width, placed.height, target},
+                                static_cast<size_t>(width_));
+        }
+        return placed;
+    }
+
+    AtlasGlyph load(const CachedGlyph& cached) {
+        int x, y;
+        if (cached.width == 0 || cached.width >= width_ || cached.height >= height_ ||
+            !allocate(cached.width, cached.height, x, y)) {
+            return AtlasGlyph{};
+        }
+        for (int row = 0; row < cached.height; ++row) {
+            std::copy_n(cached.coverage + static_cast<size_t>(row) * cached.width, cached.width,
+                        pixels_.data() + static_cast<size_t>(y + row) * width_ + x);
+        }
+        stats_.loaded++;
+        return AtlasGlyph{static_cast<uint16_t>(x), static_cast<uint16_t>(y), cached.width, cached.height,
+                          cached.left, cached.top};
+    }
+
+public:
+    explicit GlyphAtlas(int width = 1024, int height = 1024)
+        : width_(width), height_(height),
+          pixels_(static_cast<size_t>(width) * height, 0),
+          packer_(width, height) {}
+
+    /**
+     * @brief Cached glyph, rasterized now if missing
+     * @param pen_x Pen position in pixels; its fraction selects the subpixel variant
+     */
+    AtlasGlyph glyph(const TrueTypeFont& font, uint16_t glyph, float em, float pen_x) {
+        float fraction = pen_x - std::floor(pen_x);
+        auto subpixel = static_cast<uint8_t>(static_cast<int>(fraction * subpixel_steps) % subpixel_steps);
+        auto size = static_cast<uint16_t>(std::clamp(std::lround(em * 4.0f), 1L, 65535L));
+
+        Key key{&font, glyph, size, subpixel};
+        if (auto it = glyphs_.find(key); it != glyphs_.end()) {
+            return it->second;
+        }
+
+        AtlasGlyph placed = rasterize(font, glyph, size, subpixel);
+        glyphs_.emplace(key, placed);
+        return placed;
+    }
+
+    /**
+     * @brief Drop every glyph, e.g. when fonts are unloaded
+     */
+    void clear() {
+        glyphs_.clear();
+        packer_.clear();
+        std::fill(pixels_.begin(), pixels_.end(), uint8_t{0});
+    }
+
+    void begin_frame() { stats_.rasterized_frame = 0; }
+
+    /**
+     * @brief Persist rasterized glyphs in, and load them from, a cache file (nullptr to detach)
+     */
+    void set_store(TextCacheFile* store) { store_ = store; }
+
+    AtlasStats stats() const {
+        AtlasStats stats = stats_;
+        stats.glyphs = glyphs_.size();
+        stats.occupancy = packer_.occupancy();
+        return stats;
+    }
+
+    const uint8_t* pixels() const { return pixels_.data(); }
+    int width() const { return width_; }
+    int height() const { return height_; }
+};
+
+} // namespace zuu::widget
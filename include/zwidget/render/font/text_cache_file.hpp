@@ -0,0 +1,547 @@
+#pragma once
+
+/**
+ * @file text_cache_file.hpp
+ * @brief Persistent cache of text measurements and rasterized glyphs
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Cold starts spend their time measuring text and rasterizing
+ * glyphs that the previous run already produced. This file keeps both
+ * across runs. It is an append-only sequence of records behind a header
+ * holding a format version and a caller-supplied identity (fonts, backend).
+ * Loading maps the file and walks the record headers only; each record's
+ * checksum is verified the first time it is looked up. New results are
+ * kept in memory, up to the size limit, and appended by flush(). A header
+ * mismatch discards the file; a torn tail, as left by a crash during a
+ * flush, is cut off after the last whole record. Every failure degrades to
+ * an in-memory cache:
+ * the cache is an accelerator, never a source of errors. One process should
+ * write a given file at a time.
+ */
+
+#include "zwidget/core/mapped_file.hpp"
+#include "zwidget/render/context.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief A glyph bitmap read back from the cache; coverage stays valid for the cache's lifetime
+ */
+struct CachedGlyph {
+    int16_t left = 0;
+    int16_t top = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    const uint8_t* coverage = nullptr;  // width x height, row-major
+};
+
+/**
+ * @brief Counters, cumulative since the cache was opened
+ */
+struct TextCacheStats {
+    size_t loaded = 0;         // Records indexed from the file
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t stored = 0;         // Records added this run
+    size_t rejected = 0;       // Records not added: the size limit was reached
+    size_t written = 0;        // Of those, appended to the file
+    size_t corrupt = 0;        // Records that failed their checksum
+    bool persistent = false;   // False when the file could not be used
+    bool discarded = false;    // An existing file was stale
+    bool repaired = false;     // An existing file had a torn tail, which was cut off
+};
+
+/**
+ * @brief Memory-mapped, append-only store of advances and glyph bitmaps - thread-safe
+ */
+class TextCacheFile {
+public:
+    static constexpr uint32_t format_version = 1;
+    static constexpr size_t default_max_bytes = size_t{32} << 20;
+
+private:
+    enum class Kind : uint32_t {
+        advances = 1,
+        glyph = 2,
+        extent = 3,
+    };
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t byte_order;   // 0x01020304 as written
+        uint32_t wchar_size;
+        uint64_t identity;
+    };
+
+    struct RecordHeader {
+        uint32_t kind;
+        uint32_t size;         // Payload bytes
+        uint64_t key;
+        uint32_t checksum;     // FNV-1a of the payload
+        uint32_t reserved;
+    };
+
+    struct Slot {
+        const uint8_t* record;  // Header followed by payload, in the map or in pending_
+        bool verified;
+    };
+
+    std::string path_;
+    uint64_t identity_;
+    size_t max_bytes_;
+    MappedFile file_;
+    size_t file_bytes_ = 0;
+    std::unordered_map<uint64_t, Slot> index_;
+    std::deque<std::vector<uint8_t>> pending_;  // Records added this run; never moved
+    size_t pending_bytes_ = 0;
+    size_t unwritten_ = 0;                      // Trailing entries of pending_ not yet on disk
+    TextCacheStats stats_;
+    mutable std::mutex mutex_;
+
+    // === Hashing ===
+
+    static uint32_t fnv32(const uint8_t* data, size_t bytes) {
+        uint32_t h = 0x811c9dc5u;
+        for (size_t i = 0; i < bytes; ++i) {
+            h ^= data[i];
+            h *= 0x01000193u;
+        }
+        return h;
+    }
+
+    template <typename T>
+    static T read(const uint8_t*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    static void write(std::vector<uint8_t>& out, const T& value) {
+        const auto* p = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+
+    static void write_bytes(std::vector<uint8_t>& out, const void* data, size_t bytes) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), p, p + bytes);
+    }
+
+    static uint32_t style_flags(const TextStyle& style) {
+        return (style.bold ? 1u : 0u) | (style.italic ? 2u : 0u);
+    }
+
+    static uint64_t text_key(std::wstring_view text, const TextStyle& style, Kind kind) {
+        std::wstring_view family = style.font_family.name();
+        uint32_t flags = style_flags(style);
+        uint64_t h = hash(&style.font_size, sizeof(float));
+        h = hash(&flags, sizeof(flags), h);
+        h = hash(family.data(), family.size() * sizeof(wchar_t), h);
+        h = hash(text.data(), text.size() * sizeof(wchar_t), h);
+        return h ^ static_cast<uint64_t>(kind);
+    }
+
+    /**
+     * @brief Whether the family and text a record was made from, at p, are the request's
+     * The key is a hash, so a hit must confirm them. left is the payload size
+     * from p on, tail the bytes expected after the text. Skips past them if so.
+     */
+    static bool same_text(const uint8_t*& p, size_t left, size_t tail,
+                          std::wstring_view text, const TextStyle& style) {
+        std::wstring_view family = style.font_family.name();
+        if (left < 2 * sizeof(uint32_t)) return false;
+        uint32_t family_units = read<uint32_t>(p);
+        uint32_t text_units = read<uint32_t>(p);
+        if (family_units != family.size() || text_units != text.size() ||
+            left != 2 * sizeof(uint32_t) + (family.size() + text.size()) * sizeof(wchar_t) + tail ||
+            std::memcmp(p, family.data(), family.size() * sizeof(wchar_t)) != 0 ||
+            std::memcmp(p + family.size() * sizeof(wchar_t), text.data(), text.size() * sizeof(wchar_t)) != 0) {
+            return false;
+        }
+        p += (family.size() + text.size()) * sizeof(wchar_t);
+        return true;
+    }
+
+    static void write_text(std::vector<uint8_t>& out, std::wstring_view text, const TextStyle& style) {
+        std::wstring_view family = style.font_family.name();
+        write(out, static_cast<uint32_t>(family.size()));
+        write(out, static_cast<uint32_t>(text.size()));
+        write_bytes(out, family.data(), family.size() * sizeof(wchar_t));
+        write_bytes(out, text.data(), text.size() * sizeof(wchar_t));
+    }
+
+    static uint64_t glyph_key(uint64_t font, uint16_t glyph, uint16_t size, uint8_t subpixel) {
+        uint64_t fields[2] = {font, static_cast<uint64_t>(glyph) << 24 | static_cast<uint64_t>(size) << 8 | subpixel};
+        return hash(fields, sizeof(fields)) ^ static_cast<uint64_t>(Kind::glyph);
+    }
+
+    // === Loading ===
+
+    FileHeader expected_header() const {
+        FileHeader header{{'Z', 'W', 'T', 'C'}, format_version, 0x01020304u,
+                          static_cast<uint32_t>(sizeof(wchar_t)), identity_};
+        return header;
+    }
+
+    /**
+     * @brief Index the whole records; bytes they and the header span, or 0 if the file is stale
+     */
+    size_t load() {
+        const uint8_t* data = file_.data();
+        size_t size = file_.size();
+        if (size < sizeof(FileHeader)) return 0;
+
+        FileHeader expected = expected_header();
+        if (std::memcmp(data, &expected, sizeof(FileHeader)) != 0) return 0;
+
+        size_t at = sizeof(FileHeader);
+        while (size - at >= sizeof(RecordHeader)) {
+            RecordHeader header;
+            std::memcpy(&header, data + at, sizeof(header));
+            if (header.size > size - at - sizeof(RecordHeader)) break;
+            index_[header.key] = Slot{data + at, false};
+            at += sizeof(RecordHeader) + header.size;
+            stats_.loaded++;
+        }
+        return at;
+    }
+
+    /**
+     * @brief Map the file and index it, cutting off a torn tail; false if it is stale
+     */
+    bool open_existing() {
+        try {
+            file_ = MappedFile(path_);
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+        if (file_.empty()) return false;
+
+        size_t valid = load();
+        if (valid == 0) return false;
+        if (valid < file_.size()) {
+            // Appends must follow the last whole record; the map is closed while resizing
+            index_.clear();
+            stats_.loaded = 0;
+            file_ = MappedFile();
+            std::error_code error;
+            std::filesystem::resize_file(path_, valid, error);
+            if (error) return false;
+            try {
+                file_ = MappedFile(path_);
+            } catch (const std::runtime_error&) {
+                return false;
+            }
+            if (load() != file_.size()) return false;
+            stats_.repaired = true;
+        }
+        file_bytes_ = file_.size();
+        return true;
+    }
+
+    /**
+     * @brief Start an empty file; false if it cannot be written
+     */
+    bool reset_file() {
+        index_.clear();
+        stats_.loaded = 0;
+        file_ = MappedFile();
+
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        FileHeader header = expected_header();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file_bytes_ = sizeof(header);
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Payload of a slot after a lazy checksum check, or nullptr
+     */
+    const uint8_t* payload(Slot& slot, Kind kind, uint32_t& size) {
+        RecordHeader header;
+        std::memcpy(&header, slot.record, sizeof(header));
+        const uint8_t* data = slot.record + sizeof(RecordHeader);
+        if (header.kind != static_cast<uint32_t>(kind)) return nullptr;
+        if (!slot.verified) {
+            if (fnv32(data, header.size) != header.checksum) {
+                stats_.corrupt++;
+                return nullptr;
+            }
+            slot.verified = true;
+        }
+        size = header.size;
+        return data;
+    }
+
+    void add(Kind kind, uint64_t key, std::vector<uint8_t>&& record) {
+        // What was loaded plus everything added, written or not: bounds both the file and memory
+        if (file_.size() + pending_bytes_ + record.size() > max_bytes_) {
+            stats_.rejected++;
+            return;
+        }
+
+        RecordHeader header{static_cast<uint32_t>(kind),
+                            static_cast<uint32_t>(record.size() - sizeof(RecordHeader)), key, 0, 0};
+        header.checksum = fnv32(record.data() + sizeof(RecordHeader), header.size);
+        std::memcpy(record.data(), &header, sizeof(header));
+
+        pending_bytes_ += record.size();
+        pending_.push_back(std::move(record));
+        unwritten_++;
+        index_[key] = Slot{pending_.back().data(), true};
+        stats_.stored++;
+    }
+
+public:
+    /**
+     * @param path Cache file; created if missing
+     * @param identity Everything the cached results depend on (fonts, backend, app version);
+     *        a file written under another identity is discarded
+     * @param max_bytes Limit on the file plus the records added this run
+     */
+    TextCacheFile(std::string path, uint64_t identity, size_t max_bytes = default_max_bytes)
+        : path_(std::move(path)), identity_(identity), max_bytes_(max_bytes) {
+        std::error_code error;
+        if (std::filesystem::exists(path_, error)) {
+            if (open_existing()) {
+                stats_.persistent = true;
+                return;
+            }
+            stats_.discarded = true;
+        }
+        stats_.persistent = reset_file();
+    }
+
+    ~TextCacheFile() { flush(); }
+
+    TextCacheFile(const TextCacheFile&) = delete;
+    TextCacheFile& operator=(const TextCacheFile&) = delete;
+
+    // === Identity ===
+
+    /**
+     * @brief FNV-1a: stable across runs and platforms, unlike std::hash
+     */
+    static uint64_t hash(const void* data, size_t bytes, uint64_t h = 0xcbf29ce484222325ull) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < bytes; ++i) {
+            h ^= p[i];
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Identity of a file from its size and modification time, for fonts the
+     * cache cannot open itself (e.g. system fonts behind DirectWrite)
+     */
+    static uint64_t file_identity(const std::filesystem::path& path) {
+        std::error_code error;
+        uint64_t fields[2] = {
+            static_cast<uint64_t>(std::filesystem::file_size(path, error)),
+            static_cast<uint64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count()),
+        };
+        return hash(fields, sizeof(fields));
+    }
+
+    /**
+     * @brief Combine identities, e.g. of several fonts
+     */
+    static uint64_t combine(uint64_t identity, uint64_t other) {
+        return hash(&other, sizeof(other), identity);
+    }
+
+    // === Measurements ===
+
+    /**
+     * @brief Advances and line height as TextShaper got them from the backend
+     */
+    bool find_advances(std::wstring_view text, const TextStyle& style,
+                       std::vector<float>& advances, float& line_height) {
+        std::lock_guard lock(mutex_);
+
+        auto it = index_.find(text_key(text, style, Kind::advances));
+        uint32_t size = 0;
+        const uint8_t* p = it == index_.end() ? nullptr : payload(it->second, Kind::advances, size);
+        if (!p || size < 3 * sizeof(uint32_t)) {
+            stats_.misses++;
+            return false;
+        }
+
+        float font_size = read<float>(p);
+        uint32_t flags = read<uint32_t>(p);
+        float height = read<float>(p);
+        if (font_size != style.font_size || flags != style_flags(style) ||
+            !same_text(p, size - 3 * sizeof(uint32_t), text.size() * sizeof(float), text, style)) {
+            stats_.misses++;
+            return false;
+        }
+
+        advances.resize(text.size());
+        std::memcpy(advances.data(), p, text.size() * sizeof(float));
+        line_height = height;
+        stats_.hits++;
+        return true;
+    }
+
+    void store_advances(std::wstring_view text, const TextStyle& style,
+                        const std::vector<float>& advances, float line_height) {
+        if (advances.size() != text.size()) return;
+        std::wstring_view family = style.font_family.name();
+
+        std::vector<uint8_t> record(sizeof(RecordHeader));
+        record.reserve(sizeof(RecordHeader) + 20 + (family.size() + text.size()) * sizeof(wchar_t) +
+                       advances.size() * sizeof(float));
+        write(record, style.font_size);
+        write(record, style_flags(style));
+        write(record, line_height);
+        write_text(record, text, style);
+        write_bytes(record, advances.data(), advances.size() * sizeof(float));
+
+        std::lock_guard lock(mutex_);
+        add(Kind::advances, text_key(text, style, Kind::advances), std::move(record));
+    }
+
+    /**
+     * @brief Size of a caption as RenderContext::measure_text() gave it
+     */
+    std::optional<Sizef> find_extent(std::wstring_view text, const TextStyle& style) {
+        std::lock_guard lock(mutex_);
+
+        auto it = index_.find(text_key(text, style, Kind::extent));
+        uint32_t size = 0;
+        const uint8_t* p = it == index_.end() ? nullptr : payload(it->second, Kind::extent, size);
+        if (!p || size < 4 * sizeof(uint32_t)) {
+            stats_.misses++;
+            return std::nullopt;
+        }
+
+        float font_size = read<float>(p);
+        uint32_t flags = read<uint32_t>(p);
+        Sizef extent;
+        extent.w = read<float>(p);
+        extent.h = read<float>(p);
+        if (font_size != style.font_size || flags != style_flags(style) ||
+            !same_text(p, size - 4 * sizeof(uint32_t), 0, text, style)) {
+            stats_.misses++;
+            return std::nullopt;
+        }
+        stats_.hits++;
+        return extent;
+    }
+
+    void store_extent(std::wstring_view text, const TextStyle& style, const Sizef& extent) {
+        std::vector<uint8_t> record(sizeof(RecordHeader));
+        write(record, style.font_size);
+        write(record, style_flags(style));
+        write(record, extent.w);
+        write(record, extent.h);
+        write_text(record, text, style);
+
+        std::lock_guard lock(mutex_);
+        add(Kind::extent, text_key(text, style, Kind::extent), std::move(record));
+    }
+
+    // === Glyphs ===
+
+    /**
+     * @param font TrueTypeFont::identity() of the face
+     * @param size Em size in quarter pixels
+     */
+    std::optional<CachedGlyph> find_glyph(uint64_t font, uint16_t glyph, uint16_t size, uint8_t subpixel) {
+        std::lock_guard lock(mutex_);
+
+        auto it = index_.find(glyph_key(font, glyph, size, subpixel));
+        uint32_t bytes = 0;
+        const uint8_t* p = it == index_.end() ? nullptr : payload(it->second, Kind::glyph, bytes);
+        if (!p || bytes < 22) {
+            stats_.misses++;
+            return std::nullopt;
+        }
+
+        uint64_t stored_font = read<uint64_t>(p);
+        uint16_t stored_glyph = read<uint16_t>(p);
+        uint16_t stored_size = read<uint16_t>(p);
+        uint8_t stored_subpixel = read<uint8_t>(p);
+        p += 1;
+        CachedGlyph out;
+        out.left = read<int16_t>(p);
+        out.top = read<int16_t>(p);
+        out.width = read<uint16_t>(p);
+        out.height = read<uint16_t>(p);
+        out.coverage = p;
+        if (stored_font != font || stored_glyph != glyph || stored_size != size || stored_subpixel != subpixel ||
+            bytes != 22 + size_t{out.width} * out.height) {
+            stats_.misses++;
+            return std::nullopt;
+        }
+        stats_.hits++;
+        return out;
+    }
+
+    void store_glyph(uint64_t font, uint16_t glyph, uint16_t size, uint8_t subpixel,
+                     const CachedGlyph& bitmap, size_t coverage_stride) {
+        std::vector<uint8_t> record(sizeof(RecordHeader));
+        record.reserve(sizeof(RecordHeader) + 22 + size_t{bitmap.width} * bitmap.height);
+        write(record, font);
+        write(record, glyph);
+        write(record, size);
+        write(record, subpixel);
+        write(record, uint8_t{0});
+        write(record, bitmap.left);
+        write(record, bitmap.top);
+        write(record, bitmap.width);
+        write(record, bitmap.height);
+        for (uint16_t y = 0; y < bitmap.height; ++y) {
+            write_bytes(record, bitmap.coverage + y * coverage_stride, bitmap.width);
+        }
+
+        std::lock_guard lock(mutex_);
+        add(Kind::glyph, glyph_key(font, glyph, size, subpixel), std::move(record));
+    }
+
+    // === Write-back ===
+
+    /**
+     * @brief Append records added since the last flush; cheap when there are none
+     */
+    void flush() {
+        std::lock_guard lock(mutex_);
+        if (!stats_.persistent || unwritten_ == 0) return;
+
+        std::ofstream out(path_, std::ios::binary | std::ios::app);
+        for (size_t i = pending_.size() - unwritten_; i < pending_.size(); ++i) {
+            const auto& record = pending_[i];
+            if (file_bytes_ + record.size() > max_bytes_) break;
+            out.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+            file_bytes_ += record.size();
+            stats_.written++;
+        }
+        unwritten_ = 0;
+        if (!out) stats_.persistent = false;
+    }
+
+    TextCacheStats stats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+    const std::string& path() const { return path_; }
+};
+
+} // namespace zuu::widget
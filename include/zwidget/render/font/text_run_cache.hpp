@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file text_run_cache.hpp
+ * @brief Cache of fully rendered text runs under a memory budget
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Most UI text is static: captions and headings drawn identically
+ * every frame. A run caches one line of text as a single coverage bitmap at
+ * a given style and pixel size, so redrawing it is one hash lookup and one
+ * blit instead of a cmap lookup, an atlas lookup and a blit per glyph. Runs
+ * hold coverage only and are tinted when blitted, so the same caption in
+ * another color shares the entry. Only the inputs of the bitmap are keyed:
+ * font family, bold, italic and em size, so alignment and decorations do
+ * not split entries either. Least recently used runs are dropped when
+ * the byte budget is exceeded.
+ */
+
+#include "zwidget/render/context.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief One line of text rendered to 8-bit coverage
+ * The bitmap's top-left is at (pen x + left, baseline + top) in device pixels.
+ */
+struct TextRun {
+    int left = 0;
+    int top = 0;
+    int width = 0;
+    int height = 0;
+    float advance = 0.0f;           // Pen advance in device pixels
+    std::vector<uint8_t> coverage;  // width x height, row-major
+
+    size_t bytes() const { return coverage.capacity(); }
+};
+
+/**
+ * @brief Counters for sizing the cache
+ */
+struct TextRunStats {
+    size_t runs = 0;
+    size_t bytes = 0;          // Bitmaps, strings and bookkeeping
+    size_t budget = 0;
+    size_t hits = 0;
+    size_t misses = 0;         // Runs rendered
+    size_t hits_frame = 0;     // Since begin_frame()
+    size_t misses_frame = 0;
+    size_t evicted = 0;
+};
+
+/**
+ * @brief LRU cache of TextRuns keyed by (text, face, em size)
+ */
+class TextRunCache {
+private:
+    /**
+     * @brief The part of a TextStyle that changes the rendered coverage
+     */
+    struct Face {
+        FontFamily family;
+        bool bold = false;
+        bool italic = false;
+
+        explicit Face(const TextStyle& style)
+            : family(style.font_family), bold(style.bold), italic(style.italic) {}
+
+        bool operator==(const Face&) const = default;
+    };
+
+    struct Entry {
+        std::wstring text;
+        Face face;
+        uint16_t size;  // Em size in quarter pixels
+        TextRun run;
+    };
+
+    struct KeyView {
+        std::wstring_view text;
+        Face face;
+        uint16_t size;
+    };
+
+    struct KeyHash {
+        size_t operator()(const KeyView& k) const {
+            size_t h = std::hash<std::wstring_view>{}(k.text);
+            size_t flags = (k.face.bold ? 1u : 0u) | (k.face.italic ? 2u : 0u) | (size_t{k.size} << 2);
+            h ^= k.face.family.hash() + 0x9e3779b9u + (h << 6) + (h >> 2);
+            h ^= flags + 0x9e3779b9u + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    struct KeyEqual {
+        bool operator()(const KeyView& a, const KeyView& b) const {
+            return a.size == b.size && a.face == b.face && a.text == b.text;
+        }
+    };
+
+    // Approximate per-entry overhead of the list and map nodes
+    static constexpr size_t entry_overhead = sizeof(Entry) + 64;
+
+    std::list<Entry> entries_;  // Most recently used first; keys point into these nodes
+    std::unordered_map<KeyView, std::list<Entry>::iterator, KeyHash, KeyEqual> index_;
+    size_t bytes_ = 0;
+    size_t budget_;
+    TextRunStats stats_;
+
+    static size_t entry_bytes(const Entry& e) {
+        return entry_overhead + e.text.capacity() * sizeof(wchar_t) + e.run.bytes();
+    }
+
+    void trim(size_t budget) {
+        while (bytes_ > budget && !entries_.empty()) {
+            Entry& last = entries_.back();
+            index_.erase(KeyView{last.text, last.face, last.size});
+            bytes_ -= entry_bytes(last);
+            entries_.pop_back();
+            stats_.evicted++;
+        }
+    }
+
+public:
+    explicit TextRunCache(size_t budget_bytes = size_t{8} << 20) : budget_(budget_bytes) {}
+
+    TextRunCache(const TextRunCache&) = delete;
+    TextRunCache& operator=(const TextRunCache&) = delete;
+
+    /**
+     * @brief Cached run, marked most recently used; nullptr on a miss
+     */
+    const TextRun* find(std::wstring_view text, const TextStyle& style, uint16_t size) {
+        auto it = index_.find(KeyView{text, Face(style), size});
+        if (it == index_.end()) return nullptr;
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+        stats_.hits++;
+        stats_.hits_frame++;
+        return &it->second->run;
+    }
+
+    /**
+     * @brief Store a freshly rendered run, evicting old ones to stay in budget
+     * @return The stored run, or nullptr if it alone exceeds the budget
+     *         (run is then left untouched)
+     */
+    const TextRun* insert(std::wstring_view text, const TextStyle& style, uint16_t size, TextRun& run) {
+        stats_.misses++;
+        stats_.misses_frame++;
+
+        size_t needed = entry_overhead + text.size() * sizeof(wchar_t) + run.bytes();
+        if (needed > budget_) return nullptr;
+        trim(budget_ - needed);
+
+        entries_.push_front(Entry{std::wstring(text), Face(style), size, std::move(run)});
+        Entry& e = entries_.front();
+        index_.emplace(KeyView{e.text, e.face, e.size}, entries_.begin());
+        bytes_ += entry_bytes(e);
+        return &e.run;
+    }
+
+    /**
+     * @brief Drop every run, e.g. after a DPI or font change
+     */
+    void clear() {
+        index_.clear();
+        entries_.clear();
+        bytes_ = 0;
+    }
+
+    /**
+     * @brief Change the budget; 0 disables caching
+     */
+    void set_budget(size_t bytes) {
+        budget_ = bytes;
+        trim(budget_);
+    }
+
+    size_t budget() const { return budget_; }
+
+    void begin_frame() {
+        stats_.hits_frame = 0;
+        stats_.misses_frame = 0;
+    }
+
+    TextRunStats stats() const {
+        TextRunStats stats = stats_;
+        stats.runs = entries_.size();
+        stats.bytes = bytes_;
+        stats.budget = budget_;
+        return stats;
+    }
+};
+
+} // namespace zuu::widget
@@ -0,0 +1,398 @@
+#pragma once
+
+/**
+ * @file true_type.hpp
+ * @brief Minimal TrueType/OpenType reader: character map, metrics, glyph outlines
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details The font is read in place from a memory-mapped file: opening only
+ * locates the tables, and each lookup reads the few bytes it needs. Outlines
+ * come from the 'glyf' table (simple and composite glyphs, quadratic
+ * curves); fonts with CFF outlines are rejected. No shaping beyond the
+ * character map and horizontal advances: no kerning or ligatures.
+ */
+
+#include "zwidget/core/mapped_file.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Glyph outline in font units, y up
+ * Each contour is a closed list of points; off-curve points are quadratic
+ * control points, with the implied on-curve midpoints already inserted.
+ */
+struct GlyphOutline {
+    struct Point {
+        float x;
+        float y;
+        bool on_curve;
+    };
+
+    std::vector<Point> points;
+    std::vector<uint32_t> contour_ends;  // One past the last point of each contour
+
+    bool empty() const { return contour_ends.empty(); }
+};
+
+/**
+ * @brief Horizontal metrics of one glyph, in font units
+ */
+struct GlyphMetrics {
+    uint16_t advance = 0;
+    int16_t left_bearing = 0;
+};
+
+/**
+ * @brief One face of a .ttf/.otf/.ttc file; throws std::runtime_error if unusable
+ */
+class TrueTypeFont {
+private:
+    std::shared_ptr<const MappedFile> file_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+    uint32_t glyf_ = 0;
+    uint32_t loca_ = 0;
+    uint32_t hmtx_ = 0;
+    uint32_t cmap_ = 0;          // Chosen subtable
+    uint16_t cmap_format_ = 0;
+    uint16_t units_per_em_ = 1000;
+    uint16_t glyph_count_ = 0;
+    uint16_t hmetric_count_ = 0;
+    int16_t ascent_ = 0;
+    int16_t descent_ = 0;
+    int16_t line_gap_ = 0;
+    bool long_loca_ = false;
+    uint64_t identity_ = 0;
+
+    // === Big-endian reads, bounds-checked ===
+
+    bool has(size_t offset, size_t bytes) const { return offset <= size_ && bytes <= size_ - offset; }
+
+    uint8_t u8(size_t offset) const { return has(offset, 1) ? data_[offset] : 0; }
+    uint16_t u16(size_t offset) const {
+        return has(offset, 2) ? static_cast<uint16_t>(data_[offset] << 8 | data_[offset + 1]) : 0;
+    }
+    int16_t i16(size_t offset) const { return static_cast<int16_t>(u16(offset)); }
+    uint32_t u32(size_t offset) const {
+        return has(offset, 4) ? (static_cast<uint32_t>(u16(offset)) << 16) | u16(offset + 2) : 0;
+    }
+
+    static constexpr uint32_t tag(const char (&t)[5]) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(t[0])) << 24 |
+               static_cast<uint32_t>(static_cast<uint8_t>(t[1])) << 16 |
+               static_cast<uint32_t>(static_cast<uint8_t>(t[2])) << 8 |
+               static_cast<uint32_t>(static_cast<uint8_t>(t[3]));
+    }
+
+    uint32_t find_table(uint32_t face, uint32_t name) const {
+        uint16_t count = u16(face + 4);
+        for (uint16_t i = 0; i < count; ++i) {
+            size_t record = face + 12 + size_t{16} * i;
+            if (u32(record) == name) {
+                uint32_t offset = u32(record + 8);
+                return has(offset, u32(record + 12)) ? offset : 0;
+            }
+        }
+        return 0;
+    }
+
+    void open(uint32_t index) {
+        uint32_t face = 0;
+        if (u32(0) == tag("ttcf")) {
+            if (index >= u32(8)) throw std::runtime_error("Font collection has no face " + std::to_string(index));
+            face = u32(12 + size_t{4} * index);
+        }
+
+        uint32_t head = find_table(face, tag("head"));
+        uint32_t hhea = find_table(face, tag("hhea"));
+        uint32_t maxp = find_table(face, tag("maxp"));
+        cmap_ = find_table(face, tag("cmap"));
+        hmtx_ = find_table(face, tag("hmtx"));
+        glyf_ = find_table(face, tag("glyf"));
+        loca_ = find_table(face, tag("loca"));
+
+        if (!glyf_ && find_table(face, tag("CFF "))) {
+            throw std::runtime_error("CFF outlines are not supported");
+        }
+        if (!head || !hhea || !maxp || !cmap_ || !hmtx_ || !glyf_ || !loca_) {
+            throw std::runtime_error("Not a TrueType font or missing tables");
+        }
+
+        units_per_em_ = std::max<uint16_t>(u16(head + 18), 1);
+        long_loca_ = i16(head + 50) != 0;
+        glyph_count_ = u16(maxp + 4);
+        ascent_ = i16(hhea + 4);
+        descent_ = i16(hhea + 6);
+        line_gap_ = i16(hhea + 8);
+        hmetric_count_ = std::max<uint16_t>(u16(hhea + 34), 1);
+        choose_cmap();
+
+        // The head table carries the font revision, dates and whole-file checksum
+        identity_ = 0xcbf29ce484222325ull;
+        auto mix = [this](uint64_t value) {
+            identity_ ^= value;
+            identity_ *= 0x100000001b3ull;
+        };
+        for (size_t i = 0; i < 54; ++i) mix(u8(head + i));
+        mix(index);
+        mix(size_);
+    }
+
+    /**
+     * @brief Prefer full Unicode (format 12), then the BMP (format 4)
+     */
+    void choose_cmap() {
+        uint32_t table = cmap_;
+        uint16_t count = u16(table + 2);
+        uint32_t bmp = 0;
+        uint32_t full = 0;
+        for (uint16_t i = 0; i < count; ++i) {
+            size_t record = table + 4 + size_t{8} * i;
+            uint16_t platform = u16(record);
+            uint16_t encoding = u16(record + 2);
+            uint32_t sub = table + u32(record + 4);
+            bool unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+            if (!unicode) continue;
+
+            uint16_t format = u16(sub);
+            if (format == 12) full = sub;
+            else if (format == 4) bmp = sub;
+        }
+        cmap_ = full ? full : bmp;
+        cmap_format_ = cmap_ ? u16(cmap_) : 0;
+        if (!cmap_) throw std::runtime_error("Font has no Unicode character map");
+    }
+
+    uint32_t glyph_offset(uint16_t glyph, uint32_t& length) const {
+        uint32_t begin;
+        uint32_t end;
+        if (long_loca_) {
+            begin = u32(loca_ + size_t{4} * glyph);
+            end = u32(loca_ + size_t{4} * glyph + 4);
+        } else {
+            begin = uint32_t{u16(loca_ + size_t{2} * glyph)} * 2;
+            end = uint32_t{u16(loca_ + size_t{2} * glyph + 2)} * 2;
+        }
+        length = end > begin ? end - begin : 0;
+        return glyf_ + begin;
+    }
+
+    void append_simple(uint32_t at, int16_t contours, GlyphOutline& out, const float (&m)[6]) const {
+        size_t ends = at + 10;
+        uint16_t point_count = static_cast<uint16_t>(u16(ends + size_t{2} * (contours - 1)) + 1);
+        size_t p = ends + size_t{2} * contours;
+        p += 2 + u16(p);  // Skip instructions
+
+        // Flags, with run-length repeats
+        std::vector<uint8_t> flags(point_count);
+        for (uint16_t i = 0; i < point_count;) {
+            uint8_t flag = u8(p++);
+            flags[i++] = flag;
+            if (flag & 8) {
+                for (uint8_t r = u8(p++); r > 0 && i < point_count; --r) flags[i++] = flag;
+            }
+        }
+
+        std::vector<int32_t> xs(point_count);
+        std::vector<int32_t> ys(point_count);
+        int32_t v = 0;
+        for (uint16_t i = 0; i < point_count; ++i) {
+            uint8_t f = flags[i];
+            if (f & 2) { v += (f & 16) ? u8(p) : -int32_t{u8(p)}; p += 1; }
+            else if (!(f & 16)) { v += i16(p); p += 2; }
+            xs[i] = v;
+        }
+        v = 0;
+        for (uint16_t i = 0; i < point_count; ++i) {
+            uint8_t f = flags[i];
+            if (f & 4) { v += (f & 32) ? u8(p) : -int32_t{u8(p)}; p += 1; }
+            else if (!(f & 32)) { v += i16(p); p += 2; }
+            ys[i] = v;
+        }
+
+        auto transformed = [&](uint16_t i, bool on) {
+            float x = static_cast<float>(xs[i]);
+            float y = static_cast<float>(ys[i]);
+            return GlyphOutline::Point{m[0] * x + m[2] * y + m[4], m[1] * x + m[3] * y + m[5], on};
+        };
+
+        uint16_t first = 0;
+        for (int16_t c = 0; c < contours; ++c) {
+            uint16_t last = u16(ends + size_t{2} * c);
+            if (last < first || last >= point_count) break;
+
+            size_t begin = out.points.size();
+            for (uint16_t i = first; i <= last; ++i) {
+                bool on = flags[i] & 1;
+                uint16_t next = i == last ? first : static_cast<uint16_t>(i + 1);
+                out.points.push_back(transformed(i, on));
+                // Two off-curve points in a row imply an on-curve point between them
+                if (!on && !(flags[next] & 1)) {
+                    auto a = out.points.back();
+                    auto b = transformed(next, false);
+                    out.points.push_back({(a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f, true});
+                }
+            }
+            // Start the contour on an on-curve point
+            auto start = std::find_if(out.points.begin() + static_cast<ptrdiff_t>(begin), out.points.end(),
+                                      [](const GlyphOutline::Point& pt) { return pt.on_curve; });
+            std::rotate(out.points.begin() + static_cast<ptrdiff_t>(begin), start, out.points.end());
+            out.contour_ends.push_back(static_cast<uint32_t>(out.points.size()));
+            first = static_cast<uint16_t>(last + 1);
+        }
+    }
+
+    void append(uint16_t glyph, GlyphOutline& out, const float (&m)[6], int depth) const {
+        if (glyph >= glyph_count_ || depth > 8) return;
+
+        uint32_t length;
+        uint32_t at = glyph_offset(glyph, length);
+        if (length < 10 || !has(at, length)) return;
+
+        int16_t contours = i16(at);
+        if (contours > 0) {
+            append_simple(at, contours, out, m);
+            return;
+        }
+
+        // Composite: components with an offset and an optional 2x2 transform
+        size_t p = at + 10;
+        for (;;) {
+            uint16_t flags = u16(p);
+            uint16_t component = u16(p + 2);
+            p += 4;
+
+            float dx = 0.0f;
+            float dy = 0.0f;
+            if (flags & 1) {
+                if (flags & 2) { dx = i16(p); dy = i16(p + 2); }
+                p += 4;
+            } else {
+                if (flags & 2) { dx = static_cast<int8_t>(u8(p)); dy = static_cast<int8_t>(u8(p + 1)); }
+                p += 2;
+            }
+
+            auto f2dot14 = [this](size_t offset) { return static_cast<float>(i16(offset)) / 16384.0f; };
+            float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f;
+            if (flags & 8) { a = d = f2dot14(p); p += 2; }
+            else if (flags & 0x40) { a = f2dot14(p); d = f2dot14(p + 2); p += 4; }
+            else if (flags & 0x80) { a = f2dot14(p); b = f2dot14(p + 2); c = f2dot14(p + 4); d = f2dot14(p + 6); p += 8; }
+
+            // Compose with the parent transform: parent * component
+            float child[6] = {
+                m[0] * a + m[2] * b, m[1] * a + m[3] * b,
+                m[0] * c + m[2] * d, m[1] * c + m[3] * d,
+                m[0] * dx + m[2] * dy + m[4], m[1] * dx + m[3] * dy + m[5],
+            };
+            append(component, out, child, depth + 1);
+
+            if (!(flags & 0x20)) break;
+        }
+    }
+
+public:
+    /**
+     * @param index Face within a .ttc collection
+     */
+    explicit TrueTypeFont(std::shared_ptr<const MappedFile> file, uint32_t index = 0)
+        : file_(std::move(file)), data_(file_->data()), size_(file_->size()) {
+        open(index);
+    }
+
+    static std::shared_ptr<TrueTypeFont> load(const std::string& path, uint32_t index = 0) {
+        return std::make_shared<TrueTypeFont>(std::make_shared<const MappedFile>(path), index);
+    }
+
+    // === Lookup ===
+
+    /**
+     * @brief Glyph for a code point, 0 (.notdef) if the font has none
+     */
+    uint16_t glyph_index(char32_t code) const {
+        if (cmap_format_ == 12) {
+            uint32_t groups = u32(cmap_ + 12);
+            uint32_t lo = 0, hi = groups;
+            while (lo < hi) {
+                uint32_t mid = (lo + hi) / 2;
+                size_t group = cmap_ + 16 + size_t{12} * mid;
+                if (code < u32(group)) hi = mid;
+                else if (code > u32(group + 4)) lo = mid + 1;
+                else return static_cast<uint16_t>(u32(group + 8) + (code - u32(group)));
+            }
+            return 0;
+        }
+
+        if (code > 0xFFFF) return 0;
+        uint16_t segments = u16(cmap_ + 6) / 2;
+        size_t ends = cmap_ + 14;
+        size_t starts = ends + size_t{2} * segments + 2;
+        size_t deltas = starts + size_t{2} * segments;
+        size_t ranges = deltas + size_t{2} * segments;
+
+        uint16_t lo = 0, hi = segments;
+        while (lo < hi) {
+            uint16_t mid = static_cast<uint16_t>((lo + hi) / 2);
+            if (code > u16(ends + size_t{2} * mid)) lo = static_cast<uint16_t>(mid + 1);
+            else hi = mid;
+        }
+        if (lo >= segments) return 0;
+
+        uint16_t start = u16(starts + size_t{2} * lo);
+        if (code < start) return 0;
+        uint16_t delta = u16(deltas + size_t{2} * lo);
+        uint16_t range = u16(ranges + size_t{2} * lo);
+        if (range == 0) return static_cast<uint16_t>(code + delta);
+
+        size_t at = ranges + size_t{2} * lo + range + size_t{2} * (code - start);
+        uint16_t glyph = u16(at);
+        return glyph ? static_cast<uint16_t>(glyph + delta) : 0;
+    }
+
+    GlyphMetrics metrics(uint16_t glyph) const {
+        if (glyph < hmetric_count_) {
+            return GlyphMetrics{u16(hmtx_ + size_t{4} * glyph), i16(hmtx_ + size_t{4} * glyph + 2)};
+        }
+        // Monospaced tail: the last advance repeats, bearings follow the long entries
+        size_t bearings = hmtx_ + size_t{4} * hmetric_count_;
+        return GlyphMetrics{u16(hmtx_ + size_t{4} * (hmetric_count_ - 1)),
+                            i16(bearings + size_t{2} * (glyph - hmetric_count_))};
+    }
+
+    /**
+     * @brief Outline in font units; empty for blank glyphs such as space
+     */
+    GlyphOutline outline(uint16_t glyph) const {
+        GlyphOutline out;
+        static constexpr float identity[6] = {1, 0, 0, 1, 0, 0};
+        append(glyph, out, identity, 0);
+        return out;
+    }
+
+    // === Face metrics ===
+
+    uint16_t units_per_em() const { return units_per_em_; }
+    uint16_t glyph_count() const { return glyph_count_; }
+    int16_t ascent() const { return ascent_; }
+    int16_t descent() const { return descent_; }   // Negative: below the baseline
+    int16_t line_gap() const { return line_gap_; }
+
+    /**
+     * @brief Stable across runs for the same font file and face; keys persistent caches
+     */
+    uint64_t identity() const { return identity_; }
+
+    /**
+     * @brief Pixels per font unit for an em size in pixels
+     */
+    float scale(float em_pixels) const { return em_pixels / static_cast<float>(units_per_em_); }
+};
+
+} // namespace zuu::widget
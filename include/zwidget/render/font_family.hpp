@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file font_family.hpp
+ * @brief Interned font family names (atoms)
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace zuu::widget {
+
+/**
+ * @brief Font family atom - one shared entry per distinct name
+ * Copies are a single pointer; equality and hashing never touch the string.
+ * Atoms live for the rest of the process (the set of families is small).
+ */
+class FontFamily {
+private:
+    struct Atom {
+        std::wstring name;
+        size_t hash;
+    };
+
+    const Atom* atom_;
+
+    struct Table {
+        std::mutex mutex;
+        std::unordered_map<std::wstring_view, std::unique_ptr<Atom>> atoms;
+    };
+
+    static Table& table() {
+        static Table instance;
+        return instance;
+    }
+
+    static const Atom* intern(std::wstring_view name) {
+        auto& t = table();
+        std::lock_guard lock(t.mutex);
+
+        if (auto it = t.atoms.find(name); it != t.atoms.end()) {
+            return it->second.get();
+        }
+
+        auto atom = std::make_unique<Atom>(Atom{std::wstring(name), std::hash<std::wstring_view>{}(name)});
+        const Atom* ptr = atom.get();
+        t.atoms.emplace(std::wstring_view(ptr->name), std::move(atom));
+        return ptr;
+    }
+
+    static const Atom* default_atom() {
+        static const Atom* atom = intern(L"Segoe UI");
+        return atom;
+    }
+
+public:
+    FontFamily() : atom_(default_atom()) {}
+    FontFamily(std::wstring_view name) : atom_(intern(name)) {}
+    FontFamily(const std::wstring& name) : atom_(intern(name)) {}
+    FontFamily(const wchar_t* name) : atom_(intern(name)) {}
+
+    const std::wstring& name() const { return atom_->name; }
+    const wchar_t* c_str() const { return atom_->name.c_str(); }
+
+    /**
+     * @brief Hash of the name, computed once when the atom was created
+     */
+    size_t hash() const { return atom_->hash; }
+
+    bool operator==(const FontFamily& other) const { return atom_ == other.atom_; }
+
+    /**
+     * @brief Number of distinct families interned so far
+     */
+    static size_t interned_count() {
+        auto& t = table();
+        std::lock_guard lock(t.mutex);
+        return t.atoms.size();
+    }
+};
+
+} // namespace zuu::widget
+
+template <>
+struct std::hash<zuu::widget::FontFamily> {
+    size_t operator()(const zuu::widget::FontFamily& family) const noexcept {
+        return family.hash();
+    }
+};
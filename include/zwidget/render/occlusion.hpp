@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file occlusion.hpp
+ * @brief Covered-region tracking for front-to-back occlusion culling
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include "zwidget/core/memory.hpp"
+#include "zwidget/unit/rect.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Union of opaque rectangles accumulated front-to-back
+ * Coverage tests are exact: the query rect is split into fragments that
+ * are not yet covered, and it is hidden once no fragment survives.
+ * The occluder list is capped, keeping the largest rectangles.
+ */
+class OcclusionRegion {
+public:
+    using RectList = std::vector<Rectf, TrackingAllocator<Rectf, MemoryTag::render_cache>>;
+
+private:
+    RectList occluders_;
+    size_t max_occluders_ = 32;
+
+    // Scratch buffers reused between queries
+    mutable RectList fragments_;
+    mutable RectList remaining_;
+
+    static float area(const Rectf& r) {
+        return r.width() * r.height();
+    }
+
+    /**
+     * @brief Append the parts of r not covered by o (at most 4 bands)
+     */
+    static void subtract(const Rectf& r, const Rectf& o, RectList& out) {
+        if (!r.intersects(o)) {
+            out.push_back(r);
+            return;
+        }
+
+        if (o.top() > r.top()) {
+            out.push_back(Rectf{r.left(), r.top(), r.width(), o.top() - r.top()});
+        }
+        if (o.bottom() < r.bottom()) {
+            out.push_back(Rectf{r.left(), o.bottom(), r.width(), r.bottom() - o.bottom()});
+        }
+
+        float top = std::max(r.top(), o.top());
+        float bottom = std::min(r.bottom(), o.bottom());
+
+        if (o.left() > r.left()) {
+            out.push_back(Rectf{r.left(), top, o.left() - r.left(), bottom - top});
+        }
+        if (o.right() < r.right()) {
+            out.push_back(Rectf{o.right(), top, r.right() - o.right(), bottom - top});
+        }
+    }
+
+public:
+    OcclusionRegion() = default;
+
+    explicit OcclusionRegion(size_t max_occluders) : max_occluders_(max_occluders) {}
+
+    /**
+     * @brief Add an opaque rectangle to the covered region
+     */
+    void add(const Rectf& rect) {
+        if (rect.is_empty() || max_occluders_ == 0) return;
+
+        for (const auto& occ : occluders_) {
+            if (occ.contains(rect)) return;
+        }
+
+        std::erase_if(occluders_, [&](const Rectf& occ) { return rect.contains(occ); });
+
+        if (occluders_.size() >= max_occluders_) {
+            auto smallest = std::min_element(occluders_.begin(), occluders_.end(),
+                [](const Rectf& a, const Rectf& b) { return area(a) < area(b); });
+
+            if (area(*smallest) >= area(rect)) return;
+            *smallest = rect;
+            return;
+        }
+
+        occluders_.push_back(rect);
+    }
+
+    /**
+     * @brief Check if rect is completely hidden by the covered region
+     */
+    bool covers(const Rectf& rect) const {
+        if (rect.is_empty()) return true;
+
+        fragments_.assign(1, rect);
+
+        for (const auto& occ : occluders_) {
+            remaining_.clear();
+            for (const auto& fragment : fragments_) {
+                subtract(fragment, occ, remaining_);
+            }
+            fragments_.swap(remaining_);
+
+            if (fragments_.empty()) return true;
+        }
+
+        return false;
+    }
+
+    void clear() { occluders_.clear(); }
+
+    bool empty() const { return occluders_.empty(); }
+
+    size_t size() const { return occluders_.size(); }
+
+    const RectList& occluders() const { return occluders_; }
+};
+
+} // namespace zuu::widget
@@ -0,0 +1,330 @@
+#pragma once
+
+/**
+ * @file context.hpp
+ * @brief Portable software rendering context
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Draws into a BGRA pixel buffer on the CPU, so the widget tree can
+ * render and measure text where Direct2D is not available. Shapes are
+ * flattened to polygons and filled with the coverage rasterizer; text is
+ * laid out from TrueType metrics and drawn by blending glyph coverage from a
+ * shared GlyphAtlas, so each glyph is rasterized once per size and subpixel
+ * offset. Each line is composed into a TextRun bitmap that is kept in a
+ * TextRunCache, so static text costs one blit per frame; runs start on
+ * whole device pixels. With a zero run budget lines are blended glyph by
+ * glyph from the atlas instead. No kerning or shaping beyond the cmap: one code
+ * point, one glyph.
+ */
+
+#include "zwidget/render/context.hpp"
+#include "zwidget/render/font/glyph_atlas.hpp"
+#include "zwidget/render/font/text_run_cache.hpp"
+#include "zwidget/render/font/true_type.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief A font registered for a family and style
+ */
+struct SoftFontFace {
+    FontFamily family;
+    bool bold = false;
+    bool italic = false;
+    std::shared_ptr<const TrueTypeFont> font;
+};
+
+/**
+ * @brief CPU rendering context - thread-safe
+ */
+class SoftContext : public RenderContext {
+private:
+    /**
+     * @brief Affine transform, row-vector convention like D2D:
+     * x' = a x + c y + e, y' = b x + d y + f
+     */
+    struct Transform {
+        float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f, e = 0.0f, f = 0.0f;
+
+        Pointf apply(const Pointf& p) const {
+            return Pointf{a * p.x + c * p.y + e, b * p.x + d * p.y + f};
+        }
+
+        Transform then(const Transform& m) const {
+            return Transform{a * m.a + b * m.c, a * m.b + b * m.d,
+                             c * m.a + d * m.c, c * m.b + d * m.d,
+                             e * m.a + f * m.c + m.e, e * m.b + f * m.d + m.f};
+        }
+
+        float scale() const;
+        bool invert(Transform& out) const;
+    };
+
+    struct ClipBox {
+        int x0, y0, x1, y1;
+    };
+
+    struct PlacedGlyph {
+        uint16_t glyph;
+        float pen_x;  // Relative to the run's origin, in device pixels
+    };
+
+    // Target
+    Size size_;
+    std::vector<uint32_t> pixels_;  // 0xAARRGGBB, row-major
+
+    // State
+    Transform transform_;
+    std::vector<Transform> state_stack_;
+    std::vector<ClipBox> clip_stack_;
+    bool is_drawing_ = false;
+    float dpi_scale_ = 1.0f;
+
+    // Text
+    std::vector<SoftFontFace> fonts_;
+    GlyphAtlas atlas_;
+    TextRunCache runs_;
+
+    // Scratch, reused across calls
+    CoverageRasterizer rasterizer_;
+    std::vector<uint8_t> mask_;
+    std::vector<Pointf> path_;          // Device space
+    std::vector<size_t> contour_ends_;
+    TextRun run_scratch_;               // Runs the cache does not keep
+    std::vector<PlacedGlyph> placed_;
+
+    // Thread safety
+    mutable std::recursive_mutex mutex_;
+
+    // Helper methods
+    Transform base_transform() const;
+    ClipBox clip() const;
+
+    void begin_contour();
+    void add_point(const Pointf& p);
+    void add_ellipse(const Pointf& center, float rx, float ry, bool reverse);
+    void add_rounded_rect(const Rectf& rect, float rx, float ry, bool reverse);
+    void add_segment(const Pointf& p0, const Pointf& p1, float width);
+    int arc_segments(float radius) const;
+    void fill_path(const Color& color);
+
+    void blend_span(uint32_t* dst, const uint8_t* coverage, int count, const Color& color);
+    void blend_pixel(uint32_t& dst, const Color& color, unsigned coverage);
+
+    const TrueTypeFont* font_for(const TextStyle& style) const;
+    float line_width(const TrueTypeFont* font, std::wstring_view line, float em) const;
+    float line_height(const TrueTypeFont* font, float em) const;
+    const TextRun& text_run(const TrueTypeFont& font, std::wstring_view line, const TextStyle& style,
+                            uint16_t size);
+    void render_run(const TrueTypeFont& font, std::wstring_view line, float em, TextRun& run);
+    void draw_glyphs(const TrueTypeFont& font, std::wstring_view line, float em, int x, int y,
+                     const Color& color);
+    void draw_line_of_text(const TrueTypeFont* font, std::wstring_view line, Pointf position,
+                           float box_width, const Color& color, const TextStyle& style);
+
+public:
+    /**
+     * @brief Create a context with its own pixel buffer
+     */
+    explicit SoftContext(const Size& size, float dpi_scale = 1.0f);
+    ~SoftContext() override = default;
+
+    SoftContext(const SoftContext&) = delete;
+    SoftContext& operator=(const SoftContext&) = delete;
+
+    // === Fonts ===
+
+    /**
+     * @brief Register a font for a family; the first font added is the fallback
+     */
+    void add_font(FontFamily family, std::shared_ptr<const TrueTypeFont> font,
+                  bool bold = false, bool italic = false);
+
+    /**
+     * @brief Load and register a font file (throws std::runtime_error)
+     */
+    void add_font(FontFamily family, const std::string& path, bool bold = false, bool italic = false);
+
+    /**
+     * @brief Identity of the registered fonts, for a TextCacheFile shared with TextShaper
+     */
+    uint64_t font_identity() const;
+
+    /**
+     * @brief Load rasterized glyphs from, and save them to, a cache file (nullptr to detach)
+     */
+    void set_text_cache(TextCacheFile* cache);
+
+    /**
+     * @brief Glyph atlas counters; rasterized_frame covers the last begin_draw()
+     */
+    AtlasStats atlas_stats() const;
+
+    /**
+     * @brief Rendered text run counters; the frame counts cover the last begin_draw()
+     */
+    TextRunStats text_run_stats() const;
+
+    /**
+     * @brief Memory budget for cached text runs in bytes; 0 draws glyphs from the atlas directly
+     */
+    void set_text_run_budget(size_t bytes);
+
+    // === Target ===
+
+    const uint32_t* pixels() const { return pixels_.data(); }
+    void set_dpi_scale(float scale);
+
+    // === RenderContext Interface ===
+
+    void begin_draw() override;
+    void end_draw() override;
+    void clear(const Color& color) override;
+
+    void save_state() override;
+    void restore_state() override;
+
+    void translate(float x, float y) override;
+    void scale(float sx, float sy) override;
+    void rotate(float radians) override;
+    void reset_transform() override;
+
+    void set_clip_rect(const Rectf& rect) override;
+    void reset_clip() override;
+
+    void draw_line(
+        const Pointf& start,
+        const Pointf& end,
+        const Color& color,
+        float width = 1.0f
+    ) override;
+
+    void draw_rect(
+        const Rectf& rect,
+        const Color& color,
+        float width = 1.0f
+    ) override;
+
+    void fill_rect(
+        const Rectf& rect,
+        const Color& color
+    ) override;
+
+    void draw_rounded_rect(
+        const Rectf& rect,
+        float radius_x,
+        float radius_y,
+        const Color& color,
+        float width = 1.0f
+    ) override;
+
+    void fill_rounded_rect(
+        const Rectf& rect,
+        float radius_x,
+        float radius_y,
+        const Color& color
+    ) override;
+
+    void draw_ellipse(
+        const Pointf& center,
+        float radius_x,
+        float radius_y,
+        const Color& color,
+        float width = 1.0f
+    ) override;
+
+    void fill_ellipse(
+        const Pointf& center,
+        float radius_x,
+        float radius_y,
+        const Color& color
+    ) override;
+
+    void draw_polyline(
+        const std::vector<Pointf>& points,
+        const Color& color,
+        float width = 1.0f,
+        bool closed = false
+    ) override;
+
+    void fill_polygon(
+        const std::vector<Pointf>& points,
+        const Color& color
+    ) override;
+
+    void draw_text(
+        std::wstring_view text,
+        const Pointf& position,
+        const Color& color,
+        const TextStyle& style = TextStyle()
+    ) override;
+
+    void draw_text(
+        std::wstring_view text,
+        const Rectf& rect,
+        const Color& color,
+        const TextStyle& style = TextStyle()
+    ) override;
+
+    Sizef measure_text(
+        std::wstring_view text,
+        const TextStyle& style = TextStyle()
+    ) override;
+
+    float measure_advances(
+        std::wstring_view text,
+        const TextStyle& style,
+        std::vector<float>& advances
+    ) override;
+
+    void draw_image(
+        const Image& image,
+        const Pointf& position,
+        float opacity = 1.0f
+    ) override;
+
+    void draw_image(
+        const Image& image,
+        const Rectf& dest_rect,
+        float opacity = 1.0f
+    ) override;
+
+    void draw_image(
+        const Image& image,
+        const Rectf& dest_rect,
+        const Rectf& source_rect,
+        float opacity = 1.0f
+    ) override;
+
+    void fill_rect_gradient(
+        const Rectf& rect,
+        const Color& start_color,
+        const Color& end_color,
+        const Pointf& start_point,
+        const Pointf& end_point
+    ) override;
+
+    void fill_rect_radial_gradient(
+        const Rectf& rect,
+        const Color& center_color,
+        const Color& edge_color,
+        const Pointf& center,
+        float radius_x,
+        float radius_y
+    ) override;
+
+    Sizef get_size() const override;
+    float get_dpi_scale() const override;
+    bool is_drawing() const override;
+
+    void resize(const Size& new_size) override;
+    void flush() override;
+};
+
+} // namespace zuu::widget
@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file style.hpp
+ * @brief Shared immutable style objects (flyweight)
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details SharedStyle<T> interns style values: equal values share one
+ * refcounted, immutable node whose hash is computed once. Widgets hold the
+ * handle instead of a private copy, so a thousand labels with the same look
+ * cost a thousand pointers and one TextStyle. Nodes are dropped from the
+ * intern table when the last handle goes away.
+ */
+
+#include "zwidget/render/context.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace zuu::widget {
+
+/**
+ * @brief Interned handle to an immutable style value
+ * @tparam T Value type with operator== and a hash() member
+ */
+template <typename T>
+class SharedStyle {
+private:
+    struct Node {
+        T value;
+        size_t hash;
+    };
+
+    struct Entry {
+        const Node* node;
+        std::weak_ptr<const Node> weak;
+    };
+
+    struct Table {
+        std::mutex mutex;
+        std::unordered_multimap<size_t, Entry> entries;
+    };
+
+    std::shared_ptr<const Node> node_;
+
+    static Table& table() {
+        // Leaked so handles destroyed during static teardown can still unregister
+        static Table* instance = new Table;
+        return *instance;
+    }
+
+    static void release(const Node* node) {
+        {
+            auto& t = table();
+            std::lock_guard lock(t.mutex);
+
+            auto [first, last] = t.entries.equal_range(node->hash);
+            for (auto it = first; it != last; ++it) {
+                if (it->second.node == node) {
+                    t.entries.erase(it);
+                    break;
+                }
+            }
+        }
+        delete node;
+    }
+
+    static std::shared_ptr<const Node> intern(T value) {
+        size_t hash = value.hash();
+
+        auto& t = table();
+        std::lock_guard lock(t.mutex);
+
+        // Entries are erased before their node is deleted, so node is valid here
+        auto [first, last] = t.entries.equal_range(hash);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.node->value == value) {
+                if (auto shared = it->second.weak.lock()) {
+                    return shared;
+                }
+            }
+        }
+
+        const Node* raw = new Node{std::move(value), hash};
+        std::shared_ptr<const Node> node(raw, &SharedStyle::release);
+        t.entries.emplace(hash, Entry{raw, node});
+        return node;
+    }
+
+    static const std::shared_ptr<const Node>& default_node() {
+        static const std::shared_ptr<const Node> node = intern(T{});
+        return node;
+    }
+
+public:
+    SharedStyle() : node_(default_node()) {}
+
+    SharedStyle(const T& value) : node_(intern(value)) {}
+
+    const T& get() const { return node_->value; }
+    const T& operator*() const { return node_->value; }
+    const T* operator->() const { return &node_->value; }
+
+    /**
+     * @brief Hash of the value, computed once per distinct style
+     */
+    size_t hash() const { return node_->hash; }
+
+    /**
+     * @brief Handles to equal values are the same node
+     */
+    bool operator==(const SharedStyle& other) const { return node_ == other.node_; }
+
+    /**
+     * @brief Copy of this style with a modification, interned
+     * @param edit Callable receiving T& to modify
+     */
+    template <typename F>
+    SharedStyle with(F&& edit) const {
+        T value = node_->value;
+        std::forward<F>(edit)(value);
+        return SharedStyle(value);
+    }
+
+    /**
+     * @brief Distinct values currently alive
+     */
+    static size_t interned_count() {
+        auto& t = table();
+        std::lock_guard lock(t.mutex);
+        return t.entries.size();
+    }
+};
+
+using TextStyleRef = SharedStyle<TextStyle>;
+
+} // namespace zuu::widget
@@ -0,0 +1,375 @@
+#pragma once
+
+/**
+ * @file text_layout.hpp
+ * @brief Line breaking with cached break opportunities and prefix advances
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details A TextLayout is built once per string and style: one shaping
+ * call gives every unit's advance, which are summed into prefix_[i] (the
+ * width of text[0, i)), and one scan records where lines may break. The
+ * width of any candidate line is then a subtraction, so wrapping at a new
+ * width is a binary search over the break opportunities per line instead
+ * of measuring the text again.
+ */
+
+#include "zwidget/core/memory.hpp"
+#include "zwidget/render/context.hpp"
+#include "zwidget/render/font/text_cache_file.hpp"
+#include "zwidget/unit/utf8.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief One wrapped line: text[begin, end), trailing spaces excluded
+ */
+struct TextLine {
+    uint32_t begin;
+    uint32_t end;
+    float width;
+};
+
+/**
+ * @brief Shaped text ready to be wrapped at any width
+ * Breaks after spaces, after hyphens inside words and around CJK
+ * ideographs; line feeds (LF, CR, CRLF) are mandatory breaks. A word wider
+ * than the line is split between clusters.
+ */
+class TextLayout {
+private:
+    struct Break {
+        uint32_t end;     // Visible end of the line taking this break
+        uint32_t next;    // Start of the following line
+        bool mandatory;
+    };
+
+    std::vector<float> prefix_{0.0f};
+    std::vector<Break> breaks_;         // Ascending; the last one ends the text
+    std::vector<uint32_t> mandatory_;   // Indices into breaks_
+    std::vector<bool> low_surrogate_;   // Units that must not start a line
+    float line_height_ = 0.0f;
+    float natural_width_ = 0.0f;        // Widest paragraph
+    float min_width_ = 0.0f;            // Widest unbreakable piece
+    size_t paragraphs_ = 1;
+
+    static bool is_space(wchar_t c) { return c == L' ' || c == L'\t' || c == 0x3000; }
+    static bool is_newline(wchar_t c) { return c == L'\n' || c == L'\r'; }
+
+    static bool is_cjk(wchar_t c) {
+        return (c >= 0x2E80 && c <= 0x9FFF) || (c >= 0xAC00 && c <= 0xD7AF) ||
+               (c >= 0xF900 && c <= 0xFAFF) || (c >= 0xFF00 && c <= 0xFFEF);
+    }
+
+    float span(uint32_t begin, uint32_t end) const { return prefix_[end] - prefix_[begin]; }
+
+    /**
+     * @brief Last unit boundary in (begin, end) not wider than limit, whole clusters only
+     */
+    uint32_t cluster_cut(uint32_t begin, uint32_t end, float limit) const {
+        auto first = prefix_.begin() + begin + 1;
+        auto last = prefix_.begin() + end + 1;
+        uint32_t cut = static_cast<uint32_t>(std::upper_bound(first, last, limit) - prefix_.begin()) - 1;
+        cut = std::max(cut, begin + 1);  // At least one unit per line
+
+        // Zero-advance units continue the cluster before them
+        while (cut < end && (prefix_[cut + 1] == prefix_[cut] || low_surrogate_[cut])) {
+            ++cut;
+        }
+        return cut;
+    }
+
+public:
+    TextLayout() { breaks_.push_back(Break{0, 0, true}); mandatory_.push_back(0); }
+
+    /**
+     * @param advances Advance of each UTF-16 unit, as from measure_advances()
+     */
+    TextLayout(std::wstring_view text, const std::vector<float>& advances, float line_height)
+        : line_height_(line_height) {
+        const uint32_t n = static_cast<uint32_t>(text.size());
+        prefix_.resize(n + 1);
+        low_surrogate_.resize(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            prefix_[i + 1] = prefix_[i] + std::max(advances[i], 0.0f);
+            low_surrogate_[i] = text[i] >= 0xDC00 && text[i] <= 0xDFFF;
+        }
+
+        auto trim = [&](uint32_t end, uint32_t begin) {
+            while (end > begin && is_space(text[end - 1])) --end;
+            return end;
+        };
+        auto add = [&](uint32_t end, uint32_t next, bool mandatory) {
+            if (mandatory) mandatory_.push_back(static_cast<uint32_t>(breaks_.size()));
+            breaks_.push_back(Break{end, next, mandatory});
+        };
+
+        uint32_t line = 0;     // Start of the current paragraph
+        uint32_t piece = 0;    // Start of the current unbreakable piece
+        auto close_piece = [&](uint32_t end, uint32_t next) {
+            min_width_ = std::max(min_width_, span(piece, std::max(end, piece)));
+            piece = next;
+        };
+
+        for (uint32_t i = 0; i < n; ++i) {
+            wchar_t c = text[i];
+
+            if (is_newline(c)) {
+                uint32_t next = (c == L'\r' && i + 1 < n && text[i + 1] == L'\n') ? i + 2 : i + 1;
+                uint32_t end = trim(i, line);
+                close_piece(end, next);
+                natural_width_ = std::max(natural_width_, span(line, end));
+                add(end, next, true);
+                line = next;
+                ++paragraphs_;
+                i = next - 1;
+            } else if (is_space(c)) {
+                uint32_t j = i;
+                while (j < n && is_space(text[j])) ++j;
+                // Leading spaces belong to the line; trailing ones are trimmed by the next break
+                if (i > line && j < n && !is_newline(text[j])) {
+                    close_piece(i, j);
+                    add(i, j, false);
+                }
+                i = j - 1;
+            } else if (i + 1 < n && !is_space(text[i + 1]) && !is_newline(text[i + 1]) &&
+                       !low_surrogate_[i + 1] &&
+                       (((c == L'-' || c == 0x2010) && i > line && !is_space(text[i - 1])) ||
+                        is_cjk(c) || is_cjk(text[i + 1]))) {
+                close_piece(i + 1, i + 1);
+                add(i + 1, i + 1, false);
+            }
+        }
+
+        uint32_t end = trim(n, line);
+        close_piece(end, n);
+        natural_width_ = std::max(natural_width_, span(line, end));
+        add(end, n, true);
+    }
+
+    // === Wrapping ===
+
+    /**
+     * @brief Break into lines no wider than width (FLT_MAX: only at line feeds)
+     * O(lines * log breaks): each line is one binary search.
+     */
+    void wrap(float width, std::vector<TextLine>& lines) const {
+        lines.clear();
+        uint32_t begin = 0;
+        size_t k = 0;
+
+        for (;;) {
+            size_t m = *std::lower_bound(mandatory_.begin(), mandatory_.end(), static_cast<uint32_t>(k));
+            // A break at the very start of the line would leave it empty
+            while (k < m && breaks_[k].end <= begin) ++k;
+
+            float limit = prefix_[begin] + width;
+            auto first = breaks_.begin() + static_cast<ptrdiff_t>(k);
+            auto last = breaks_.begin() + static_cast<ptrdiff_t>(m) + 1;
+            auto fit = std::upper_bound(first, last, limit, [this](float value, const Break& b) {
+                return value < prefix_[b.end];
+            });
+
+            if (fit == first && breaks_[k].end > begin + 1) {
+                // First piece alone is too wide: split it between clusters
+                uint32_t cut = cluster_cut(begin, breaks_[k].end, limit);
+                if (cut < breaks_[k].end) {
+                    lines.push_back(TextLine{begin, cut, span(begin, cut)});
+                    begin = cut;
+                    continue;
+                }
+            }
+
+            size_t taken = fit == first ? k : static_cast<size_t>(fit - breaks_.begin()) - 1;
+            const Break& b = breaks_[taken];
+            lines.push_back(TextLine{begin, b.end, span(begin, std::max(b.end, begin))});
+            if (taken + 1 == breaks_.size()) return;
+
+            begin = b.next;
+            k = taken + 1;
+        }
+    }
+
+    /**
+     * @brief Size of the text wrapped at width
+     */
+    Sizef measure(float width) const {
+        std::vector<TextLine> lines;
+        wrap(width, lines);
+        float w = 0.0f;
+        for (const auto& l : lines) w = std::max(w, l.width);
+        return Sizef{w, line_height_ * static_cast<float>(lines.size())};
+    }
+
+    // === Metrics ===
+
+    float line_height() const { return line_height_; }
+
+    /**
+     * @brief Unwrapped size: widest paragraph by paragraph count
+     */
+    Sizef natural_size() const {
+        return Sizef{natural_width_, line_height_ * static_cast<float>(paragraphs_)};
+    }
+
+    /**
+     * @brief Narrowest width that breaks no word
+     */
+    float min_content_width() const { return min_width_; }
+
+    /**
+     * @brief Width of text[begin, end)
+     */
+    float advance(uint32_t begin, uint32_t end) const { return span(begin, end); }
+
+    /**
+     * @brief Unit boundary nearest to x, never inside a surrogate pair - O(log n)
+     */
+    uint32_t offset_at(float x) const {
+        const uint32_t n = static_cast<uint32_t>(prefix_.size() - 1);
+        auto it = std::upper_bound(prefix_.begin(), prefix_.end(), x);
+        if (it == prefix_.begin()) return 0;
+        if (it == prefix_.end()) return n;
+
+        uint32_t i = static_cast<uint32_t>(it - prefix_.begin()) - 1;  // prefix_[i] <= x < prefix_[i + 1]
+        if (x - prefix_[i] > prefix_[i + 1] - x) ++i;
+        if (i < n && low_surrogate_[i]) --i;
+        return i;
+    }
+
+    size_t length() const { return prefix_.size() - 1; }
+
+    size_t heap_bytes() const {
+        return prefix_.capacity() * sizeof(float) + breaks_.capacity() * sizeof(Break) +
+               mandatory_.capacity() * sizeof(uint32_t) + low_surrogate_.capacity() / 8;
+    }
+};
+
+/**
+ * @brief Builds TextLayouts from the render context that measures text
+ * Layout runs before any drawing, so the context is registered once at
+ * startup. Without one, advances are estimated from the font size. An
+ * optional TextCacheFile answers measurements made by earlier runs, for
+ * strings shaped with persist set: captions that recur across runs, not
+ * text being typed or read from a file. Canvas::measure_text() goes
+ * through it too.
+ */
+class TextShaper {
+private:
+    static inline std::atomic<RenderContext*> context_{nullptr};
+    static inline std::atomic<TextCacheFile*> cache_{nullptr};
+
+public:
+    static void set_context(RenderContext* context) { context_.store(context, std::memory_order_release); }
+    static RenderContext* context() { return context_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Persistent measurements; its identity must cover the context's fonts
+     */
+    static void set_cache(TextCacheFile* cache) { cache_.store(cache, std::memory_order_release); }
+    static TextCacheFile* cache() { return cache_.load(std::memory_order_acquire); }
+
+    static TextLayout shape(std::wstring_view text, const TextStyle& style, bool persist = false) {
+        std::vector<float> advances;
+        float line_height;
+
+        if (RenderContext* ctx = context()) {
+            TextCacheFile* cache = persist ? TextShaper::cache() : nullptr;
+            if (!cache || !cache->find_advances(text, style, advances, line_height)) {
+                line_height = ctx->measure_advances(text, style, advances);
+                if (cache) cache->store_advances(text, style, advances, line_height);
+            }
+        } else {
+            advances.resize(text.size());
+            for (size_t i = 0; i < text.size(); ++i) {
+                wchar_t c = text[i];
+                float em = c == L' ' ? 0.28f : (c >= 0x2E80 ? 1.0f : 0.52f);
+                advances[i] = (c >= 0xDC00 && c <= 0xDFFF) ? 0.0f : em * style.font_size;
+            }
+            line_height = style.font_size * 1.33f;
+        }
+        return TextLayout(text, advances, line_height);
+    }
+
+    /**
+     * @brief ctx.measure_text(), through the persistent cache when ctx is the registered context
+     * For the short captions widgets measure while drawing, e.g. a slider's value.
+     */
+    static Sizef measure(RenderContext& ctx, std::wstring_view text, const TextStyle& style) {
+        TextCacheFile* cache = &ctx == context() ? TextShaper::cache() : nullptr;
+        if (cache) {
+            if (std::optional<Sizef> extent = cache->find_extent(text, style)) return *extent;
+        }
+        Sizef extent = ctx.measure_text(text, style);
+        if (cache) cache->store_extent(text, style, extent);
+        return extent;
+    }
+};
+
+/**
+ * @brief Per-widget cache: the transcoded text, its shaping and the lines of the last width
+ * The owner keeps its text in UTF-8; the wide copy here is what the layout
+ * indexes and what gets drawn, so it is made once per text change. Its
+ * shaping goes through the persistent cache, if one is set.
+ */
+class TextLayoutCache {
+private:
+    std::wstring text_;
+    TextLayout layout_;
+    std::vector<TextLine> lines_;
+    float wrapped_width_ = -1.0f;
+    bool shaped_ = false;
+
+public:
+    /**
+     * @brief Text changed
+     */
+    void assign(std::string_view utf8_text) {
+        utf8::to_wide(utf8_text, text_);
+        invalidate();
+    }
+
+    /**
+     * @brief Style changed: shape again on next use
+     */
+    void invalidate() {
+        shaped_ = false;
+        wrapped_width_ = -1.0f;
+    }
+
+    const std::wstring& text() const { return text_; }
+
+    const TextLayout& layout(const TextStyle& style) {
+        if (!shaped_) {
+            layout_ = TextShaper::shape(text_, style, true);
+            shaped_ = true;
+            wrapped_width_ = -1.0f;
+        }
+        return layout_;
+    }
+
+    const std::vector<TextLine>& lines(const TextStyle& style, float width) {
+        const TextLayout& shaped = layout(style);
+        if (width != wrapped_width_) {
+            shaped.wrap(width, lines_);
+            wrapped_width_ = width;
+        }
+        return lines_;
+    }
+
+    size_t heap_bytes() const {
+        return sizeof(*this) + string_heap_bytes(text_) + layout_.heap_bytes() +
+               lines_.capacity() * sizeof(TextLine);
+    }
+};
+
+} // namespace zuu::widget
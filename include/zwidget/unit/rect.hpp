@@ -14,6 +14,7 @@
 
 #include "zwidget/unit/point.hpp"
 #include "zwidget/unit/size.hpp"
+#include <algorithm>
 
 namespace zuu::widget {
 
@@ -143,6 +144,56 @@ namespace zuu::widget {
             return size.has_zero() ;
         }
 
+        /**
+         * @brief Checks if another rectangle lies completely inside this one.
+         * @param other The rectangle to check.
+         * @return true if every edge of other is within this rectangle.
+         */
+        template <_meta::Numeric TP, _meta::Numeric TS>
+        constexpr bool contains(const basic_rect<TP, TS>& other) const noexcept {
+            return (left() <= static_cast<Tpos>(other.left()) &&
+                    right() >= static_cast<Tpos>(other.right()) &&
+                    top() <= static_cast<Tpos>(other.top()) &&
+                    bottom() >= static_cast<Tpos>(other.bottom()));
+        }
+
+        /**
+         * @brief Computes the overlapping area of two rectangles.
+         * @param other The rectangle to intersect with.
+         * @return The overlap, or an empty rectangle at the clamped origin if they don't overlap.
+         */
+        template <_meta::Numeric TP, _meta::Numeric TS>
+        constexpr basic_rect intersected(const basic_rect<TP, TS>& other) const noexcept {
+            Tpos l = std::max(left(), static_cast<Tpos>(other.left()));
+            Tpos t = std::max(top(), static_cast<Tpos>(other.top()));
+            Tpos r = std::min(right(), static_cast<Tpos>(other.right()));
+            Tpos b = std::min(bottom(), static_cast<Tpos>(other.bottom()));
+
+            if (r <= l || b <= t) {
+                return basic_rect(l, t, Tsize{}, Tsize{});
+            }
+            return basic_rect(l, t, static_cast<Tsize>(r - l), static_cast<Tsize>(b - t));
+        }
+
+        /**
+         * @brief Computes the smallest rectangle enclosing both rectangles.
+         * Empty rectangles are ignored, so an empty rect acts as the identity.
+         * @param other The rectangle to merge with.
+         * @return The bounding rectangle of both.
+         */
+        template <_meta::Numeric TP, _meta::Numeric TS>
+        constexpr basic_rect united(const basic_rect<TP, TS>& other) const noexcept {
+            if (other.is_empty()) return *this;
+            if (is_empty()) return static_cast<basic_rect>(other);
+
+            Tpos l = std::min(left(), static_cast<Tpos>(other.left()));
+            Tpos t = std::min(top(), static_cast<Tpos>(other.top()));
+            Tpos r = std::max(right(), static_cast<Tpos>(other.right()));
+            Tpos b = std::max(bottom(), static_cast<Tpos>(other.bottom()));
+
+            return basic_rect(l, t, static_cast<Tsize>(r - l), static_cast<Tsize>(b - t));
+        }
+
         /// @}
 
         /// @name Conversion
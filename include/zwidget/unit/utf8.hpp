@@ -0,0 +1,221 @@
+#pragma once
+
+/**
+ * @file utf8.hpp
+ * @brief UTF-8 <-> wchar_t transcoding for text stored as UTF-8
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Widgets keep their text in UTF-8 and convert only where a backend
+ * wants wide strings (UTF-16 on Windows, UTF-32 where wchar_t is 4 bytes).
+ * UI text is mostly ASCII, so both directions test 16 bytes at a time with
+ * SSE2 and widen or narrow whole blocks, falling back to a scalar decoder
+ * at the first non-ASCII byte. Malformed input becomes U+FFFD.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZWIDGET_UTF8_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace zuu::widget::utf8 {
+
+inline constexpr char32_t replacement = 0xFFFD;
+
+namespace detail {
+
+#ifdef ZWIDGET_UTF8_SSE2
+// Callers only pass blocks with 16 units left. GCC cannot see that bound when
+// a short literal (L"cell") is inlined through wstring_view, whose wcslen it
+// does not fold, and reports the loads against the literal's array.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+/**
+ * @brief Widen an all-ASCII block of 16 bytes
+ */
+inline void widen_block(__m128i bytes, wchar_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    if constexpr (sizeof(wchar_t) == 2) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), hi);
+    } else {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+}
+
+/**
+ * @brief Narrow 16 wide units to bytes if all are ASCII
+ */
+inline bool narrow_block(const wchar_t* in, char* out) {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in);
+    __m128i packed;
+    if constexpr (sizeof(wchar_t) == 2) {
+        __m128i a = _mm_loadu_si128(src);
+        __m128i b = _mm_loadu_si128(src + 1);
+        const __m128i high = _mm_set1_epi16(static_cast<short>(0xFF80));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), high),
+                                              _mm_setzero_si128())) != 0xFFFF) {
+            return false;
+        }
+        packed = _mm_packus_epi16(a, b);
+    } else {
+        __m128i a = _mm_loadu_si128(src);
+        __m128i b = _mm_loadu_si128(src + 1);
+        __m128i c = _mm_loadu_si128(src + 2);
+        __m128i d = _mm_loadu_si128(src + 3);
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFFFF80u));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, high), _mm_setzero_si128())) != 0xFFFF) {
+            return false;
+        }
+        packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    return true;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+/**
+ * @brief Decode one sequence at s[i], advancing i; U+FFFD on malformed input
+ */
+inline char32_t decode(std::string_view s, size_t& i) {
+    unsigned char lead = static_cast<unsigned char>(s[i++]);
+    if (lead < 0x80) return lead;
+
+    size_t extra;
+    char32_t cp;
+    char32_t min;
+    if (lead >= 0xC2 && lead <= 0xDF) { extra = 1; cp = lead & 0x1F; min = 0x80; }
+    else if (lead >= 0xE0 && lead <= 0xEF) { extra = 2; cp = lead & 0x0F; min = 0x800; }
+    else if (lead >= 0xF0 && lead <= 0xF4) { extra = 3; cp = lead & 0x07; min = 0x10000; }
+    else return replacement;
+
+    for (size_t k = 0; k < extra; ++k) {
+        if (i >= s.size()) return replacement;
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if ((c & 0xC0) != 0x80) return replacement;  // Resynchronize on this byte
+        cp = (cp << 6) | (c & 0x3F);
+        ++i;
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return replacement;
+    return cp;
+}
+
+inline wchar_t* put_wide(char32_t cp, wchar_t* out) {
+    if constexpr (sizeof(wchar_t) == 2) {
+        if (cp >= 0x10000) {
+            cp -= 0x10000;
+            *out++ = static_cast<wchar_t>(0xD800 + (cp >> 10));
+            *out++ = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+            return out;
+        }
+    }
+    *out++ = static_cast<wchar_t>(cp);
+    return out;
+}
+
+inline char* put_utf8(char32_t cp, char* out) {
+    if (cp < 0x80) {
+        *out++ = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (cp >> 6));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (cp >> 12));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (cp >> 18));
+        *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+} // namespace detail
+
+/**
+ * @brief Decode UTF-8 into out, replacing its contents (capacity is reused)
+ */
+inline void to_wide(std::string_view in, std::wstring& out) {
+    // Every wide unit consumes at least one byte
+    out.resize(in.size());
+    wchar_t* dst = out.data();
+    size_t i = 0;
+
+    while (i < in.size()) {
+#ifdef ZWIDGET_UTF8_SSE2
+        while (i + 16 <= in.size()) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+            if (_mm_movemask_epi8(bytes) != 0) break;
+            detail::widen_block(bytes, dst);
+            dst += 16;
+            i += 16;
+        }
+        if (i >= in.size()) break;
+#endif
+        dst = detail::put_wide(detail::decode(in, i), dst);
+    }
+    out.resize(static_cast<size_t>(dst - out.data()));
+}
+
+inline std::wstring to_wide(std::string_view in) {
+    std::wstring out;
+    to_wide(in, out);
+    return out;
+}
+
+/**
+ * @brief Encode wide text as UTF-8 into out, replacing its contents
+ */
+inline void from_wide(std::wstring_view in, std::string& out) {
+    out.resize(in.size() * (sizeof(wchar_t) == 2 ? 3 : 4));
+    char* dst = out.data();
+    size_t i = 0;
+
+    while (i < in.size()) {
+#ifdef ZWIDGET_UTF8_SSE2
+        while (i + 16 <= in.size() && detail::narrow_block(in.data() + i, dst)) {
+            dst += 16;
+            i += 16;
+        }
+        if (i >= in.size()) break;
+#endif
+        char32_t cp = static_cast<char32_t>(in[i++]);
+        if constexpr (sizeof(wchar_t) == 2) {
+            if (cp >= 0xD800 && cp <= 0xDBFF && i < in.size() &&
+                in[i] >= 0xDC00 && in[i] <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (static_cast<char32_t>(in[i++]) - 0xDC00);
+            }
+        }
+        if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) cp = replacement;
+        dst = detail::put_utf8(cp, dst);
+    }
+    out.resize(static_cast<size_t>(dst - out.data()));
+}
+
+inline std::string from_wide(std::wstring_view in) {
+    std::string out;
+    from_wide(in, out);
+    out.shrink_to_fit();  // Drop the worst-case reserve: the result is usually stored
+    return out;
+}
+
+} // namespace zuu::widget::utf8
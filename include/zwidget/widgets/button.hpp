@@ -7,9 +7,12 @@
  * @date 2025-11-30
  */
 
+#include "zwidget/core/signal.hpp"
 #include "zwidget/core/widget.hpp"
 #include "zwidget/render/canvas.hpp"
 #include <functional>
+#include <string>
+#include <string_view>
 
 namespace zuu::widget {
 
@@ -21,8 +24,8 @@ public:
     using ClickCallback = std::function<void()>;
     
 private:
-    std::wstring text_;
-    TextStyle text_style_;
+    std::string text_;  // UTF-8
+    TextStyleRef text_style_;
     
     float border_radius_ = 4.0f;
     float border_width_ = 1.0f;
@@ -35,6 +38,14 @@ private:
     Color border_color_{128, 128, 128, 255};
     
     ClickCallback on_click_;
+    Signal<> clicked_;
+    
+    void notify_click() {
+        if (on_click_) {
+            on_click_();
+        }
+        clicked_.emit();
+    }
     
 public:
     Button() {
@@ -48,45 +59,74 @@ public:
         pressed_bg_ = Color(200, 200, 200, 255);
         disabled_bg_ = Color(240, 240, 240, 255);
         
-        text_style_.font_size = 14.0f;
-        text_style_.align = TextAlign::center;
-        text_style_.valign = TextVAlign::middle;
+        TextStyle style;
+        style.font_size = 14.0f;
+        style.align = TextAlign::center;
+        style.valign = TextVAlign::middle;
+        text_style_ = style;
     }
     
-    explicit Button(const std::wstring& text) : Button() {
+    explicit Button(std::string_view text) : Button() {
         text_ = text;
     }
     
-    Button(const std::wstring& text, const TextStyle& style) : Button(text) {
+    explicit Button(std::wstring_view text) : Button() {
+        text_ = utf8::from_wide(text);
+    }
+    
+    Button(std::string_view text, const TextStyle& style) : Button(text) {
+        text_style_ = style;
+    }
+    
+    Button(std::wstring_view text, const TextStyle& style) : Button(text) {
         text_style_ = style;
     }
     
     // === Text Management ===
     
-    void set_text(const std::wstring& text) {
+    void set_text(std::string_view text) {
         if (text_ != text) {
             text_ = text;
-            mark_dirty();
+            invalidate_layout();
         }
     }
     
-    const std::wstring& text() const { return text_; }
+    void set_text(std::wstring_view text) {
+        set_text(std::string_view(utf8::from_wide(text)));
+    }
+    
+    /**
+     * @brief The text as stored, UTF-8
+     */
+    const std::string& utf8_text() const { return text_; }
+    
+    std::wstring text() const { return utf8::to_wide(text_); }
     
     void set_text_style(const TextStyle& style) {
         text_style_ = style;
-        mark_dirty();
+        invalidate_layout();
+    }
+    
+    const TextStyle& text_style() const { return *text_style_; }
+    
+    /**
+     * @brief Share an interned style with other widgets
+     */
+    void set_shared_text_style(TextStyleRef style) {
+        text_style_ = std::move(style);
+        invalidate_layout();
     }
     
-    const TextStyle& text_style() const { return text_style_; }
+    const TextStyleRef& shared_text_style() const { return text_style_; }
     
     void set_font_size(float size) {
-        text_style_.font_size = size;
-        mark_dirty();
+        text_style_ = text_style_.with([&](TextStyle& s) { s.font_size = size; });
+        invalidate_layout();
     }
     
     void set_bold(bool bold) {
-        text_style_.bold = bold;
-        mark_dirty();
+        text_style_ = text_style_.with([&](TextStyle& s) { s.bold = bold; });
+        invalidate_layout();
     }
     
     // === Appearance ===
@@ -141,22 +181,47 @@ public:
         on_click_ = std::move(callback);
     }
     
+    /**
+     * @brief Multi-subscriber variant of set_on_click
+     */
+    Signal<>& clicked() { return clicked_; }
+    
+    /**
+     * @brief Background color for the current state
+     */
+    const Color& current_background() const {
+        if (!is_enabled()) {
+            return disabled_bg_;
+        } else if (is_pressed()) {
+            return pressed_bg_;
+        } else if (is_hovered()) {
+            return hover_bg_;
+        }
+        return normal_bg_;
+    }
+    
     // === Widget Interface ===
     
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        out.strings += string_heap_bytes(text_);
+    }
+    
+    Rectf opaque_rect() const override {
+        if (current_background().a == 255) {
+            // Rounded corners leave the outer radius band partially uncovered
+            float inset = std::min({border_radius_, width() / 2.0f, height() / 2.0f});
+            return Rectf{inset, inset, width() - inset * 2, height() - inset * 2};
+        }
+        return Widget::opaque_rect();
+    }
+    
     void draw(Canvas& canvas) override {
         Rectf rect{0, 0, width(), height()};
         
         // Determine background color based on state
-        Color bg_color;
-        if (!is_enabled()) {
-            bg_color = disabled_bg_;
-        } else if (is_pressed()) {
-            bg_color = pressed_bg_;
-        } else if (is_hovered()) {
-            bg_color = hover_bg_;
-        } else {
-            bg_color = normal_bg_;
-        }
+        Color bg_color = current_background();
         
         // Draw background
         if (border_radius_ > 0) {
@@ -180,7 +245,7 @@ public:
         // Draw text
         if (!text_.empty()) {
             Color text_color = is_enabled() ? foreground() : Color(150, 150, 150, 255);
-            canvas.draw_text(text_, rect, text_color, text_style_);
+            canvas.draw_text(std::string_view(text_), rect, text_color, *text_style_);
         }
     }
     
@@ -214,9 +279,7 @@ public:
             
             // Trigger click if released while still inside button
             if (was_pressed && contains(pos)) {
-                if (on_click_) {
-                    on_click_();
-                }
+                notify_click();
             }
             
             return true;
@@ -226,9 +289,7 @@ public:
     
     bool on_key_press(uint32_t key) override {
         if ((key == VK_RETURN || key == VK_SPACE) && is_enabled()) {
-            if (on_click_) {
-                on_click_();
-            }
+            notify_click();
             return true;
         }
         return false;
@@ -238,12 +299,22 @@ public:
 /**
  * @brief Helper to create button
  */
-inline WidgetPtr make_button(const std::wstring& text) {
-    return std::make_shared<Button>(text);
+inline WidgetPtr make_button(std::string_view text) {
+    return make_widget<Button>(text);
+}
+
+inline WidgetPtr make_button(std::wstring_view text) {
+    return make_widget<Button>(text);
 }
 
-inline WidgetPtr make_button(const std::wstring& text, Button::ClickCallback callback) {
-    auto button = std::make_shared<Button>(text);
+inline WidgetPtr make_button(std::string_view text, Button::ClickCallback callback) {
+    auto button = make_widget<Button>(text);
+    button->set_on_click(std::move(callback));
+    return button;
+}
+
+inline WidgetPtr make_button(std::wstring_view text, Button::ClickCallback callback) {
+    auto button = make_widget<Button>(text);
     button->set_on_click(std::move(callback));
     return button;
 }
@@ -272,6 +343,12 @@ public:
     
     const std::wstring& icon() const { return icon_path_; }
     
+    void measure_memory(WidgetMemory& out) const override {
+        Button::measure_memory(out);
+        out.object = sizeof(*this);
+        out.strings += string_heap_bytes(icon_path_);
+    }
+    
     void draw(Canvas& canvas) override {
         // For now, just draw as regular button
         Button::draw(canvas);
@@ -297,7 +374,13 @@ private:
 public:
     ToggleButton() : Button() {}
     
-    explicit ToggleButton(const std::wstring& text) : Button(text) {}
+    explicit ToggleButton(std::string_view text) : Button(text) {}
+    explicit ToggleButton(std::wstring_view text) : Button(text) {}
+    
+    void measure_memory(WidgetMemory& out) const override {
+        Button::measure_memory(out);
+        out.object = sizeof(*this);
+    }
     
     void set_toggled(bool toggled) {
         if (toggled_ != toggled) {
@@ -341,8 +424,14 @@ public:
 /**
  * @brief Helper to create toggle button
  */
-inline WidgetPtr make_toggle_button(const std::wstring& text, bool initial = false) {
-    auto button = std::make_shared<ToggleButton>(text);
+inline WidgetPtr make_toggle_button(std::string_view text, bool initial = false) {
+    auto button = make_widget<ToggleButton>(text);
+    button->set_toggled(initial);
+    return button;
+}
+
+inline WidgetPtr make_toggle_button(std::wstring_view text, bool initial = false) {
+    auto button = make_widget<ToggleButton>(text);
     button->set_toggled(initial);
     return button;
 }
@@ -7,9 +7,12 @@
  * @date 2025-11-30
  */
 
+#include "zwidget/core/signal.hpp"
 #include "zwidget/core/widget.hpp"
 #include "zwidget/render/canvas.hpp"
 #include <functional>
+#include <string>
+#include <string_view>
 
 namespace zuu::widget {
 
@@ -21,16 +24,24 @@ public:
     using CheckedChangedCallback = std::function<void(bool)>;
     
 private:
-    std::wstring label_;
+    std::string label_;  // UTF-8
     bool checked_ = false;
     bool tristate_ = false;
     int state_ = 0; // 0 = unchecked, 1 = checked, 2 = indeterminate
     
-    TextStyle label_style_;
+    TextStyleRef label_style_;
     float box_size_ = 16.0f;
     float spacing_ = 8.0f;
     
     CheckedChangedCallback on_checked_changed_;
+    Signal<bool> checked_changed_;
+    
+    void notify_checked_changed() {
+        if (on_checked_changed_) {
+            on_checked_changed_(checked_);
+        }
+        checked_changed_.emit(checked_);
+    }
     
 public:
     CheckBox() {
@@ -38,16 +49,27 @@ public:
         set_background(Color::transparent());
         set_foreground(Color::black());
         
-        label_style_.font_size = 12.0f;
-        label_style_.align = TextAlign::left;
-        label_style_.valign = TextVAlign::middle;
+        TextStyle style;
+        style.font_size = 12.0f;
+        style.align = TextAlign::left;
+        style.valign = TextVAlign::middle;
+        label_style_ = style;
     }
     
-    explicit CheckBox(const std::wstring& label) : CheckBox() {
+    explicit CheckBox(std::string_view label) : CheckBox() {
         label_ = label;
     }
     
-    CheckBox(const std::wstring& label, bool checked) : CheckBox(label) {
+    explicit CheckBox(std::wstring_view label) : CheckBox() {
+        label_ = utf8::from_wide(label);
+    }
+    
+    CheckBox(std::string_view label, bool checked) : CheckBox(label) {
+        checked_ = checked;
+        state_ = checked ? 1 : 0;
+    }
+    
+    CheckBox(std::wstring_view label, bool checked) : CheckBox(label) {
         checked_ = checked;
         state_ = checked ? 1 : 0;
     }
@@ -60,9 +82,7 @@ public:
             state_ = checked ? 1 : 0;
             mark_dirty();
             
-            if (on_checked_changed_) {
-                on_checked_changed_(checked_);
-            }
+            notify_checked_changed();
         }
     }
     
@@ -84,9 +104,7 @@ public:
             checked_ = (state_ == 1);
             mark_dirty();
             
-            if (on_checked_changed_) {
-                on_checked_changed_(checked_);
-            }
+            notify_checked_changed();
         }
     }
     
@@ -94,21 +112,40 @@ public:
     
     // === Label ===
     
-    void set_label(const std::wstring& label) {
+    void set_label(std::string_view label) {
         if (label_ != label) {
             label_ = label;
-            mark_dirty();
+            invalidate_layout();
         }
     }
     
-    const std::wstring& label() const { return label_; }
+    void set_label(std::wstring_view label) {
+        set_label(std::string_view(utf8::from_wide(label)));
+    }
+    
+    /**
+     * @brief The label as stored, UTF-8
+     */
+    const std::string& utf8_label() const { return label_; }
+    
+    std::wstring label() const { return utf8::to_wide(label_); }
     
     void set_label_style(const TextStyle& style) {
         label_style_ = style;
         mark_dirty();
     }
     
-    const TextStyle& label_style() const { return label_style_; }
+    const TextStyle& label_style() const { return *label_style_; }
+    
+    /**
+     * @brief Share an interned style with other widgets
+     */
+    void set_shared_label_style(TextStyleRef style) {
+        label_style_ = std::move(style);
+        mark_dirty();
+    }
+    
+    const TextStyleRef& shared_label_style() const { return label_style_; }
     
     // === Callbacks ===
     
@@ -116,6 +153,11 @@ public:
         on_checked_changed_ = std::move(callback);
     }
     
+    /**
+     * @brief Multi-subscriber variant of set_on_checked_changed
+     */
+    Signal<bool>& checked_changed() { return checked_changed_; }
+    
     // === Appearance ===
     
     void set_box_size(float size) {
@@ -127,6 +169,12 @@ public:
     
     // === Widget Interface ===
     
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        out.strings += string_heap_bytes(label_);
+    }
+    
     void draw(Canvas& canvas) override {
         float y_center = height() / 2.0f;
         
@@ -186,7 +234,7 @@ public:
             };
             
             Color text_color = is_enabled() ? foreground() : Color(128, 128, 128, 255);
-            canvas.draw_text(label_, label_rect, text_color, label_style_);
+            canvas.draw_text(std::string_view(label_), label_rect, text_color, *label_style_);
         }
     }
     
@@ -216,9 +264,7 @@ public:
             
             mark_dirty();
             
-            if (on_checked_changed_) {
-                on_checked_changed_(checked_);
-            }
+            notify_checked_changed();
             
             return true;
         }
@@ -229,8 +275,12 @@ public:
 /**
  * @brief Helper to create checkbox
  */
-inline WidgetPtr make_checkbox(const std::wstring& label, bool checked = false) {
-    return std::make_shared<CheckBox>(label, checked);
+inline WidgetPtr make_checkbox(std::string_view label, bool checked = false) {
+    return make_widget<CheckBox>(label, checked);
+}
+
+inline WidgetPtr make_checkbox(std::wstring_view label, bool checked = false) {
+    return make_widget<CheckBox>(label, checked);
 }
 
 } // namespace zuu::widget
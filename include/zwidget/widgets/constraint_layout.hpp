@@ -0,0 +1,292 @@
+#pragma once
+
+/**
+ * @file constraint_layout.hpp
+ * @brief Anchored layout: child edges are solved from linear constraints
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Every child gets left/top/width/height variables, and the
+ * container's own inner rect is four edit variables. Constraints such as
+ * "button.right == container.right - 8" or "a.width == 2 * b.width | weak"
+ * are added once; a resize then only suggests new container values to the
+ * incremental solver instead of rebuilding the system.
+ */
+
+#include "zwidget/core/constraint_solver.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Edge variables of one rectangle
+ */
+struct LayoutAnchors {
+    LayoutVariable left;
+    LayoutVariable top;
+    LayoutVariable width;
+    LayoutVariable height;
+
+    LayoutExpression right() const { return left + width; }
+    LayoutExpression bottom() const { return top + height; }
+    LayoutExpression center_x() const { return left + width / 2.0; }
+    LayoutExpression center_y() const { return top + height / 2.0; }
+
+    bool references(const LayoutVariable& variable) const {
+        return variable.same(left) || variable.same(top) ||
+               variable.same(width) || variable.same(height);
+    }
+};
+
+/**
+ * @brief Container whose children are placed by a constraint system
+ * anchors() is the inner rect (inside padding); children default weakly to
+ * their preferred size and never get a negative size. A child's width and
+ * height are weak edit variables that follow its preferred size whenever
+ * that is set. Children are relayout boundaries: their measure does not
+ * feed the solver.
+ */
+class ConstraintLayout : public LayoutContainer {
+private:
+    struct Slot {
+        LayoutAnchors anchors;
+        std::vector<LayoutConstraint> defaults;  // Non-negative size
+        Sizef preferred{0, 0};                   // Last suggested for width and height
+    };
+
+    ConstraintSolver solver_;
+    LayoutAnchors self_;
+    std::vector<Slot> slots_;
+    std::vector<LayoutConstraint> constraints_;  // Added through add_constraint()
+    Rectf suggested_{0, 0, 0, 0};                // Inner rect last given to the solver
+
+    size_t index_of(const Widget* child) const {
+        auto it = std::find_if(children_.begin(), children_.end(),
+            [child](const WidgetPtr& ptr) { return ptr.get() == child; });
+        return static_cast<size_t>(it - children_.begin());
+    }
+
+    void attach(size_t index) {
+        Slot& slot = slots_[index];
+
+        slot.defaults = {
+            slot.anchors.width >= 0.0,
+            slot.anchors.height >= 0.0,
+        };
+        for (const auto& constraint : slot.defaults) {
+            solver_.add_constraint(constraint);
+        }
+        solver_.add_edit_variable(slot.anchors.width, strength::weak);
+        solver_.add_edit_variable(slot.anchors.height, strength::weak);
+        suggest_preferred(slot, children_[index]->preferred_size());
+    }
+
+    /**
+     * @brief Drop the slot's defaults and every user constraint naming it
+     */
+    void detach(const Slot& slot) {
+        solver_.remove_edit_variable(slot.anchors.width);
+        solver_.remove_edit_variable(slot.anchors.height);
+        for (const auto& constraint : slot.defaults) {
+            solver_.remove_constraint(constraint);
+        }
+
+        auto mentions = [&slot](const LayoutConstraint& constraint) {
+            const auto& terms = constraint.expression().terms();
+            return std::any_of(terms.begin(), terms.end(), [&slot](const LayoutTerm& term) {
+                return slot.anchors.references(term.variable);
+            });
+        };
+
+        auto end = std::remove_if(constraints_.begin(), constraints_.end(),
+                                  [&](const LayoutConstraint& constraint) {
+                                      if (!mentions(constraint)) return false;
+                                      solver_.remove_constraint(constraint);
+                                      return true;
+                                  });
+        constraints_.erase(end, constraints_.end());
+    }
+
+    void suggest(const LayoutVariable& variable, float& last, float value) {
+        if (last == value) return;
+        last = value;
+        solver_.suggest_value(variable, value);
+    }
+
+    void suggest_preferred(Slot& slot, const Sizef& preferred) {
+        suggest(slot.anchors.width, slot.preferred.w, preferred.w);
+        suggest(slot.anchors.height, slot.preferred.h, preferred.h);
+    }
+
+protected:
+    bool uses_child_measure(const Widget&) const override { return false; }
+
+    /**
+     * @brief Move the child's size edits to its new preferred size
+     */
+    void child_size_changed(Widget& child) override {
+        size_t index = index_of(&child);
+        if (index >= slots_.size() || slots_[index].preferred == child.preferred_size()) return;
+
+        suggest_preferred(slots_[index], child.preferred_size());
+        invalidate_layout();
+    }
+
+    /**
+     * @brief Suggest only the container edges that changed, then place children
+     */
+    void arrange_content() override {
+        Sizef inner = inner_size(size());
+        suggest(self_.left, suggested_.pos.x, padding_);
+        suggest(self_.top, suggested_.pos.y, padding_);
+        suggest(self_.width, suggested_.size.w, inner.w);
+        suggest(self_.height, suggested_.size.h, inner.h);
+        solver_.update_variables();
+
+        for (size_t i = 0; i < children_.size(); ++i) {
+            if (!children_[i]->is_visible()) continue;
+
+            const LayoutAnchors& a = slots_[i].anchors;
+            arrange_child(*children_[i], Rectf{static_cast<float>(a.left.value()),
+                                               static_cast<float>(a.top.value()),
+                                               static_cast<float>(a.width.value()),
+                                               static_cast<float>(a.height.value())});
+        }
+    }
+
+public:
+    ConstraintLayout() {
+        solver_.add_edit_variable(self_.left, strength::strong);
+        solver_.add_edit_variable(self_.top, strength::strong);
+        solver_.add_edit_variable(self_.width, strength::strong);
+        solver_.add_edit_variable(self_.height, strength::strong);
+    }
+
+    // === Anchors ===
+
+    /**
+     * @brief The container's inner rect
+     */
+    const LayoutAnchors& anchors() const { return self_; }
+
+    /**
+     * @brief A child's edges; the child must belong to this layout
+     */
+    const LayoutAnchors& anchors(const Widget* child) const {
+        return slots_[index_of(child)].anchors;
+    }
+
+    // === Constraints ===
+
+    /**
+     * @brief Add a constraint; throws std::runtime_error if a required one conflicts
+     */
+    void add_constraint(const LayoutConstraint& constraint) {
+        solver_.add_constraint(constraint);
+        constraints_.push_back(constraint);
+        invalidate_layout();
+    }
+
+    void add_constraints(std::initializer_list<LayoutConstraint> constraints) {
+        for (const auto& constraint : constraints) {
+            add_constraint(constraint);
+        }
+    }
+
+    void remove_constraint(const LayoutConstraint& constraint) {
+        auto it = std::find_if(constraints_.begin(), constraints_.end(),
+                               [&](const LayoutConstraint& c) { return c.id() == constraint.id(); });
+        if (it == constraints_.end()) return;
+
+        solver_.remove_constraint(constraint);
+        constraints_.erase(it);
+        invalidate_layout();
+    }
+
+    size_t constraint_count() const { return constraints_.size(); }
+
+    /**
+     * @brief Make a variable adjustable from code, e.g. a splitter position
+     */
+    void add_edit_variable(const LayoutVariable& variable, double strength = strength::strong) {
+        solver_.add_edit_variable(variable, strength);
+    }
+
+    void suggest_value(const LayoutVariable& variable, double value) {
+        solver_.suggest_value(variable, value);
+        invalidate_layout();
+    }
+
+    // === Children ===
+
+    void add_child(WidgetPtr child) override {
+        size_t before = children_.size();
+        LayoutContainer::add_child(std::move(child));
+        if (children_.size() != before) {
+            slots_.emplace_back();
+            attach(before);
+        }
+    }
+
+    void insert_child(size_t index, WidgetPtr child) override {
+        size_t before = children_.size();
+        index = std::min(index, before);
+        LayoutContainer::insert_child(index, std::move(child));
+        if (children_.size() != before) {
+            slots_.insert(slots_.begin() + static_cast<ptrdiff_t>(index), Slot{});
+            attach(index);
+        }
+    }
+
+    void move_child(Widget* child, size_t index) override {
+        size_t from = index_of(child);
+        if (from == children_.size()) return;
+
+        Slot slot = std::move(slots_[from]);
+        slots_.erase(slots_.begin() + static_cast<ptrdiff_t>(from));
+        slots_.insert(slots_.begin() + static_cast<ptrdiff_t>(std::min(index, slots_.size())), std::move(slot));
+        LayoutContainer::move_child(child, index);
+    }
+
+    void reorder_children(std::span<const size_t> order) override {
+        if (!is_permutation_of_children(order)) return;
+
+        permute(slots_, order);
+        LayoutContainer::reorder_children(order);
+    }
+
+    void remove_child(Widget* child) override {
+        size_t index = index_of(child);
+        if (index == children_.size()) return;
+
+        detach(slots_[index]);
+        slots_.erase(slots_.begin() + static_cast<ptrdiff_t>(index));
+        LayoutContainer::remove_child(child);
+    }
+
+    // === Widget Interface ===
+
+    void measure_memory(WidgetMemory& out) const override {
+        LayoutContainer::measure_memory(out);
+        out.object = sizeof(*this);
+        out.other += slots_.capacity() * sizeof(Slot) + constraints_.capacity() * sizeof(LayoutConstraint);
+        out.other += solver_.heap_bytes();
+        for (const Slot& slot : slots_) {
+            out.other += slot.defaults.capacity() * sizeof(LayoutConstraint);
+        }
+    }
+};
+
+/**
+ * @brief Helper to create constraint layouts
+ */
+inline std::shared_ptr<ConstraintLayout> make_constraint_layout(float padding = 0.0f) {
+    auto layout = make_widget<ConstraintLayout>();
+    layout->set_padding(padding);
+    return layout;
+}
+
+} // namespace zuu::widget
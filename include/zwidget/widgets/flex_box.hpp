@@ -0,0 +1,461 @@
+#pragma once
+
+/**
+ * @file flex_box.hpp
+ * @brief Flexible box container: grow/shrink/basis, wrapping, justify and align
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Follows the CSS flexbox algorithm for one main axis: items start
+ * at their basis (or measured size), lines are broken when wrapping, and
+ * each line's free space is handed out by grow or shrink factors with
+ * min/max clamping. Per-child properties live in a list parallel to the
+ * children that also holds the per-pass scratch values, so a layout pass
+ * does not allocate.
+ */
+
+#include "zwidget/widgets/layout.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <optional>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Main axis of a FlexBox
+ */
+enum class FlexDirection : uint8_t {
+    row,     // Left to right
+    column   // Top to bottom
+};
+
+/**
+ * @brief Distribution of leftover main-axis space within a line
+ */
+enum class FlexJustify : uint8_t {
+    start,
+    end,
+    center,
+    space_between,
+    space_around,
+    space_evenly
+};
+
+/**
+ * @brief Flex properties of one child
+ */
+struct FlexItem {
+    static constexpr float auto_basis = -1.0f;
+
+    float grow = 0.0f;                      // Share of positive free space
+    float shrink = 1.0f;                    // Share of negative free space (weighted by basis)
+    float basis = auto_basis;               // Initial main size; auto_basis uses the measured size
+    std::optional<LayoutAlign> align_self{};  // Overrides the container's align-items
+};
+
+/**
+ * @brief Container placing children along a main axis with flex factors
+ * spacing() is the gap between items, line_spacing() the gap between
+ * wrapped lines, and alignment() acts as align-items.
+ */
+class FlexBox : public LayoutContainer {
+private:
+    struct Slot {
+        FlexItem item;
+        float base = 0.0f;    // Hypothetical main size
+        float main = 0.0f;    // Resolved main size
+        float cross = 0.0f;   // Desired cross size
+        float min_main = 0.0f;
+        float max_main = 0.0f;
+        bool frozen = false;
+    };
+
+    struct Line {
+        size_t first = 0;     // Child range [first, last)
+        size_t last = 0;
+        size_t count = 0;     // Visible children in the range
+        float base = 0.0f;    // Sum of base sizes
+        float cross = 0.0f;
+    };
+
+    std::vector<Slot> slots_;  // Parallel to children_
+    std::vector<Line> lines_;  // Reused across passes
+
+    FlexDirection direction_ = FlexDirection::row;
+    FlexJustify justify_ = FlexJustify::start;
+    float line_spacing_ = 0.0f;
+    bool wrap_ = false;
+
+    // === Axis Helpers ===
+
+    bool is_row() const { return direction_ == FlexDirection::row; }
+    float main_of(const Sizef& s) const { return is_row() ? s.w : s.h; }
+    float cross_of(const Sizef& s) const { return is_row() ? s.h : s.w; }
+    Sizef make_size(float main, float cross) const {
+        return is_row() ? Sizef{main, cross} : Sizef{cross, main};
+    }
+
+    size_t index_of(const Widget* child) const {
+        auto it = std::find_if(children_.begin(), children_.end(),
+            [child](const WidgetPtr& ptr) { return ptr.get() == child; });
+        return static_cast<size_t>(it - children_.begin());
+    }
+
+    float gaps(size_t count) const {
+        return count > 1 ? spacing_ * static_cast<float>(count - 1) : 0.0f;
+    }
+
+    /**
+     * @brief Split visible children into lines and fill base/cross sizes
+     */
+    void collect_lines(const Sizef& measure_space, float line_limit) {
+        lines_.clear();
+        Line line;
+
+        for (size_t i = 0; i < children_.size(); ++i) {
+            Widget& child = *children_[i];
+            if (!child.is_visible()) continue;
+
+            Slot& slot = slots_[i];
+            Sizef desired = child.measure(measure_space);
+            slot.min_main = std::max(0.0f, main_of(child.min_size()));
+            slot.max_main = std::max(slot.min_main, main_of(child.max_size()));
+            slot.base = std::clamp(slot.item.basis >= 0.0f ? slot.item.basis : main_of(desired),
+                                   slot.min_main, slot.max_main);
+            slot.cross = cross_of(desired);
+
+            if (wrap_ && line.count > 0 && line.base + spacing_ * line.count + slot.base > line_limit) {
+                line.last = i;
+                lines_.push_back(line);
+                line = Line{i, i, 0, 0.0f, 0.0f};
+            }
+
+            if (line.count == 0) line.first = i;
+            line.base += slot.base;
+            line.cross = std::max(line.cross, slot.cross);
+            line.count++;
+        }
+
+        if (line.count > 0) {
+            line.last = children_.size();
+            lines_.push_back(line);
+        }
+    }
+
+    /**
+     * @brief Resolve flexible lengths of one line (CSS flexbox 9.7)
+     * Repeatedly distributes free space among unfrozen items and freezes
+     * those clamped by min/max, until nothing is clamped.
+     * @return Main-axis space used by the line, gaps included
+     */
+    float resolve_line(const Line& line, float inner_main) {
+        float free = inner_main - line.base - gaps(line.count);
+        bool growing = free > 0.0f;
+        size_t flexible = 0;
+
+        for (size_t i = line.first; i < line.last; ++i) {
+            if (!children_[i]->is_visible()) continue;
+            Slot& slot = slots_[i];
+            slot.main = slot.base;
+            slot.frozen = free == 0.0f || (growing ? slot.item.grow <= 0.0f : slot.item.shrink <= 0.0f);
+            if (!slot.frozen) flexible++;
+        }
+
+        if (flexible == 0) {
+            return line.base + gaps(line.count);
+        }
+
+        for (size_t round = 0; round < flexible; ++round) {
+            float remaining = inner_main - gaps(line.count);
+            float factors = 0.0f;
+
+            for (size_t i = line.first; i < line.last; ++i) {
+                if (!children_[i]->is_visible()) continue;
+                const Slot& slot = slots_[i];
+                if (slot.frozen) {
+                    remaining -= slot.main;
+                } else {
+                    remaining -= slot.base;
+                    factors += growing ? slot.item.grow : slot.item.shrink * slot.base;
+                }
+            }
+
+            if (factors <= 0.0f) break;
+
+            // Factors summing below 1 hand out only that fraction of the space
+            if (growing && factors < 1.0f) {
+                remaining *= factors;
+            }
+
+            float violation = 0.0f;
+            for (size_t i = line.first; i < line.last; ++i) {
+                if (!children_[i]->is_visible()) continue;
+                Slot& slot = slots_[i];
+                if (slot.frozen) continue;
+
+                float factor = growing ? slot.item.grow : slot.item.shrink * slot.base;
+                float target = slot.base + remaining * factor / factors;
+                float clamped = std::clamp(target, slot.min_main, slot.max_main);
+                violation += clamped - target;
+                slot.main = clamped;
+            }
+
+            if (violation == 0.0f) break;
+
+            // Freeze the items clamped in the direction of the total violation
+            for (size_t i = line.first; i < line.last; ++i) {
+                if (!children_[i]->is_visible()) continue;
+                Slot& slot = slots_[i];
+                if (slot.frozen) continue;
+
+                if (violation > 0.0f ? slot.main <= slot.min_main : slot.main >= slot.max_main) {
+                    slot.frozen = true;
+                }
+            }
+        }
+
+        float used = gaps(line.count);
+        for (size_t i = line.first; i < line.last; ++i) {
+            if (children_[i]->is_visible()) used += slots_[i].main;
+        }
+        return used;
+    }
+
+protected:
+    Sizef measure_content(const Sizef& available) override {
+        Sizef inner = inner_size(available);
+        collect_lines(inner, main_of(inner));
+
+        float main = 0.0f;
+        float cross = 0.0f;
+        for (const Line& line : lines_) {
+            main = std::max(main, line.base + gaps(line.count));
+            cross += line.cross;
+        }
+        if (lines_.size() > 1) {
+            cross += line_spacing_ * static_cast<float>(lines_.size() - 1);
+        }
+
+        Sizef content = make_size(main + padding_ * 2, cross + padding_ * 2);
+        return Sizef{std::max(preferred_size().w, content.w),
+                     std::max(preferred_size().h, content.h)};
+    }
+
+    void arrange_content() override {
+        float inner_main = std::max(0.0f, main_of(size()) - padding_ * 2);
+        float inner_cross = std::max(0.0f, cross_of(size()) - padding_ * 2);
+
+        // Same space the children were measured with, so their measures are cache hits
+        collect_lines(inner_size(measured_available_), inner_main);
+        if (lines_.empty()) return;
+
+        if (!wrap_) {
+            lines_.front().cross = inner_cross;
+        }
+
+        float cross_pos = padding_;
+        for (const Line& line : lines_) {
+            float used = resolve_line(line, inner_main);
+            float free = std::max(0.0f, inner_main - used);
+            float offset = 0.0f;
+            float between = 0.0f;
+            auto n = static_cast<float>(line.count);
+
+            switch (justify_) {
+                case FlexJustify::start:
+                    break;
+                case FlexJustify::end:
+                    offset = free;
+                    break;
+                case FlexJustify::center:
+                    offset = free / 2.0f;
+                    break;
+                case FlexJustify::space_between:
+                    between = line.count > 1 ? free / (n - 1.0f) : 0.0f;
+                    break;
+                case FlexJustify::space_around:
+                    between = free / n;
+                    offset = between / 2.0f;
+                    break;
+                case FlexJustify::space_evenly:
+                    between = free / (n + 1.0f);
+                    offset = between;
+                    break;
+            }
+
+            float main_pos = padding_ + offset;
+            for (size_t i = line.first; i < line.last; ++i) {
+                Widget& child = *children_[i];
+                if (!child.is_visible()) continue;
+
+                const Slot& slot = slots_[i];
+                LayoutAlign align = slot.item.align_self.value_or(alignment_);
+
+                float cross = slot.cross;
+                float cross_offset = 0.0f;
+                switch (align) {
+                    case LayoutAlign::start:
+                        break;
+                    case LayoutAlign::center:
+                        cross_offset = (line.cross - cross) / 2.0f;
+                        break;
+                    case LayoutAlign::end:
+                        cross_offset = line.cross - cross;
+                        break;
+                    case LayoutAlign::stretch:
+                        cross = std::clamp(line.cross, cross_of(child.min_size()),
+                                           std::max(cross_of(child.min_size()), cross_of(child.max_size())));
+                        break;
+                }
+
+                Pointf pos = is_row() ? Pointf{main_pos, cross_pos + cross_offset}
+                                      : Pointf{cross_pos + cross_offset, main_pos};
+                arrange_child(child, Rectf{pos, make_size(slot.main, cross)});
+
+                main_pos += slot.main + spacing_ + between;
+            }
+
+            cross_pos += line.cross + line_spacing_;
+        }
+    }
+
+public:
+    explicit FlexBox(FlexDirection direction = FlexDirection::row) : direction_(direction) {}
+
+    // === Children ===
+
+    void add_child(WidgetPtr child) override {
+        add_child(std::move(child), FlexItem{});
+    }
+
+    /**
+     * @brief Add a child with its flex properties
+     */
+    void add_child(WidgetPtr child, const FlexItem& item) {
+        size_t before = children_.size();
+        LayoutContainer::add_child(std::move(child));
+        if (children_.size() != before) {
+            slots_.push_back(Slot{item});
+            lines_.reserve(children_.size());
+        }
+    }
+
+    void insert_child(size_t index, WidgetPtr child) override {
+        size_t before = children_.size();
+        index = std::min(index, before);
+        LayoutContainer::insert_child(index, std::move(child));
+        if (children_.size() != before) {
+            slots_.insert(slots_.begin() + static_cast<ptrdiff_t>(index), Slot{});
+            lines_.reserve(children_.size());
+        }
+    }
+
+    void move_child(Widget* child, size_t index) override {
+        size_t from = index_of(child);
+        if (from == children_.size()) return;
+
+        Slot slot = slots_[from];
+        slots_.erase(slots_.begin() + static_cast<ptrdiff_t>(from));
+        slots_.insert(slots_.begin() + static_cast<ptrdiff_t>(std::min(index, slots_.size())), slot);
+        LayoutContainer::move_child(child, index);
+    }
+
+    void reorder_children(std::span<const size_t> order) override {
+        if (!is_permutation_of_children(order)) return;
+
+        permute(slots_, order);
+        LayoutContainer::reorder_children(order);
+    }
+
+    void remove_child(Widget* child) override {
+        size_t index = index_of(child);
+        if (index == children_.size()) return;
+
+        slots_.erase(slots_.begin() + static_cast<ptrdiff_t>(index));
+        LayoutContainer::remove_child(child);
+    }
+
+    /**
+     * @brief Change the flex properties of a child
+     */
+    void set_flex(const Widget* child, const FlexItem& item) {
+        size_t index = index_of(child);
+        if (index == children_.size()) return;
+
+        slots_[index].item = item;
+        invalidate_layout();
+    }
+
+    /**
+     * @brief Flex properties of a child (defaults if it is not a child)
+     */
+    const FlexItem& flex(const Widget* child) const {
+        static const FlexItem defaults;
+        size_t index = index_of(child);
+        return index < slots_.size() ? slots_[index].item : defaults;
+    }
+
+    // === Container Properties ===
+
+    void set_direction(FlexDirection direction) {
+        direction_ = direction;
+        invalidate_layout();
+    }
+
+    FlexDirection direction() const { return direction_; }
+
+    void set_justify(FlexJustify justify) {
+        justify_ = justify;
+        invalidate_layout();
+    }
+
+    FlexJustify justify() const { return justify_; }
+
+    void set_wrap(bool wrap) {
+        wrap_ = wrap;
+        invalidate_layout();
+    }
+
+    bool wrap() const { return wrap_; }
+
+    void set_line_spacing(float spacing) {
+        line_spacing_ = spacing;
+        invalidate_layout();
+    }
+
+    float line_spacing() const { return line_spacing_; }
+
+    /**
+     * @brief Same gap between items and between lines
+     */
+    void set_gap(float gap) {
+        spacing_ = gap;
+        line_spacing_ = gap;
+        invalidate_layout();
+    }
+
+    // === Widget Interface ===
+
+    void measure_memory(WidgetMemory& out) const override {
+        LayoutContainer::measure_memory(out);
+        out.object = sizeof(*this);
+        out.other += slots_.capacity() * sizeof(Slot) + lines_.capacity() * sizeof(Line);
+    }
+};
+
+/**
+ * @brief Helper to create flex containers
+ */
+inline std::shared_ptr<FlexBox> make_flex_box(FlexDirection direction = FlexDirection::row) {
+    return make_widget<FlexBox>(direction);
+}
+
+inline std::shared_ptr<FlexBox> make_flex_box(FlexDirection direction, float gap, float padding = 0.0f) {
+    auto box = make_widget<FlexBox>(direction);
+    box->set_gap(gap);
+    box->set_padding(padding);
+    return box;
+}
+
+} // namespace zuu::widget
@@ -0,0 +1,527 @@
+#pragma once
+
+/**
+ * @file grid.hpp
+ * @brief Grid container with fixed, auto, fractional and minmax tracks
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Children are placed in cells that may span several rows and
+ * columns. Track sizing runs in two steps: base sizes from the content of
+ * auto tracks (cached until that content changes), then the leftover space
+ * is handed to fractional tracks for the actual size. A child whose cell
+ * only crosses fixed and fractional tracks is stretched to the cell, so it
+ * is a relayout boundary: its content changes never reach the grid.
+ */
+
+#include "zwidget/widgets/layout.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Sizing rule of one row or column
+ */
+struct GridTrack {
+    float min = 0.0f;      // Lower bound
+    float max = FLT_MAX;   // Upper bound
+    float fr = 0.0f;       // Share of leftover space; > 0 makes the track flexible
+    bool content = false;  // Grows to fit the items placed in it
+
+    /**
+     * @brief Exactly size
+     */
+    static constexpr GridTrack fixed(float size) { return GridTrack{size, size, 0.0f, false}; }
+
+    /**
+     * @brief Fits its largest item
+     */
+    static constexpr GridTrack automatic() { return GridTrack{0.0f, FLT_MAX, 0.0f, true}; }
+
+    /**
+     * @brief Share of the space left by the other tracks, never below min
+     * Content is ignored: a fractional track's desired size is its min.
+     */
+    static constexpr GridTrack fraction(float fr, float min = 0.0f) { return GridTrack{min, FLT_MAX, fr, false}; }
+
+    /**
+     * @brief Fits its content, clamped to [min, max]
+     */
+    static constexpr GridTrack minmax(float min, float max) { return GridTrack{min, max, 0.0f, true}; }
+};
+
+/**
+ * @brief Placement of one child
+ */
+struct GridCell {
+    size_t row = 0;
+    size_t column = 0;
+    size_t row_span = 1;
+    size_t column_span = 1;
+    std::optional<LayoutAlign> align{};  // Overrides the grid's alignment() in both axes
+};
+
+/**
+ * @brief Container placing children on rows and columns
+ * spacing() separates columns, row_spacing() separates rows. Cells that
+ * reference tracks past the end add automatic tracks. alignment() defaults
+ * to stretch.
+ */
+class Grid : public LayoutContainer {
+private:
+    struct Track {
+        GridTrack spec;
+        float base = 0.0f;    // Size from content (or min)
+        float size = 0.0f;    // Final size for the current bounds
+        float offset = 0.0f;  // Start, relative to the content box
+        bool frozen = false;  // Excluded from the fractional distribution
+    };
+
+    struct Slot {
+        GridCell cell;
+        Sizef contribution;     // Desired size used for the cached base sizes
+        bool counted = false;   // Was visible and in a content track last time
+        bool content = false;   // Crosses a content track
+    };
+
+    std::vector<Track> columns_;
+    std::vector<Track> rows_;
+    std::vector<Slot> slots_;  // Parallel to children_
+    std::unordered_map<const Widget*, size_t> slot_index_;  // Child to its index in slots_
+
+    float row_spacing_ = 0.0f;
+    Sizef bases_spacing_;       // Gaps the cached base sizes were computed with
+    bool bases_valid_ = false;
+
+    // === Track Helpers ===
+
+    static bool crosses_content(const std::vector<Track>& tracks, size_t first, size_t span) {
+        for (size_t i = first; i < first + span && i < tracks.size(); ++i) {
+            if (tracks[i].spec.content) return true;
+        }
+        return false;
+    }
+
+    void classify(Slot& slot) const {
+        slot.content = crosses_content(columns_, slot.cell.column, slot.cell.column_span) ||
+                       crosses_content(rows_, slot.cell.row, slot.cell.row_span);
+    }
+
+    /**
+     * @brief Add automatic tracks so the cell fits
+     */
+    void grow_tracks(const GridCell& cell) {
+        size_t columns = cell.column + std::max<size_t>(cell.column_span, 1);
+        size_t rows = cell.row + std::max<size_t>(cell.row_span, 1);
+        if (columns > columns_.size()) columns_.resize(columns, Track{GridTrack::automatic()});
+        if (rows > rows_.size()) rows_.resize(rows, Track{GridTrack::automatic()});
+    }
+
+    void tracks_changed() {
+        for (auto& slot : slots_) {
+            classify(slot);
+        }
+        bases_valid_ = false;
+        invalidate_layout();
+    }
+
+    /**
+     * @brief Normalize and classify the cell of slot i
+     * New tracks are only referenced by this slot, so the others keep their class.
+     */
+    void place(size_t index, const GridCell& cell) {
+        Slot& slot = slots_[index];
+        slot.cell = cell;
+        slot.cell.row_span = std::max<size_t>(slot.cell.row_span, 1);
+        slot.cell.column_span = std::max<size_t>(slot.cell.column_span, 1);
+        grow_tracks(slot.cell);
+        classify(slot);
+        bases_valid_ = false;
+    }
+
+    /**
+     * @brief Index of a child in children_ and slots_, or children_.size()
+     * O(1), so per-child invalidations stay linear in a burst of changes.
+     */
+    size_t index_of(const Widget* child) const {
+        auto it = slot_index_.find(child);
+        return it != slot_index_.end() ? it->second : children_.size();
+    }
+
+    /**
+     * @brief Renumber slot_index_ from first on, after children shifted
+     */
+    void reindex(size_t first) {
+        for (size_t i = first; i < children_.size(); ++i) {
+            slot_index_[children_[i].get()] = i;
+        }
+    }
+
+    static float span_size(const std::vector<Track>& tracks, size_t first, size_t span, float gap, float Track::*field) {
+        float total = 0.0f;
+        size_t last = std::min(first + std::max<size_t>(span, 1), tracks.size());
+        for (size_t i = first; i < last; ++i) {
+            total += tracks[i].*field;
+        }
+        return total + gap * static_cast<float>(last > first ? last - first - 1 : 0);
+    }
+
+    /**
+     * @brief Base sizes of one axis from the contributions of content items
+     * Single-track items first; spanning items then spread what is still
+     * missing evenly over the content tracks they cross. As in CSS, items
+     * spanning a fractional track do not size content tracks.
+     */
+    void compute_bases(std::vector<Track>& tracks, float gap, bool columns) {
+        for (auto& track : tracks) {
+            track.base = track.spec.min;
+        }
+
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                const Slot& slot = slots_[i];
+                if (!slot.counted) continue;
+
+                size_t first = columns ? slot.cell.column : slot.cell.row;
+                size_t span = std::max<size_t>(columns ? slot.cell.column_span : slot.cell.row_span, 1);
+                float want = columns ? slot.contribution.w : slot.contribution.h;
+
+                if (pass == 0 && span == 1) {
+                    Track& track = tracks[first];
+                    if (track.spec.content) {
+                        track.base = std::max(track.base, std::min(want, track.spec.max));
+                    }
+                } else if (pass == 1 && span > 1) {
+                    float missing = want - span_size(tracks, first, span, gap, &Track::base);
+                    size_t growable = 0;
+                    bool flexible = false;
+                    for (size_t t = first; t < first + span; ++t) {
+                        if (tracks[t].spec.content) growable++;
+                        if (tracks[t].spec.fr > 0.0f) flexible = true;
+                    }
+                    if (missing <= 0.0f || growable == 0 || flexible) continue;
+
+                    for (size_t t = first; t < first + span; ++t) {
+                        Track& track = tracks[t];
+                        if (track.spec.content) {
+                            track.base = std::min(track.base + missing / static_cast<float>(growable), track.spec.max);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Recompute base sizes only if a content item changed
+     * @param measure_space Available size the children are measured with
+     */
+    void update_bases(const Sizef& measure_space) {
+        bool changed = !bases_valid_ || bases_spacing_ != Sizef{spacing_, row_spacing_};
+
+        for (size_t i = 0; i < children_.size(); ++i) {
+            Slot& slot = slots_[i];
+            bool counted = slot.content && children_[i]->is_visible();
+
+            if (counted) {
+                Sizef desired = children_[i]->measure(measure_space);
+                if (!slot.counted || desired != slot.contribution) {
+                    slot.contribution = desired;
+                    changed = true;
+                }
+            } else if (slot.counted) {
+                changed = true;
+            }
+            slot.counted = counted;
+        }
+
+        if (changed) {
+            compute_bases(columns_, spacing_, true);
+            compute_bases(rows_, row_spacing_, false);
+            bases_spacing_ = Sizef{spacing_, row_spacing_};
+            bases_valid_ = true;
+        }
+    }
+
+    /**
+     * @brief Final sizes and offsets: leftover space goes to fractional tracks
+     * Tracks whose share would fall below their base keep the base and drop
+     * out of the distribution.
+     */
+    static void resolve(std::vector<Track>& tracks, float available, float gap) {
+        float fr_total = 0.0f;
+        float fixed = gap * static_cast<float>(tracks.empty() ? 0 : tracks.size() - 1);
+
+        for (auto& track : tracks) {
+            track.size = track.base;
+            track.frozen = track.spec.fr <= 0.0f;
+            if (track.frozen) {
+                fixed += track.base;
+            } else {
+                fr_total += track.spec.fr;
+            }
+        }
+
+        if (fr_total > 0.0f && available < FLT_MAX) {
+            float leftover = available - fixed;
+
+            for (;;) {
+                float unit = std::max(0.0f, leftover) / fr_total;
+                bool clamped = false;
+
+                for (auto& track : tracks) {
+                    if (!track.frozen && track.spec.fr * unit < track.base) {
+                        track.frozen = true;
+                        leftover -= track.base;
+                        fr_total -= track.spec.fr;
+                        clamped = true;
+                    }
+                }
+
+                if (!clamped || fr_total <= 0.0f) {
+                    for (auto& track : tracks) {
+                        if (!track.frozen) track.size = track.spec.fr * unit;
+                    }
+                    break;
+                }
+            }
+        }
+
+        float offset = 0.0f;
+        for (auto& track : tracks) {
+            track.offset = offset;
+            offset += track.size + gap;
+        }
+    }
+
+    static float total_base(const std::vector<Track>& tracks, float gap) {
+        float total = 0.0f;
+        for (const auto& track : tracks) {
+            total += track.base;
+        }
+        return total + gap * static_cast<float>(tracks.empty() ? 0 : tracks.size() - 1);
+    }
+
+protected:
+    Sizef measure_content(const Sizef& available) override {
+        update_bases(inner_size(available));
+
+        Sizef content{total_base(columns_, spacing_) + padding_ * 2,
+                      total_base(rows_, row_spacing_) + padding_ * 2};
+        return Sizef{std::max(preferred_size().w, content.w),
+                     std::max(preferred_size().h, content.h)};
+    }
+
+    void arrange_content() override {
+        Sizef measure_space = inner_size(measured_available_);
+        update_bases(measure_space);
+
+        resolve(columns_, std::max(0.0f, width() - padding_ * 2), spacing_);
+        resolve(rows_, std::max(0.0f, height() - padding_ * 2), row_spacing_);
+
+        for (size_t i = 0; i < children_.size(); ++i) {
+            Widget& child = *children_[i];
+            if (!child.is_visible()) continue;
+
+            const GridCell& cell = slots_[i].cell;
+            Rectf area{padding_ + columns_[cell.column].offset,
+                       padding_ + rows_[cell.row].offset,
+                       span_size(columns_, cell.column, cell.column_span, spacing_, &Track::size),
+                       span_size(rows_, cell.row, cell.row_span, row_spacing_, &Track::size)};
+
+            LayoutAlign align = cell.align.value_or(alignment_);
+            if (align == LayoutAlign::stretch) {
+                arrange_child(child, area);
+                continue;
+            }
+
+            Sizef desired = child.measure(measure_space);
+            float w = std::min(desired.w, area.width());
+            float h = std::min(desired.h, area.height());
+            float x = area.left();
+            float y = area.top();
+
+            if (align == LayoutAlign::center) {
+                x += (area.width() - w) / 2.0f;
+                y += (area.height() - h) / 2.0f;
+            } else if (align == LayoutAlign::end) {
+                x += area.width() - w;
+                y += area.height() - h;
+            }
+            arrange_child(child, Rectf{x, y, w, h});
+        }
+    }
+
+    bool uses_child_measure(const Widget& child) const override {
+        size_t index = index_of(&child);
+        if (index == slots_.size()) return true;
+
+        const Slot& slot = slots_[index];
+        return slot.content || slot.cell.align.value_or(alignment_) != LayoutAlign::stretch;
+    }
+
+public:
+    Grid() {
+        alignment_ = LayoutAlign::stretch;
+    }
+
+    // === Tracks ===
+
+    void set_columns(std::vector<GridTrack> columns) {
+        columns_.clear();
+        for (const auto& spec : columns) {
+            columns_.push_back(Track{spec});
+        }
+        for (const auto& slot : slots_) {
+            grow_tracks(slot.cell);
+        }
+        tracks_changed();
+    }
+
+    void set_rows(std::vector<GridTrack> rows) {
+        rows_.clear();
+        for (const auto& spec : rows) {
+            rows_.push_back(Track{spec});
+        }
+        for (const auto& slot : slots_) {
+            grow_tracks(slot.cell);
+        }
+        tracks_changed();
+    }
+
+    size_t column_count() const { return columns_.size(); }
+    size_t row_count() const { return rows_.size(); }
+
+    /**
+     * @brief Size of a column/row from the last arrange
+     */
+    float column_width(size_t column) const { return columns_[column].size; }
+    float row_height(size_t row) const { return rows_[row].size; }
+
+    void set_row_spacing(float spacing) {
+        row_spacing_ = spacing;
+        invalidate_layout();
+    }
+
+    float row_spacing() const { return row_spacing_; }
+
+    /**
+     * @brief Same gap between columns and between rows
+     */
+    void set_gap(float gap) {
+        spacing_ = gap;
+        set_row_spacing(gap);
+    }
+
+    // === Children ===
+
+    void add_child(WidgetPtr child) override {
+        add_child(std::move(child), GridCell{});
+    }
+
+    /**
+     * @brief Add a child at a cell
+     */
+    void add_child(WidgetPtr child, const GridCell& cell) {
+        size_t before = children_.size();
+        LayoutContainer::add_child(std::move(child));
+        if (children_.size() == before) return;
+
+        slots_.emplace_back();
+        slot_index_.emplace(children_.back().get(), before);
+        place(before, cell);
+    }
+
+    void insert_child(size_t index, WidgetPtr child) override {
+        size_t before = children_.size();
+        index = std::min(index, before);
+        LayoutContainer::insert_child(index, std::move(child));
+        if (children_.size() == before) return;
+
+        slots_.insert(slots_.begin() + static_cast<ptrdiff_t>(index), Slot{});
+        reindex(index);
+        place(index, GridCell{});
+    }
+
+    void move_child(Widget* child, size_t index) override {
+        size_t from = index_of(child);
+        if (from == children_.size()) return;
+
+        // Order only affects paint order; cells stay with their widgets
+        Slot slot = slots_[from];
+        slots_.erase(slots_.begin() + static_cast<ptrdiff_t>(from));
+        slots_.insert(slots_.begin() + static_cast<ptrdiff_t>(std::min(index, slots_.size())), slot);
+        LayoutContainer::move_child(child, index);
+        reindex(std::min(from, index));
+    }
+
+    void reorder_children(std::span<const size_t> order) override {
+        if (!is_permutation_of_children(order)) return;
+
+        permute(slots_, order);
+        LayoutContainer::reorder_children(order);
+        reindex(0);
+    }
+
+    void remove_child(Widget* child) override {
+        size_t index = index_of(child);
+        if (index == children_.size()) return;
+
+        slots_.erase(slots_.begin() + static_cast<ptrdiff_t>(index));
+        slot_index_.erase(child);
+        LayoutContainer::remove_child(child);
+        reindex(index);
+        bases_valid_ = false;
+    }
+
+    /**
+     * @brief Move a child to another cell
+     */
+    void set_cell(const Widget* child, const GridCell& cell) {
+        size_t index = index_of(child);
+        if (index == children_.size()) return;
+
+        place(index, cell);
+        invalidate_layout();
+    }
+
+    /**
+     * @brief Cell of a child (row 0, column 0 if it is not a child)
+     */
+    GridCell cell(const Widget* child) const {
+        size_t index = index_of(child);
+        return index < slots_.size() ? slots_[index].cell : GridCell{};
+    }
+
+    // === Widget Interface ===
+
+    void measure_memory(WidgetMemory& out) const override {
+        LayoutContainer::measure_memory(out);
+        out.object = sizeof(*this);
+        out.other += (columns_.capacity() + rows_.capacity()) * sizeof(Track) +
+                     slots_.capacity() * sizeof(Slot) +
+                     slot_index_.size() * (sizeof(std::pair<const Widget* const, size_t>) + 2 * sizeof(void*)) +
+                     slot_index_.bucket_count() * sizeof(void*);
+    }
+};
+
+/**
+ * @brief Helpers to create grids
+ */
+inline std::shared_ptr<Grid> make_grid() {
+    return make_widget<Grid>();
+}
+
+inline std::shared_ptr<Grid> make_grid(float gap, float padding = 0.0f) {
+    auto grid = make_widget<Grid>();
+    grid->set_gap(gap);
+    grid->set_padding(padding);
+    return grid;
+}
+
+} // namespace zuu::widget
@@ -9,6 +9,10 @@
 
 #include "zwidget/core/widget.hpp"
 #include "zwidget/render/canvas.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
 
 namespace zuu::widget {
 
@@ -17,9 +21,41 @@ namespace zuu::widget {
  */
 class Label : public Widget {
 private:
-    std::wstring text_;
-    TextStyle text_style_;
+    std::string text_;  // UTF-8
+    TextStyleRef text_style_;
     bool word_wrap_ = false;
+    std::unique_ptr<TextLayoutCache> text_cache_;  // Only for word wrap and auto_size()
+    
+    TextLayoutCache& text_cache() {
+        if (!text_cache_) {
+            text_cache_ = std::make_unique<TextLayoutCache>();
+            text_cache_->assign(text_);
+        }
+        return *text_cache_;
+    }
+    
+    void invalidate_text() {
+        if (text_cache_) text_cache_->assign(text_);
+        invalidate_layout();
+    }
+    
+    void invalidate_shaping() {
+        if (text_cache_) text_cache_->invalidate();
+        invalidate_layout();
+    }
+    
+protected:
+    /**
+     * @brief Wrapped labels are as tall as their lines at the offered width
+     */
+    Sizef measure_content(const Sizef& available) override {
+        if (!word_wrap_ || text_.empty()) {
+            return Widget::measure_content(available);
+        }
+        const TextLayout& layout = text_cache().layout(*text_style_);
+        float width = available.w < FLT_MAX ? available.w : layout.natural_size().w;
+        return layout.measure(width);
+    }
     
 public:
     Label() {
@@ -27,71 +63,115 @@ public:
         set_background(Color::transparent());
         set_foreground(Color::black());
         
-        text_style_.font_size = 12.0f;
-        text_style_.align = TextAlign::left;
-        text_style_.valign = TextVAlign::middle;
+        TextStyle style;
+        style.font_size = 12.0f;
+        style.align = TextAlign::left;
+        style.valign = TextVAlign::middle;
+        text_style_ = style;
     }
     
-    explicit Label(const std::wstring& text) : Label() {
+    explicit Label(std::string_view text) : Label() {
         text_ = text;
     }
     
-    Label(const std::wstring& text, const TextStyle& style) : Label(text) {
+    explicit Label(std::wstring_view text) : Label() {
+        text_ = utf8::from_wide(text);
+    }
+    
+    Label(std::string_view text, const TextStyle& style) : Label(text) {
+        text_style_ = style;
+    }
+    
+    Label(std::wstring_view text, const TextStyle& style) : Label(text) {
         text_style_ = style;
     }
     
     // === Text Management ===
     
-    void set_text(const std::wstring& text) {
+    void set_text(std::string_view text) {
         if (text_ != text) {
             text_ = text;
-            mark_dirty();
+            invalidate_text();
         }
     }
     
-    const std::wstring& text() const { return text_; }
+    void set_text(std::wstring_view text) {
+        set_text(std::string_view(utf8::from_wide(text)));
+    }
+    
+    /**
+     * @brief The text as stored, UTF-8
+     */
+    const std::string& utf8_text() const { return text_; }
+    
+    std::wstring text() const { return utf8::to_wide(text_); }
     
     void set_text_style(const TextStyle& style) {
         text_style_ = style;
-        mark_dirty();
+        invalidate_shaping();
     }
     
-    const TextStyle& text_style() const { return text_style_; }
+    const TextStyle& text_style() const { return *text_style_; }
+    
+    /**
+     * @brief Share an interned style with other widgets
+     */
+    void set_shared_text_style(TextStyleRef style) {
+        text_style_ = std::move(style);
+        invalidate_shaping();
+    }
+    
+    const TextStyleRef& shared_text_style() const { return text_style_; }
     
     void set_font_size(float size) {
-        text_style_.font_size = size;
-        mark_dirty();
+        text_style_ = text_style_.with([&](TextStyle& s) { s.font_size = size; });
+        invalidate_shaping();
     }
     
     void set_bold(bool bold) {
-        text_style_.bold = bold;
-        mark_dirty();
+        text_style_ = text_style_.with([&](TextStyle& s) { s.bold = bold; });
+        invalidate_shaping();
     }
     
     void set_italic(bool italic) {
-        text_style_.italic = italic;
-        mark_dirty();
+        text_style_ = text_style_.with([&](TextStyle& s) { s.italic = italic; });
+        invalidate_shaping();
     }
     
     void set_alignment(TextAlign align) {
-        text_style_.align = align;
+        text_style_ = text_style_.with([&](TextStyle& s) { s.align = align; });
         mark_dirty();
     }
     
     void set_vertical_alignment(TextVAlign valign) {
-        text_style_.valign = valign;
+        text_style_ = text_style_.with([&](TextStyle& s) { s.valign = valign; });
         mark_dirty();
     }
     
     void set_word_wrap(bool wrap) {
         word_wrap_ = wrap;
-        mark_dirty();
+        invalidate_layout();
     }
     
     bool word_wrap() const { return word_wrap_; }
     
     // === Widget Interface ===
     
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        out.strings += string_heap_bytes(text_);
+        if (text_cache_) out.other += text_cache_->heap_bytes();
+    }
+    
+    Rectf opaque_rect() const override {
+        // Background is only painted together with text
+        if (!text_.empty() && background().a == 255) {
+            return Rectf{0.0f, 0.0f, width(), height()};
+        }
+        return Widget::opaque_rect();
+    }
+    
     void draw(Canvas& canvas) override {
         if (text_.empty()) return;
         
@@ -102,26 +182,56 @@ public:
         
         // Draw text
         Rectf text_rect{0, 0, width(), height()};
-        canvas.draw_text(text_, text_rect, foreground(), text_style_);
+        if (!word_wrap_) {
+            canvas.draw_text(std::string_view(text_), text_rect, foreground(), *text_style_);
+            return;
+        }
+        
+        // Wrapped: one draw per line, cached for the current width
+        TextLayoutCache& cache = text_cache();
+        const auto& lines = cache.lines(*text_style_, width());
+        float line_height = cache.layout(*text_style_).line_height();
+        float total = line_height * static_cast<float>(lines.size());
+        float y = 0.0f;
+        if (text_style_->valign == TextVAlign::middle) y = (height() - total) * 0.5f;
+        else if (text_style_->valign == TextVAlign::bottom) y = height() - total;
+        
+        std::wstring_view text(cache.text());
+        for (const auto& line : lines) {
+            if (y >= height()) break;
+            if (y + line_height > 0.0f && line.end > line.begin) {
+                canvas.draw_text(text.substr(line.begin, line.end - line.begin),
+                                 Rectf{0.0f, y, width(), line_height}, foreground(), *text_style_);
+            }
+            y += line_height;
+        }
     }
     
-    // Calculate preferred size based on text
+    /**
+     * @brief Set the preferred size to the unwrapped text size
+     */
     void auto_size() {
-        // This would need RenderContext access to measure text
-        // For now, just mark dirty
-        mark_dirty();
+        set_preferred_size(text_cache().layout(*text_style_).natural_size());
     }
 };
 
 /**
  * @brief Helper to create label
  */
-inline WidgetPtr make_label(const std::wstring& text) {
-    return std::make_shared<Label>(text);
+inline WidgetPtr make_label(std::string_view text) {
+    return make_widget<Label>(text);
+}
+
+inline WidgetPtr make_label(std::wstring_view text) {
+    return make_widget<Label>(text);
+}
+
+inline WidgetPtr make_label(std::string_view text, const TextStyle& style) {
+    return make_widget<Label>(text, style);
 }
 
-inline WidgetPtr make_label(const std::wstring& text, const TextStyle& style) {
-    return std::make_shared<Label>(text, style);
+inline WidgetPtr make_label(std::wstring_view text, const TextStyle& style) {
+    return make_widget<Label>(text, style);
 }
 
 } // namespace zuu::widget
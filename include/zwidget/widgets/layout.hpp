@@ -10,6 +10,8 @@
 #include "zwidget/render/canvas.hpp"
 #include "zwidget/core/widget.hpp"
 #include <algorithm>
+#include <cfloat>
+#include <optional>
 
 namespace zuu::widget {
 
@@ -25,6 +27,8 @@ enum class LayoutAlign {
 
 /**
  * @brief Base layout container
+ * Desired size is the children's content plus padding, but never less than
+ * preferred_size (which defaults to 0 for containers).
  */
 class LayoutContainer : public Widget {
 protected:
@@ -32,32 +36,61 @@ protected:
     float padding_ = 0.0f;
     LayoutAlign alignment_ = LayoutAlign::start;
     
+    /**
+     * @brief Space left for children after padding (FLT_MAX stays unbounded)
+     */
+    Sizef inner_size(const Sizef& outer) const {
+        auto shrink = [this](float v) {
+            return v == FLT_MAX ? v : std::max(0.0f, v - padding_ * 2);
+        };
+        return Sizef{shrink(outer.w), shrink(outer.h)};
+    }
+    
+    bool uses_child_measure(const Widget&) const override { return true; }
+    
+    std::optional<Sizef> child_measure_space(const Sizef& available) const override {
+        return inner_size(available);
+    }
+    
 public:
     LayoutContainer() {
         set_background(Color::transparent());
+        set_preferred_size(Sizef{0, 0});
     }
     
     void set_spacing(float spacing) {
         spacing_ = spacing;
-        mark_dirty();
+        invalidate_layout();
     }
     
     float spacing() const { return spacing_; }
     
     void set_padding(float padding) {
         padding_ = padding;
-        mark_dirty();
+        invalidate_layout();
     }
     
     float padding() const { return padding_; }
     
     void set_alignment(LayoutAlign align) {
         alignment_ = align;
-        mark_dirty();
+        invalidate_layout();
     }
     
     LayoutAlign alignment() const { return alignment_; }
     
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+    }
+    
+    Rectf opaque_rect() const override {
+        if (background().a == 255) {
+            return Rectf{0.0f, 0.0f, width(), height()};
+        }
+        return Widget::opaque_rect();
+    }
+    
     void draw(Canvas& canvas) override {
         // Draw background if not transparent
         if (background().a > 0) {
@@ -72,33 +105,49 @@ public:
  * @brief Horizontal box layout - arranges children left to right
  */
 class HBox : public LayoutContainer {
-public:
-    HBox() = default;
+protected:
+    Sizef measure_content(const Sizef& available) override {
+        Sizef inner = inner_size(available);
+        float total_width = 0.0f;
+        float max_height = 0.0f;
+        size_t visible_count = 0;
+        
+        for (const auto& child : children()) {
+            if (!child->is_visible()) continue;
+            
+            Sizef desired = child->measure(inner);
+            total_width += desired.w;
+            max_height = std::max(max_height, desired.h);
+            visible_count++;
+        }
+        
+        float total_spacing = spacing_ * std::max(0, static_cast<int>(visible_count) - 1);
+        return Sizef{std::max(preferred_size().w, total_width + total_spacing + padding_ * 2),
+                     std::max(preferred_size().h, max_height + padding_ * 2)};
+    }
     
-    void layout() override {
+    void arrange_content() override {
         if (children().empty()) return;
         
-        // Calculate total preferred width and count stretch items
+        // Same space the children were measured with, so their measures are cache hits
+        Sizef inner = inner_size(measured_available_);
+        
+        // Calculate total desired width and count stretch items
         float total_preferred_width = 0.0f;
         size_t stretch_count = 0;
+        size_t visible_count = 0;
         
         for (const auto& child : children()) {
             if (!child->is_visible()) continue;
+            visible_count++;
             
-            if (child->alignment().orientation == orientations::horizontal &&
-                child->alignment().main_axis == aligns::end) {
+            if (stretches(*child)) {
                 stretch_count++;
             } else {
-                total_preferred_width += child->preferred_size().w;
+                total_preferred_width += child->measure(inner).w;
             }
         }
         
-        // Add spacing
-        size_t visible_count = 0;
-        for (const auto& child : children()) {
-            if (child->is_visible()) visible_count++;
-        }
-        
         float total_spacing = spacing_ * std::max(0, static_cast<int>(visible_count) - 1);
         float available_width = width() - padding_ * 2 - total_spacing - total_preferred_width;
         
@@ -111,89 +160,123 @@ public:
         for (auto& child : children_) {
             if (!child->is_visible()) continue;
             
-            float child_width;
-            bool is_stretch = (child->alignment().orientation == orientations::horizontal &&
-                             child->alignment().main_axis == aligns::end);
-            
-            if (is_stretch) {
-                child_width = std::max(stretch_width, child->min_size().w);
-            } else {
-                child_width = child->preferred_size().w;
-            }
-            
-            // Clamp to min/max
-            child_width = std::clamp(child_width, 
-                                    child->min_size().w, 
-                                    child->max_size().w);
-            
-            // Calculate vertical position based on alignment
-            float y = padding_;
-            float child_height = height() - padding_ * 2;
-            
-            switch (alignment_) {
-                case LayoutAlign::start:
-                    y = padding_;
-                    child_height = child->preferred_size().h;
-                    break;
-                    
-                case LayoutAlign::center:
-                    child_height = child->preferred_size().h;
-                    y = (height() - child_height) / 2.0f;
-                    break;
-                    
-                case LayoutAlign::end:
-                    child_height = child->preferred_size().h;
-                    y = height() - padding_ - child_height;
-                    break;
-                    
-                case LayoutAlign::stretch:
-                    y = padding_;
-                    child_height = height() - padding_ * 2;
-                    break;
-            }
-            
-            // Set child bounds
-            child->set_bounds(Rectf{x, y, child_width, child_height});
-            
-            // Layout child's children
-            child->layout();
+            Rectf rect = child_rect(*child, child->measure(inner), x, stretch_width);
+            arrange_child(*child, rect);
             
-            x += child_width + spacing_;
+            x += rect.width() + spacing_;
+        }
+    }
+    
+    std::optional<Rectf> leading_rect(const Widget& child, const std::optional<Rectf>& previous) const override {
+        if (stretches(child)) return std::nullopt;  // Its width depends on all the others
+        
+        // Same sum as arrange_content(), so the rects match exactly
+        float x = previous ? previous->left() + (previous->width() + spacing_) : padding_;
+        return child_rect(child, child.desired_size(), x, 0.0f);
+    }
+    
+private:
+    static bool stretches(const Widget& child) {
+        return child.alignment().orientation == orientations::horizontal &&
+               child.alignment().main_axis == aligns::end;
+    }
+    
+    /**
+     * @brief Where arrange_content() puts a child that starts at x
+     */
+    Rectf child_rect(const Widget& child, const Sizef& desired, float x, float stretch_width) const {
+        float child_width;
+        if (stretches(child)) {
+            child_width = std::max(stretch_width, child.min_size().w);
+        } else {
+            child_width = desired.w;
+        }
+        
+        // Clamp to min/max
+        child_width = std::clamp(child_width, 
+                                child.min_size().w, 
+                                child.max_size().w);
+        
+        // Calculate vertical position based on alignment
+        float y = padding_;
+        float child_height = height() - padding_ * 2;
+        
+        switch (alignment_) {
+            case LayoutAlign::start:
+                y = padding_;
+                child_height = desired.h;
+                break;
+                
+            case LayoutAlign::center:
+                child_height = desired.h;
+                y = (height() - child_height) / 2.0f;
+                break;
+                
+            case LayoutAlign::end:
+                child_height = desired.h;
+                y = height() - padding_ - child_height;
+                break;
+                
+            case LayoutAlign::stretch:
+                y = padding_;
+                child_height = height() - padding_ * 2;
+                break;
         }
+        
+        return Rectf{x, y, child_width, child_height};
     }
+    
+public:
+    HBox() = default;
 };
 
 /**
  * @brief Vertical box layout - arranges children top to bottom
  */
 class VBox : public LayoutContainer {
-public:
-    VBox() = default;
+protected:
+    Sizef measure_content(const Sizef& available) override {
+        Sizef inner = inner_size(available);
+        float total_height = 0.0f;
+        float max_width = 0.0f;
+        size_t visible_count = 0;
+        
+        for (const auto& child : children()) {
+            if (!child->is_visible()) continue;
+            
+            Sizef desired = child->measure(inner);
+            total_height += desired.h;
+            max_width = std::max(max_width, desired.w);
+            visible_count++;
+        }
+        
+        float total_spacing = spacing_ * std::max(0, static_cast<int>(visible_count) - 1);
+        return Sizef{std::max(preferred_size().w, max_width + padding_ * 2),
+                     std::max(preferred_size().h, total_height + total_spacing + padding_ * 2)};
+    }
     
-    void layout() override {
+    void arrange_content() override {
         if (children().empty()) return;
         
-        // Calculate total preferred height and count stretch items
+        // Same space the children were measured with, so their measures are cache hits
+        Sizef inner = inner_size(measured_available_);
+        
+        // Calculate total desired height and count stretch items
         float total_preferred_height = 0.0f;
         size_t stretch_count = 0;
+        size_t visible_count = 0;
         
         for (const auto& child : children()) {
             if (!child->is_visible()) continue;
+            visible_count++;
             
-            if (child->alignment().orientation == orientations::vertical &&
-                child->alignment().main_axis == aligns::end) {
+            if (stretches(*child)) {
                 stretch_count++;
             } else {
-                total_preferred_height += child->preferred_size().h;
+                total_preferred_height += child->measure(inner).h;
             }
         }
         
-        // Add spacing
-        size_t visible_count = 0;
-        for (const auto& child : children()) {
-            if (child->is_visible()) visible_count++;
-        }
-        
         float total_spacing = spacing_ * std::max(0, static_cast<int>(visible_count) - 1);
         float available_height = height() - padding_ * 2 - total_spacing - total_preferred_height;
         
@@ -206,78 +289,96 @@ public:
         for (auto& child : children_) {
             if (!child->is_visible()) continue;
             
-            float child_height;
-            bool is_stretch = (child->alignment().orientation == orientations::vertical &&
-                             child->alignment().main_axis == aligns::end);
+            Rectf rect = child_rect(*child, child->measure(inner), y, stretch_height);
+            arrange_child(*child, rect);
             
-            if (is_stretch) {
-                child_height = std::max(stretch_height, child->min_size().h);
-            } else {
-                child_height = child->preferred_size().h;
-            }
-            
-            // Clamp to min/max
-            child_height = std::clamp(child_height,
-                                     child->min_size().h,
-                                     child->max_size().h);
-            
-            // Calculate horizontal position based on alignment
-            float x = padding_;
-            float child_width = width() - padding_ * 2;
-            
-            switch (alignment_) {
-                case LayoutAlign::start:
-                    x = padding_;
-                    child_width = child->preferred_size().w;
-                    break;
-                    
-                case LayoutAlign::center:
-                    child_width = child->preferred_size().w;
-                    x = (width() - child_width) / 2.0f;
-                    break;
-                    
-                case LayoutAlign::end:
-                    child_width = child->preferred_size().w;
-                    x = width() - padding_ - child_width;
-                    break;
-                    
-                case LayoutAlign::stretch:
-                    x = padding_;
-                    child_width = width() - padding_ * 2;
-                    break;
-            }
-            
-            // Set child bounds
-            child->set_bounds(Rectf{x, y, child_width, child_height});
-            
-            // Layout child's children
-            child->layout();
-            
-            y += child_height + spacing_;
+            y += rect.height() + spacing_;
+        }
+    }
+    
+    std::optional<Rectf> leading_rect(const Widget& child, const std::optional<Rectf>& previous) const override {
+        if (stretches(child)) return std::nullopt;  // Its height depends on all the others
+        
+        // Same sum as arrange_content(), so the rects match exactly
+        float y = previous ? previous->top() + (previous->height() + spacing_) : padding_;
+        return child_rect(child, child.desired_size(), y, 0.0f);
+    }
+    
+private:
+    static bool stretches(const Widget& child) {
+        return child.alignment().orientation == orientations::vertical &&
+               child.alignment().main_axis == aligns::end;
+    }
+    
+    /**
+     * @brief Where arrange_content() puts a child that starts at y
+     */
+    Rectf child_rect(const Widget& child, const Sizef& desired, float y, float stretch_height) const {
+        float child_height;
+        if (stretches(child)) {
+            child_height = std::max(stretch_height, child.min_size().h);
+        } else {
+            child_height = desired.h;
+        }
+        
+        // Clamp to min/max
+        child_height = std::clamp(child_height,
+                                 child.min_size().h,
+                                 child.max_size().h);
+        
+        // Calculate horizontal position based on alignment
+        float x = padding_;
+        float child_width = width() - padding_ * 2;
+        
+        switch (alignment_) {
+            case LayoutAlign::start:
+                x = padding_;
+                child_width = desired.w;
+                break;
+                
+            case LayoutAlign::center:
+                child_width = desired.w;
+                x = (width() - child_width) / 2.0f;
+                break;
+                
+            case LayoutAlign::end:
+                child_width = desired.w;
+                x = width() - padding_ - child_width;
+                break;
+                
+            case LayoutAlign::stretch:
+                x = padding_;
+                child_width = width() - padding_ * 2;
+                break;
         }
+        
+        return Rectf{x, y, child_width, child_height};
     }
+    
+public:
+    VBox() = default;
 };
 
 /**
  * @brief Helpers to create layout containers
  */
 inline WidgetPtr make_hbox() {
-    return std::make_shared<HBox>();
+    return make_widget<HBox>();
 }
 
 inline WidgetPtr make_vbox() {
-    return std::make_shared<VBox>();
+    return make_widget<VBox>();
 }
 
 inline WidgetPtr make_hbox(float spacing, float padding = 0.0f) {
-    auto box = std::make_shared<HBox>();
+    auto box = make_widget<HBox>();
     box->set_spacing(spacing);
     box->set_padding(padding);
     return box;
 }
 
 inline WidgetPtr make_vbox(float spacing, float padding = 0.0f) {
-    auto box = std::make_shared<VBox>();
+    auto box = make_widget<VBox>();
     box->set_spacing(spacing);
     box->set_padding(padding);
     return box;
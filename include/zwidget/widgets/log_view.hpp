@@ -0,0 +1,502 @@
+#pragma once
+
+/**
+ * @file log_view.hpp
+ * @brief Read-only viewer for large, growing log files
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details The view is anchored at the byte offset of its first line and
+ * walks lines from there, so the first screen of a multi-gigabyte file, or
+ * its last one, shows as soon as the file is mapped; the LogFile's
+ * background index only supplies line numbers and go-to-line as it
+ * completes. Every walk reads at most max_line_bytes per row: a longer
+ * line, or a file with no line feeds at all, continues on the next rows,
+ * so no frame scans more than a screenful of bytes. Only visible rows are
+ * decoded and shaped, each only as far as the view is wide, and kept
+ * while they stay on screen. Search
+ * matches are highlighted as the search tasks report them. When following,
+ * each frame checks (at most every refresh interval) for appended data and
+ * keeps the last line in view; scrolling up stops following and scrolling
+ * back to the end resumes it.
+ */
+
+#include "zwidget/core/log_file.hpp"
+#include "zwidget/core/widget.hpp"
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zuu::widget {
+
+/**
+ * @brief Scrollable view of a LogFile with search highlighting
+ */
+class LogView : public Widget {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t max_line_bytes = 4096;  // Per row; longer lines continue on the next row
+
+private:
+    struct CachedLine {
+        uint64_t end;       // Of the shown bytes
+        std::wstring text;  // Without the line feed or a CR before it
+        TextLayout layout;
+        bool clipped;       // The row goes on past end, beyond the width it was shaped for
+    };
+
+    static constexpr float padding = 4.0f;
+
+    std::unique_ptr<LogFile> file_;
+    uint64_t top_ = 0;              // Start of the first visible line
+    uint64_t bottom_ = 0;           // End of the last line drawn
+    bool follow_ = false;
+    uint64_t pinned_size_ = 0;      // File size and rows the end was last pinned for
+    size_t pinned_rows_ = 0;
+    Clock::duration refresh_interval_ = std::chrono::milliseconds(250);
+    Clock::time_point last_refresh_{};
+    std::optional<LogMatch> current_match_;
+
+    TextStyleRef text_style_;
+    float line_height_ = 0.0f;      // 0 until shaped
+    float digit_width_ = 0.0f;
+    Color match_color_{255, 220, 0, 140};
+    Color current_match_color_{255, 140, 0, 200};
+    Color gutter_color_{140, 140, 140, 255};
+
+    std::unordered_map<uint64_t, CachedLine> lines_;  // By line start
+    std::vector<uint64_t> visible_;                   // Starts of the lines drawn last
+    std::vector<LogMatch> visible_matches_;
+    std::wstring scratch_;
+
+public:
+    /**
+     * @brief Open path; indexing and searches run on pool, which must outlive the view
+     */
+    LogView(const std::string& path, TaskPool& pool) : file_(std::make_unique<LogFile>(path, pool)) {
+        set_preferred_size(Sizef{600, 400});
+        set_background(Color::white());
+        set_foreground(Color(0, 0, 0, 255));
+
+        TextStyle style;
+        style.font_size = 12.0f;
+        style.align = TextAlign::left;
+        style.valign = TextVAlign::top;
+        text_style_ = style;
+    }
+
+    LogFile& file() { return *file_; }
+    const LogFile& file() const { return *file_; }
+
+    // === Style ===
+
+    void set_text_style(const TextStyle& style) {
+        text_style_ = style;
+        invalidate_shaping();
+    }
+
+    const TextStyle& text_style() const { return *text_style_; }
+
+    void set_font_size(float size) {
+        text_style_ = text_style_.with([&](TextStyle& s) { s.font_size = size; });
+        invalidate_shaping();
+    }
+
+    /**
+     * @brief Drop shaped lines, e.g. after the measuring context changed
+     */
+    void invalidate_shaping() {
+        lines_.clear();
+        line_height_ = 0.0f;
+        digit_width_ = 0.0f;
+        mark_dirty();
+    }
+
+    float line_height() {
+        if (line_height_ <= 0.0f) {
+            line_height_ = TextShaper::shape(L"Ag", *text_style_).line_height();
+            if (line_height_ <= 0.0f) line_height_ = text_style_->font_size * 1.25f;
+        }
+        return line_height_;
+    }
+
+    // === Following ===
+
+    /**
+     * @brief Keep the end of the file in view as it grows
+     */
+    void set_follow(bool follow) {
+        follow_ = follow;
+        pinned_rows_ = 0;
+        mark_dirty();
+    }
+
+    bool follows() const { return follow_; }
+
+    /**
+     * @brief How often draw() looks for appended data
+     */
+    void set_refresh_interval(Clock::duration interval) { refresh_interval_ = interval; }
+
+    /**
+     * @brief Pick up appended data now rather than at the next interval
+     */
+    void refresh() {
+        last_refresh_ = Clock::now();
+        uint64_t old_size = file_->size();
+        if (!file_->refresh()) return;
+
+        if (file_->size() < old_size) {
+            lines_.clear();
+            current_match_.reset();
+            top_ = file_->line_begin(std::min(top_, file_->size()), max_line_bytes);
+        } else if (old_size > 0) {
+            // Only the line that was last can have changed
+            uint64_t last = file_->line_begin(old_size - 1, max_line_bytes);
+            std::erase_if(lines_, [&](const auto& entry) { return entry.first >= last; });
+        }
+        mark_dirty();
+    }
+
+    // === Scrolling ===
+
+    size_t visible_rows() {
+        return static_cast<size_t>(std::max(0.0f, viewport().size.h) / line_height()) + 1;
+    }
+
+    /**
+     * @brief Offset where the first visible line starts
+     */
+    uint64_t top_offset() const { return top_; }
+
+    /**
+     * @brief Zero-based number of the first visible line, once the index has reached it
+     */
+    std::optional<uint64_t> first_visible_line() const { return file_->line_of(top_); }
+
+    /**
+     * @brief Scroll by whole lines; down to the last screen at most, which resumes following
+     */
+    void scroll_lines(int64_t delta) {
+        if (delta < 0) {
+            follow_ = false;
+            for (; delta < 0 && top_ > 0; ++delta) top_ = file_->previous_line(top_, max_line_bytes);
+        } else if (delta > 0) {
+            uint64_t last_top = end_top();
+            for (; delta > 0 && top_ < last_top; --delta) top_ = file_->next_line(top_, max_line_bytes);
+            if (top_ >= last_top) set_follow(true);
+        }
+        mark_dirty();
+    }
+
+    /**
+     * @brief Show the line containing offset first
+     */
+    void scroll_to_offset(uint64_t offset) {
+        follow_ = false;
+        top_ = file_->line_begin(offset, max_line_bytes);
+        mark_dirty();
+    }
+
+    /**
+     * @brief Show a zero-based line first
+     * @return false if the index has not reached that line yet
+     */
+    bool go_to_line(uint64_t line) {
+        std::optional<uint64_t> start = file_->line_start(line);
+        if (!start) return false;
+        scroll_to_offset(*start);
+        return true;
+    }
+
+    void scroll_to_start() { scroll_to_offset(0); }
+
+    void scroll_to_end() { set_follow(true); }
+
+    // === Search ===
+
+    /**
+     * @brief Start a search whose matches are highlighted as they are found
+     * Throws std::regex_error for an invalid regex.
+     */
+    void search(std::string_view pattern, const LogSearchOptions& options = {}) {
+        file_->search(pattern, options);
+        current_match_.reset();
+        mark_dirty();
+    }
+
+    void clear_search() { search(""); }
+
+    std::optional<LogMatch> current_match() const { return current_match_; }
+
+    /**
+     * @brief Select and reveal the next match found so far, after the current one or the top line
+     */
+    bool next_match() {
+        std::optional<LogMatch> match = file_->next_match(current_match_ ? current_match_->offset + 1 : top_);
+        return match && select_match(*match);
+    }
+
+    /**
+     * @brief Select and reveal the previous match found so far
+     */
+    bool previous_match() {
+        std::optional<LogMatch> match = file_->previous_match(current_match_ ? current_match_->offset : bottom_);
+        return match && select_match(*match);
+    }
+
+    size_t cached_lines() const { return lines_.size(); }
+
+    // === Widget Interface ===
+
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        LogFileStats stats = file_->stats();
+        out.other += sizeof(LogFile) + stats.index_bytes + stats.match_bytes;
+        out.other += (visible_.capacity() * sizeof(uint64_t)) + visible_matches_.capacity() * sizeof(LogMatch);
+        for (const auto& [start, line] : lines_) {
+            out.other += string_heap_bytes(line.text) + line.layout.heap_bytes() + sizeof(CachedLine) + 32;
+        }
+    }
+
+    Rectf opaque_rect() const override {
+        if (background().a == 255) {
+            return Rectf{0.0f, 0.0f, width(), height()};
+        }
+        return Widget::opaque_rect();
+    }
+
+    void draw(Canvas& canvas) override {
+        if (Clock::now() - last_refresh_ >= refresh_interval_) refresh();
+
+        Rectf bounds{0, 0, width(), height()};
+        canvas.fill_rect(bounds, background());
+        Color border_color = is_focused() ? Color(0, 120, 215, 255) : Color(200, 200, 200, 255);
+        canvas.draw_rect(bounds, border_color, is_focused() ? 1.5f : 1.0f);
+
+        Rectf view = viewport();
+        CanvasClip clip(canvas, view);
+        float lh = line_height();
+        size_t rows = visible_rows();
+        if (follow_ && (pinned_size_ != file_->size() || pinned_rows_ != rows)) {
+            top_ = end_top();
+            pinned_size_ = file_->size();
+            pinned_rows_ = rows;
+        }
+
+        visible_.clear();
+        for (uint64_t start = top_; visible_.size() < rows && start < file_->size();
+             start = file_->next_line(start, max_line_bytes)) {
+            visible_.push_back(start);
+        }
+        bottom_ = visible_.empty() ? top_ : file_->line_end(visible_.back(), max_line_bytes);
+        file_->matches_in(top_, bottom_, visible_matches_);
+
+        // Line numbers, as far as the index knows them
+        std::optional<uint64_t> first_number = file_->line_of(top_);
+        float gutter = 0.0f;
+        if (first_number) {
+            size_t digits = std::to_string(*first_number + rows).size();
+            gutter = static_cast<float>(std::max<size_t>(digits, 4)) * digit_width() + 2 * padding;
+        }
+
+        auto match = visible_matches_.begin();
+        uint64_t number = first_number.value_or(0);
+        for (size_t i = 0; i < visible_.size(); ++i) {
+            uint64_t start = visible_[i];
+            float y = view.pos.y + static_cast<float>(i) * lh;
+            float x = view.pos.x + gutter;
+            const CachedLine& line = cached_line(start, view.size.w - gutter);
+
+            // Rows continuing a line cut at max_line_bytes get no number
+            bool line_start = start == 0 || file_->text(start - 1, start) == "\n";
+            if (i > 0 && line_start) ++number;
+            if (first_number && line_start) {
+                canvas.draw_text(std::to_wstring(number + 1), Rectf{view.pos.x, y, gutter, lh},
+                                 gutter_color_, *text_style_);
+            }
+
+            for (; match != visible_matches_.end() && match->offset < line.end; ++match) {
+                float left = line.layout.advance(0, column(start, line, match->offset));
+                float right = line.layout.advance(0, column(start, line, match->offset + match->length));
+                bool current = current_match_ && current_match_->offset == match->offset;
+                canvas.fill_rect(Rectf{x + left, y, std::max(right - left, 2.0f), lh},
+                                 current ? current_match_color_ : match_color_);
+            }
+            // Matches running past the end of the row
+            while (match != visible_matches_.end() && (i + 1 == visible_.size() || match->offset < visible_[i + 1])) {
+                ++match;
+            }
+
+            if (!line.text.empty()) {
+                float w = line.layout.advance(0, static_cast<uint32_t>(line.text.size()));
+                canvas.draw_text(line.text, Rectf{x, y, w + lh, lh}, foreground(), *text_style_);
+            }
+        }
+        trim_cache();
+        draw_scroll_indicator(canvas, view);
+    }
+
+    bool on_mouse_event(const MouseEvent& event) override {
+        if (event.state == mouse_state::scroll) {
+            // One wheel notch (120) scrolls three lines
+            scroll_lines(-static_cast<int64_t>(event.scroll_delta) * 3 / 120);
+            return true;
+        }
+        return Widget::on_mouse_event(event);
+    }
+
+    bool on_mouse_press(mouse_button button, const Pointf& /*pos*/) override {
+        if (button != mouse_button::left) return false;
+        set_focused(true);
+        return true;
+    }
+
+    bool on_key_press(uint32_t key) override {
+        bool shift = GetKeyState(VK_SHIFT) & 0x8000;
+        int64_t page = static_cast<int64_t>(std::max<size_t>(visible_rows(), 2) - 1);
+
+        switch (key) {
+            case VK_UP:
+                scroll_lines(-1);
+                return true;
+
+            case VK_DOWN:
+                scroll_lines(1);
+                return true;
+
+            case VK_PRIOR:
+                scroll_lines(-page);
+                return true;
+
+            case VK_NEXT:
+                scroll_lines(page);
+                return true;
+
+            case VK_HOME:
+                scroll_to_start();
+                return true;
+
+            case VK_END:
+                scroll_to_end();
+                return true;
+
+            case VK_F3:
+                shift ? previous_match() : next_match();
+                return true;
+        }
+        return false;
+    }
+
+private:
+    Rectf viewport() const {
+        return Rectf{padding, padding, std::max(0.0f, width() - 2 * padding), std::max(0.0f, height() - 2 * padding)};
+    }
+
+    float digit_width() {
+        if (digit_width_ <= 0.0f) {
+            digit_width_ = TextShaper::shape(L"0", *text_style_).advance(0, 1);
+        }
+        return digit_width_;
+    }
+
+    /**
+     * @brief Top offset that puts the last line at the bottom of the view
+     */
+    uint64_t end_top() {
+        uint64_t top = file_->last_line(max_line_bytes);
+        for (size_t rows = visible_rows(); rows > 1 && top > 0; --rows) {
+            top = file_->previous_line(top, max_line_bytes);
+        }
+        return top;
+    }
+
+    /**
+     * @brief The row starting at start, decoded and shaped as far as width reaches
+     * The bytes taken start from a guess of one digit width per byte and
+     * double until they fill width or the row ends.
+     */
+    const CachedLine& cached_line(uint64_t start, float width) {
+        auto it = lines_.find(start);
+        if (it != lines_.end() && (!it->second.clipped || it->second.layout.natural_size().w >= width)) {
+            return it->second;
+        }
+
+        const uint64_t row_end = file_->line_end(start, max_line_bytes);
+        uint64_t take = static_cast<uint64_t>(std::max(width, 0.0f) / digit_width()) + 8;
+        CachedLine line;
+        for (;; take *= 2) {
+            uint64_t end = row_end - start > take ? start + take : row_end;
+            // Not inside a UTF-8 sequence
+            while (end > start && end < row_end && (static_cast<unsigned char>(file_->text(end, end + 1)[0]) & 0xC0) == 0x80) {
+                --end;
+            }
+            std::string_view bytes = file_->text(start, end);
+            if (end == row_end && !bytes.empty() && bytes.back() == '\r') bytes.remove_suffix(1);
+
+            line.end = end;
+            line.clipped = end < row_end;
+            utf8::to_wide(bytes, line.text);
+            line.layout = TextShaper::shape(line.text, *text_style_);
+            if (!line.clipped || line.layout.natural_size().w >= width) break;
+        }
+        return lines_.insert_or_assign(start, std::move(line)).first->second;
+    }
+
+    /**
+     * @brief Column of a byte offset within a shown line
+     */
+    uint32_t column(uint64_t start, const CachedLine& line, uint64_t offset) {
+        offset = std::clamp(offset, start, line.end);
+        utf8::to_wide(file_->text(start, offset), scratch_);
+        return static_cast<uint32_t>(std::min(scratch_.size(), line.text.size()));
+    }
+
+    void trim_cache() {
+        if (lines_.size() <= 3 * visible_.size()) return;
+        std::erase_if(lines_, [&](const auto& entry) {
+            return !std::binary_search(visible_.begin(), visible_.end(), entry.first);
+        });
+    }
+
+    /**
+     * @brief Thin bar on the right placing the visible bytes within the file
+     */
+    void draw_scroll_indicator(Canvas& canvas, const Rectf& view) {
+        double size = static_cast<double>(file_->size());
+        if (size <= 0.0 || (top_ == 0 && bottom_ + 1 >= file_->size())) return;
+
+        float top = static_cast<float>(static_cast<double>(top_) / size) * view.size.h;
+        float h = std::max(8.0f, static_cast<float>(static_cast<double>(bottom_ - top_) / size) * view.size.h);
+        canvas.fill_rect(Rectf{view.pos.x + view.size.w - 4.0f, view.pos.y + std::min(top, view.size.h - h), 4.0f, h},
+                         Color(0, 0, 0, 80));
+    }
+
+    bool select_match(const LogMatch& match) {
+        current_match_ = match;
+        if (match.offset < top_ || match.offset >= bottom_) {
+            // Show it a third of the way down
+            scroll_to_offset(match.offset);
+            scroll_lines(-static_cast<int64_t>(visible_rows() / 3));
+        }
+        mark_dirty();
+        return true;
+    }
+};
+
+/**
+ * @brief Helper to create a log viewer
+ */
+inline WidgetPtr make_log_view(const std::string& path, TaskPool& pool) {
+    return make_widget<LogView>(path, pool);
+}
+
+} // namespace zuu::widget
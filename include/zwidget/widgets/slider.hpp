@@ -7,6 +7,7 @@
  * @date 2025-11-30
  */
 
+#include "zwidget/core/signal.hpp"
 #include "zwidget/core/widget.hpp"
 #include "zwidget/render/canvas.hpp"
 #include <functional>
@@ -37,6 +38,7 @@ private:
     Color thumb_hover_color_{0, 100, 180, 255};
     
     ValueChangedCallback on_value_changed_;
+    Signal<float> value_changed_;
     
     // Helper methods
     float get_normalized_value() const {
@@ -87,6 +89,7 @@ public:
             if (on_value_changed_) {
                 on_value_changed_(value_);
             }
+            value_changed_.emit(value_);
         }
     }
     
@@ -117,6 +120,7 @@ public:
     
     void set_thumb_radius(float radius) {
         thumb_radius_ = radius;
+        invalidate_visual_bounds();
         mark_dirty();
     }
     
@@ -133,8 +137,24 @@ public:
         on_value_changed_ = std::move(callback);
     }
     
+    /**
+     * @brief Multi-subscriber variant of set_on_value_changed
+     */
+    Signal<float>& value_changed() { return value_changed_; }
+    
     // === Widget Interface ===
     
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+    }
+    
+    Rectf visual_overflow() const override {
+        // Value text is painted above the thumb while hovered or dragging
+        float top = std::min(0.0f, height() / 2.0f - thumb_radius_ - 25.0f);
+        return Rectf{0.0f, top, width(), height() - top};
+    }
+    
     void draw(Canvas& canvas) override {
         float y_center = height() / 2.0f;
         float thumb_x = get_thumb_x();
@@ -258,7 +278,7 @@ public:
  * @brief Helper to create slider
  */
 inline WidgetPtr make_slider(float min_val, float max_val, float initial = 0.0f) {
-    return std::make_shared<Slider>(min_val, max_val, initial);
+    return make_widget<Slider>(min_val, max_val, initial);
 }
 
 } // namespace zuu::widget
\ No newline at end of file
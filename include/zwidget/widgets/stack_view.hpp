@@ -0,0 +1,421 @@
+#pragma once
+
+/**
+ * @file stack_view.hpp
+ * @brief Page containers with lazily built pages: StackView and TabView
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details Pages are described by factories and constructed the first time
+ * they are shown. Only the current page is attached as a child, so hidden
+ * pages cost nothing in layout, rendering or hit testing. Hidden pages stay
+ * cached until their memory, measured with subtree_memory() each time a page
+ * is hidden, exceeds the cache budget; the least recently shown ones are then
+ * destroyed, optionally saving their state for the next build.
+ */
+
+#include "zwidget/core/signal.hpp"
+#include "zwidget/core/widget.hpp"
+#include "zwidget/render/canvas.hpp"
+#include <algorithm>
+#include <any>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zuu::widget {
+
+using PageFactory = std::function<WidgetPtr()>;
+using PageSaveState = std::function<std::any(Widget&)>;
+using PageRestoreState = std::function<void(Widget&, const std::any&)>;
+
+/**
+ * @brief Page cache counters, cumulative since construction
+ */
+struct PageCacheStats {
+    size_t instantiated = 0;  // Factory calls
+    size_t evicted = 0;       // Hidden pages destroyed
+    size_t restored = 0;      // Rebuilt pages given back their saved state
+};
+
+/**
+ * @brief Shows one page at a time; pages are built on demand
+ * The only child is the current page. Pages are added with add_page();
+ * the child list calls inherited from Widget are private and throw
+ * std::runtime_error when reached through a Widget&, so nothing can get
+ * around the page cache unnoticed.
+ */
+class StackView : public Widget {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    [[noreturn]] static void not_a_page_call() {
+        throw std::runtime_error("StackView children are its pages; use add_page() and set_current()");
+    }
+
+    void add_child(WidgetPtr) override { not_a_page_call(); }
+    void insert_child(size_t, WidgetPtr) override { not_a_page_call(); }
+    void move_child(Widget*, size_t) override { not_a_page_call(); }
+    void reorder_children(std::span<const size_t>) override { not_a_page_call(); }
+    void remove_child(Widget*) override { not_a_page_call(); }
+
+protected:
+    struct Page {
+        std::wstring title;
+        PageFactory factory;
+        PageSaveState save;
+        PageRestoreState restore;
+
+        WidgetPtr widget;         // Null until shown, or after eviction
+        size_t bytes = 0;         // Subtree memory when it was last hidden
+        uint64_t last_shown = 0;
+        std::any state;           // Saved on eviction, consumed on rebuild
+    };
+
+    std::vector<Page> pages_;
+    size_t current_ = npos;
+    uint64_t clock_ = 0;
+
+    size_t cache_budget_ = 4 << 20;  // Bytes kept alive in hidden pages
+    PageCacheStats stats_;
+
+    Signal<size_t> current_changed_;
+
+    void instantiate(Page& page) {
+        page.widget = page.factory();
+        if (!page.widget) return;
+
+        stats_.instantiated++;
+
+        if (page.state.has_value()) {
+            if (page.restore) {
+                page.restore(*page.widget, page.state);
+                stats_.restored++;
+            }
+            page.state.reset();
+        }
+    }
+
+    void evict(Page& page) {
+        if (page.save) {
+            page.state = page.save(*page.widget);
+        }
+        page.widget.reset();
+        page.bytes = 0;
+        stats_.evicted++;
+    }
+
+    /**
+     * @brief Destroy least recently shown hidden pages until within budget
+     */
+    void trim_cache() {
+        size_t cached = cached_bytes();
+
+        while (cached > cache_budget_) {
+            Page* oldest = nullptr;
+            for (size_t i = 0; i < pages_.size(); ++i) {
+                Page& page = pages_[i];
+                if (i == current_ || !page.widget) continue;
+                if (!oldest || page.last_shown < oldest->last_shown) {
+                    oldest = &page;
+                }
+            }
+
+            if (!oldest) break;
+
+            cached -= oldest->bytes;
+            evict(*oldest);
+        }
+    }
+
+    /**
+     * @brief Area given to the current page, in local coordinates
+     */
+    virtual Rectf content_rect() const {
+        return Rectf{0, 0, width(), height()};
+    }
+
+    /**
+     * @brief The current page fills content_rect(), so it is a relayout boundary
+     */
+    void arrange_content() override {
+        if (const auto& widget = current_page()) {
+            arrange_child(*widget, content_rect());
+        }
+    }
+
+public:
+    StackView() {
+        set_background(Color::transparent());
+    }
+
+    // === Pages ===
+
+    /**
+     * @brief Register a page; nothing is built until it is shown
+     * @param save Optional hook to capture state before the page is evicted
+     * @param restore Optional hook to apply that state after the page is rebuilt
+     * @return Page index
+     */
+    size_t add_page(std::wstring title, PageFactory factory,
+                    PageSaveState save = nullptr, PageRestoreState restore = nullptr) {
+        Page page;
+        page.title = std::move(title);
+        page.factory = std::move(factory);
+        page.save = std::move(save);
+        page.restore = std::move(restore);
+        pages_.push_back(std::move(page));
+
+        mark_dirty();
+
+        if (current_ == npos) {
+            set_current(pages_.size() - 1);
+        }
+        return pages_.size() - 1;
+    }
+
+    size_t page_count() const { return pages_.size(); }
+
+    const std::wstring& page_title(size_t index) const { return pages_[index].title; }
+
+    /**
+     * @brief Live widget of a page, or null if it is not built
+     */
+    const WidgetPtr& page(size_t index) const { return pages_[index].widget; }
+
+    bool is_instantiated(size_t index) const {
+        return index < pages_.size() && pages_[index].widget != nullptr;
+    }
+
+    // === Current Page ===
+
+    /**
+     * @brief Show a page, building it if needed
+     */
+    void set_current(size_t index) {
+        if (index >= pages_.size() || index == current_) return;
+
+        if (current_ != npos && pages_[current_].widget) {
+            Page& hidden = pages_[current_];
+            Widget::remove_child(hidden.widget.get());
+            // Measured now, since the page may have grown while it was shown
+            hidden.bytes = hidden.widget->subtree_memory();
+        }
+
+        current_ = index;
+        Page& page = pages_[index];
+        page.last_shown = ++clock_;
+
+        if (!page.widget) {
+            instantiate(page);
+        }
+
+        if (page.widget) {
+            Widget::add_child(page.widget);
+            page.widget->arrange(content_rect());
+        }
+
+        trim_cache();
+        mark_dirty();
+        current_changed_.emit(index);
+    }
+
+    size_t current_index() const { return current_; }
+
+    const WidgetPtr& current_page() const {
+        static const WidgetPtr none;
+        return current_ != npos ? pages_[current_].widget : none;
+    }
+
+    Signal<size_t>& current_changed() { return current_changed_; }
+
+    // === Cache ===
+
+    /**
+     * @brief Max bytes kept alive across hidden pages, as reported by subtree_memory()
+     * A budget of 0 destroys each page as soon as it is hidden.
+     */
+    void set_cache_budget(size_t bytes) {
+        cache_budget_ = bytes;
+        trim_cache();
+    }
+
+    size_t cache_budget() const { return cache_budget_; }
+
+    /**
+     * @brief Memory of hidden pages, each as measured when it was hidden
+     */
+    size_t cached_bytes() const {
+        size_t bytes = 0;
+        for (size_t i = 0; i < pages_.size(); ++i) {
+            if (i != current_ && pages_[i].widget) {
+                bytes += pages_[i].bytes;
+            }
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Destroy every hidden page, e.g. on memory pressure
+     */
+    void evict_hidden() {
+        for (size_t i = 0; i < pages_.size(); ++i) {
+            if (i != current_ && pages_[i].widget) {
+                evict(pages_[i]);
+            }
+        }
+    }
+
+    const PageCacheStats& cache_stats() const { return stats_; }
+
+    // === Widget Interface ===
+
+    /**
+     * @brief Includes hidden cached pages, which are not children
+     */
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        out.other += pages_.capacity() * sizeof(Page);
+
+        for (size_t i = 0; i < pages_.size(); ++i) {
+            out.strings += string_heap_bytes(pages_[i].title);
+            if (i != current_ && pages_[i].widget) {
+                out.other += pages_[i].widget->subtree_memory();
+            }
+        }
+    }
+
+    void draw(Canvas& canvas) override {
+        if (background().a > 0) {
+            canvas.fill_rect(Rectf{0, 0, width(), height()}, background());
+        }
+    }
+};
+
+/**
+ * @brief StackView with a row of clickable tabs above the pages
+ */
+class TabView : public StackView {
+private:
+    float tab_height_ = 28.0f;
+    float tab_width_ = 120.0f;
+    TextStyleRef tab_style_;
+
+    Color strip_color_{230, 230, 230, 255};
+    Color tab_color_{245, 245, 245, 255};
+    Color active_tab_color_{255, 255, 255, 255};
+    Color accent_color_{0, 120, 215, 255};
+
+    /**
+     * @brief Tab width, shrunk so all tabs fit the strip
+     */
+    float effective_tab_width() const {
+        if (pages_.empty()) return tab_width_;
+        return std::min(tab_width_, width() / static_cast<float>(pages_.size()));
+    }
+
+protected:
+    Rectf content_rect() const override {
+        return Rectf{0.0f, tab_height_, width(), std::max(0.0f, height() - tab_height_)};
+    }
+
+public:
+    TabView() {
+        set_foreground(Color(0, 0, 0, 255));
+
+        TextStyle style;
+        style.font_size = 12.0f;
+        style.align = TextAlign::center;
+        style.valign = TextVAlign::middle;
+        tab_style_ = style;
+    }
+
+    // === Appearance ===
+
+    void set_tab_height(float height) {
+        tab_height_ = height;
+        invalidate_layout();
+    }
+
+    float tab_height() const { return tab_height_; }
+
+    void set_tab_width(float width) {
+        tab_width_ = width;
+        mark_dirty();
+    }
+
+    float tab_width() const { return tab_width_; }
+
+    void set_tab_style(const TextStyle& style) {
+        tab_style_ = style;
+        mark_dirty();
+    }
+
+    void set_accent_color(const Color& color) {
+        accent_color_ = color;
+        mark_dirty();
+    }
+
+    /**
+     * @brief Tab index under a local point, or npos
+     */
+    size_t tab_at(const Pointf& pos) const {
+        if (pos.y < 0 || pos.y >= tab_height_ || pos.x < 0) return npos;
+
+        auto index = static_cast<size_t>(pos.x / effective_tab_width());
+        return index < pages_.size() ? index : npos;
+    }
+
+    // === Widget Interface ===
+
+    void measure_memory(WidgetMemory& out) const override {
+        StackView::measure_memory(out);
+        out.object = sizeof(*this);
+    }
+
+    void draw(Canvas& canvas) override {
+        StackView::draw(canvas);
+
+        canvas.fill_rect(Rectf{0.0f, 0.0f, width(), tab_height_}, strip_color_);
+
+        float tab_w = effective_tab_width();
+        for (size_t i = 0; i < pages_.size(); ++i) {
+            Rectf tab{tab_w * static_cast<float>(i), 0.0f, tab_w, tab_height_};
+            bool active = (i == current_);
+
+            canvas.fill_rect(Rectf{tab.left() + 1, tab.top() + 1, tab.width() - 2, tab.height() - 1},
+                             active ? active_tab_color_ : tab_color_);
+            canvas.draw_text(pages_[i].title, tab, foreground(), *tab_style_);
+
+            if (active) {
+                canvas.fill_rect(Rectf{tab.left(), tab_height_ - 2, tab_w, 2.0f}, accent_color_);
+            }
+        }
+    }
+
+    bool on_mouse_press(mouse_button button, const Pointf& pos) override {
+        if (button != mouse_button::left || !is_enabled()) return false;
+
+        size_t index = tab_at(pos);
+        if (index == npos) return false;
+
+        set_current(index);
+        return true;
+    }
+};
+
+/**
+ * @brief Helpers to create page containers
+ */
+inline std::shared_ptr<StackView> make_stack_view() {
+    return make_widget<StackView>();
+}
+
+inline std::shared_ptr<TabView> make_tab_view() {
+    return make_widget<TabView>();
+}
+
+} // namespace zuu::widget
@@ -0,0 +1,425 @@
+#pragma once
+
+/**
+ * @file static_tree.hpp
+ * @brief Compile-time widget trees with zero heap allocation
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details For fixed screens (kiosk, embedded) the tree is described with
+ * static_label / static_button / static_hbox / static_vbox and flattened by
+ * make_static_tree() into a std::array of trivially copyable nodes in
+ * pre-order. Box layout follows the HBox/VBox rules and runs in constexpr,
+ * so a `constexpr` tree is fully laid out at compile time:
+ *
+ * @code
+ * constexpr auto screen = make_static_tree(
+ *     static_vbox({.size = {380, 120}, .spacing = 10, .padding = 15},
+ *         static_label(L"Welcome", {350, 30}),
+ *         static_hbox({.size = {350, 40}, .spacing = 10},
+ *             static_button(L"Cancel", {100, 35}),
+ *             static_button(L"OK", {100, 35}, {.id = 1}))));
+ * @endcode
+ *
+ * Text must have static storage duration (string literals).
+ */
+
+#include "zwidget/core/widget.hpp"
+#include "zwidget/widgets/layout.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+
+namespace zuu::widget {
+
+/**
+ * @brief Kind of a static node
+ */
+enum class StaticKind : uint8_t {
+    label,
+    button,
+    hbox,
+    vbox
+};
+
+/**
+ * @brief Optional appearance of static labels and buttons
+ */
+struct StaticTextOptions {
+    uint16_t id = 0;                          // User tag, e.g. to identify clicked buttons
+    float font_size = 0.0f;                   // 0 = widget default (12 label, 14 button)
+    bool bold = false;
+    bool stretch = false;                     // Fill remaining space on the box main axis
+    Color foreground{0, 0, 0, 255};
+    Color background{0, 0, 0, 0};             // Buttons: 0 alpha = default white
+    Color hover_background{0, 0, 0, 0};       // Buttons only; 0 alpha = Button's default
+    Color pressed_background{0, 0, 0, 0};
+    Color border{0, 0, 0, 0};
+};
+
+/**
+ * @brief Parameters of static HBox/VBox containers
+ */
+struct StaticBoxOptions {
+    Sizef size{};                             // Preferred size
+    float spacing = 0.0f;
+    float padding = 0.0f;
+    LayoutAlign align = LayoutAlign::start;   // Cross-axis alignment
+    Color background{0, 0, 0, 0};
+    bool stretch = false;
+    uint16_t id = 0;
+};
+
+/**
+ * @brief One widget of a static tree - literal and trivially copyable
+ */
+struct StaticNode {
+    static constexpr uint16_t npos = 0xFFFF;
+
+    StaticKind kind = StaticKind::label;
+    uint16_t id = 0;
+    uint16_t parent = npos;
+    uint16_t first_child = 0;                 // Always index + 1; equals subtree_end for leaves
+    uint16_t subtree_end = 0;                 // One past the last descendant (pre-order)
+
+    std::wstring_view text;
+    Rectf bounds;                             // Relative to parent, like Widget::bounds()
+    Pointf absolute;                          // Top-left relative to the tree root
+    Sizef preferred;
+
+    Color foreground;
+    Color background;
+    Color hover_background;                   // Buttons only
+    Color pressed_background;
+    Color border;
+    float font_size = 12.0f;
+    bool bold = false;
+    bool stretch = false;
+
+    float spacing = 0.0f;
+    float padding = 0.0f;
+    LayoutAlign align = LayoutAlign::start;
+
+    WidgetState state = WidgetState::visible | WidgetState::enabled;
+
+    constexpr bool is_box() const { return kind == StaticKind::hbox || kind == StaticKind::vbox; }
+    constexpr bool has_children() const { return first_child < subtree_end; }
+};
+
+// === Descriptions ===
+
+/**
+ * @brief Leaf description (label or button)
+ */
+struct StaticLeafDesc {
+    static constexpr size_t count = 1;
+
+    StaticKind kind;
+    std::wstring_view text;
+    Sizef size;
+    StaticTextOptions options;
+
+    template <size_t N>
+    constexpr void emit(std::array<StaticNode, N>& nodes, size_t& index, uint16_t parent) const {
+        StaticNode& node = nodes[index];
+        node.kind = kind;
+        node.id = options.id;
+        node.parent = parent;
+        node.text = text;
+        node.preferred = size;
+        node.stretch = options.stretch;
+        node.bold = options.bold;
+        node.foreground = options.foreground;
+        node.background = options.background;
+
+        if (kind == StaticKind::button) {
+            node.font_size = options.font_size > 0.0f ? options.font_size : 14.0f;
+            // Same defaults as Button
+            auto or_default = [](const Color& color, const Color& fallback) {
+                return color.a == 0 ? fallback : color;
+            };
+            node.background = or_default(options.background, Color{255, 255, 255, 255});
+            node.hover_background = or_default(options.hover_background, Color{230, 230, 230, 255});
+            node.pressed_background = or_default(options.pressed_background, Color{200, 200, 200, 255});
+            node.border = or_default(options.border, Color{128, 128, 128, 255});
+        } else {
+            node.font_size = options.font_size > 0.0f ? options.font_size : 12.0f;
+        }
+
+        index++;
+        node.first_child = static_cast<uint16_t>(index);
+        node.subtree_end = static_cast<uint16_t>(index);
+    }
+};
+
+/**
+ * @brief Box description with a fixed set of children
+ */
+template <typename... Children>
+struct StaticBoxDesc {
+    static constexpr size_t count = 1 + (Children::count + ... + 0);
+
+    StaticKind kind;
+    StaticBoxOptions options;
+    std::tuple<Children...> children;
+
+    template <size_t N>
+    constexpr void emit(std::array<StaticNode, N>& nodes, size_t& index, uint16_t parent) const {
+        const auto self = static_cast<uint16_t>(index);
+
+        StaticNode& node = nodes[index];
+        node.kind = kind;
+        node.id = options.id;
+        node.parent = parent;
+        node.preferred = options.size;
+        node.stretch = options.stretch;
+        node.spacing = options.spacing;
+        node.padding = options.padding;
+        node.align = options.align;
+        node.background = options.background;
+
+        index++;
+        node.first_child = static_cast<uint16_t>(index);
+
+        std::apply([&](const auto&... child) {
+            (child.emit(nodes, index, self), ...);
+        }, children);
+
+        nodes[self].subtree_end = static_cast<uint16_t>(index);
+    }
+};
+
+constexpr StaticLeafDesc static_label(std::wstring_view text, Sizef size,
+                                      StaticTextOptions options = {}) {
+    return StaticLeafDesc{StaticKind::label, text, size, options};
+}
+
+constexpr StaticLeafDesc static_button(std::wstring_view text, Sizef size,
+                                       StaticTextOptions options = {}) {
+    return StaticLeafDesc{StaticKind::button, text, size, options};
+}
+
+template <typename... Children>
+constexpr auto static_hbox(StaticBoxOptions options, Children... children) {
+    return StaticBoxDesc<Children...>{StaticKind::hbox, options, {children...}};
+}
+
+template <typename... Children>
+constexpr auto static_vbox(StaticBoxOptions options, Children... children) {
+    return StaticBoxDesc<Children...>{StaticKind::vbox, options, {children...}};
+}
+
+// === Tree ===
+
+/**
+ * @brief Flat, statically laid-out widget tree of N nodes
+ * Copying is a memcpy; no member owns heap memory.
+ */
+template <size_t N>
+class StaticTree {
+    static_assert(N < StaticNode::npos, "StaticTree supports up to 65534 nodes");
+
+private:
+    std::array<StaticNode, N> nodes_{};
+
+    /**
+     * @brief Position children of box i - same rules as HBox/VBox::layout()
+     */
+    constexpr void layout_box(size_t i) {
+        StaticNode& box = nodes_[i];
+        const bool horizontal = box.kind == StaticKind::hbox;
+
+        auto main_of = [&](const Sizef& s) { return horizontal ? s.w : s.h; };
+        auto cross_of = [&](const Sizef& s) { return horizontal ? s.h : s.w; };
+
+        float total_preferred = 0.0f;
+        size_t stretch_count = 0;
+        size_t visible_count = 0;
+
+        for (size_t c = box.first_child; c < box.subtree_end; c = nodes_[c].subtree_end) {
+            if (!has_state(nodes_[c].state, WidgetState::visible)) continue;
+            visible_count++;
+            if (nodes_[c].stretch) {
+                stretch_count++;
+            } else {
+                total_preferred += main_of(nodes_[c].preferred);
+            }
+        }
+
+        const float box_main = main_of(box.bounds.size);
+        const float box_cross = cross_of(box.bounds.size);
+        const float total_spacing = visible_count > 1 ? box.spacing * static_cast<float>(visible_count - 1) : 0.0f;
+        const float available = box_main - box.padding * 2 - total_spacing - total_preferred;
+        const float stretch_size = stretch_count > 0 ? available / static_cast<float>(stretch_count) : 0.0f;
+
+        float main_pos = box.padding;
+
+        for (size_t c = box.first_child; c < box.subtree_end; c = nodes_[c].subtree_end) {
+            StaticNode& child = nodes_[c];
+            if (!has_state(child.state, WidgetState::visible)) continue;
+
+            float main_size = child.stretch ? std::max(stretch_size, 0.0f) : main_of(child.preferred);
+            float cross_size = cross_of(child.preferred);
+            float cross_pos = box.padding;
+
+            switch (box.align) {
+                case LayoutAlign::start:
+                    break;
+                case LayoutAlign::center:
+                    cross_pos = (box_cross - cross_size) / 2.0f;
+                    break;
+                case LayoutAlign::end:
+                    cross_pos = box_cross - box.padding - cross_size;
+                    break;
+                case LayoutAlign::stretch:
+                    cross_size = box_cross - box.padding * 2;
+                    break;
+            }
+
+            child.bounds = horizontal
+                ? Rectf{main_pos, cross_pos, main_size, cross_size}
+                : Rectf{cross_pos, main_pos, cross_size, main_size};
+            child.absolute = box.absolute + child.bounds.pos;
+
+            main_pos += main_size + box.spacing;
+        }
+    }
+
+public:
+    static constexpr size_t npos = StaticNode::npos;
+
+    constexpr StaticTree() = default;
+
+    template <typename Desc>
+    constexpr explicit StaticTree(const Desc& desc) {
+        size_t index = 0;
+        desc.emit(nodes_, index, StaticNode::npos);
+        nodes_[0].bounds = Rectf{Pointf{0.0f, 0.0f}, nodes_[0].preferred};
+        layout();
+    }
+
+    /**
+     * @brief Recompute layout (constexpr; nodes come parent-first in pre-order)
+     */
+    constexpr void layout() {
+        for (size_t i = 0; i < N; ++i) {
+            if (nodes_[i].is_box()) {
+                layout_box(i);
+            }
+        }
+    }
+
+    static constexpr size_t size() { return N; }
+
+    constexpr const StaticNode& operator[](size_t i) const { return nodes_[i]; }
+    constexpr StaticNode& operator[](size_t i) { return nodes_[i]; }
+
+    constexpr const std::array<StaticNode, N>& nodes() const { return nodes_; }
+
+    /**
+     * @brief Index of the first node with the given id, or npos
+     */
+    constexpr size_t find(uint16_t id) const {
+        for (size_t i = 0; i < N; ++i) {
+            if (nodes_[i].id == id) return i;
+        }
+        return npos;
+    }
+
+    /**
+     * @brief Topmost visible node at point (root coordinates), or npos
+     */
+    constexpr size_t hit_test(const Pointf& point) const {
+        size_t hit = npos;
+        for (size_t i = 0; i < N;) {
+            const StaticNode& node = nodes_[i];
+            if (!has_state(node.state, WidgetState::visible) ||
+                !Rectf{node.absolute, node.bounds.size}.contains(point)) {
+                i = node.subtree_end;  // Children lie within parent bounds
+                continue;
+            }
+            hit = i;  // Later nodes in pre-order paint on top
+            i++;
+        }
+        return hit;
+    }
+
+    /**
+     * @brief Set or clear a state flag on one node
+     */
+    constexpr void set_state(size_t i, WidgetState state, bool value) {
+        auto& flags = nodes_[i].state;
+        flags = value ? flags | state
+                      : static_cast<WidgetState>(static_cast<uint32_t>(flags) & ~static_cast<uint32_t>(state));
+    }
+
+    /**
+     * @brief Draw the whole tree; the canvas origin is the tree's top-left corner
+     */
+    void render(Canvas& canvas) const {
+        // Only numeric fields change per node; the family stays the default atom
+        TextStyle style;
+
+        for (size_t i = 0; i < N;) {
+            const StaticNode& node = nodes_[i];
+            if (!has_state(node.state, WidgetState::visible)) {
+                i = node.subtree_end;
+                continue;
+            }
+
+            Rectf rect{node.absolute, node.bounds.size};
+
+            switch (node.kind) {
+                case StaticKind::hbox:
+                case StaticKind::vbox:
+                    if (node.background.a > 0) {
+                        canvas.fill_rect(rect, node.background);
+                    }
+                    break;
+
+                case StaticKind::label:
+                    if (node.background.a > 0) {
+                        canvas.fill_rect(rect, node.background);
+                    }
+                    style.font_size = node.font_size;
+                    style.bold = node.bold;
+                    style.align = TextAlign::left;
+                    style.valign = TextVAlign::middle;
+                    canvas.draw_text(node.text, rect, node.foreground, style);
+                    break;
+
+                case StaticKind::button: {
+                    Color bg = node.background;
+                    if (has_state(node.state, WidgetState::pressed)) {
+                        bg = node.pressed_background;
+                    } else if (has_state(node.state, WidgetState::hovered)) {
+                        bg = node.hover_background;
+                    }
+                    canvas.fill_rounded_rect(rect, 4.0f, bg);
+                    canvas.draw_rounded_rect(rect, 4.0f, node.border, 1.0f);
+
+                    style.font_size = node.font_size;
+                    style.bold = node.bold;
+                    style.align = TextAlign::center;
+                    style.valign = TextVAlign::middle;
+                    canvas.draw_text(node.text, rect, node.foreground, style);
+                    break;
+                }
+            }
+
+            i++;
+        }
+    }
+};
+
+/**
+ * @brief Flatten and lay out a description; use in a constexpr context
+ */
+template <typename Desc>
+constexpr auto make_static_tree(const Desc& desc) {
+    return StaticTree<Desc::count>(desc);
+}
+
+} // namespace zuu::widget
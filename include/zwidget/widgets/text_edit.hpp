@@ -0,0 +1,653 @@
+#pragma once
+
+/**
+ * @file text_edit.hpp
+ * @brief Multi-line text editor widget
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @details The document lives in a TextBuffer, whose nodes count line
+ * feeds, so the line index is kept up to date by the edits themselves and
+ * finding a line is O(log n). Drawing visits only the lines that intersect
+ * the viewport, shaping each once into a TextLayout that stays cached until
+ * that line is edited; an edit that adds or removes lines renumbers the
+ * cached ones below it instead of dropping them. The cache holds about
+ * three screens of lines, so frame cost depends on the viewport, not the
+ * document. Lines are not wrapped. Edits are recorded in an UndoHistory.
+ */
+
+#include "zwidget/core/clipboard.hpp"
+#include "zwidget/core/signal.hpp"
+#include "zwidget/core/text_buffer.hpp"
+#include "zwidget/core/undo_history.hpp"
+#include "zwidget/core/widget.hpp"
+#include "zwidget/render/canvas.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace zuu::widget {
+
+/**
+ * @brief Scrollable multi-line text editor
+ */
+class TextEdit : public Widget {
+public:
+    using TextChangedCallback = std::function<void(const TextChange&)>;
+
+private:
+    struct CachedLine {
+        std::wstring text;  // Without the line feed or a CR before it
+        TextLayout layout;
+    };
+
+    static constexpr float padding = 4.0f;
+
+    TextBuffer text_;
+    UndoHistory history_;
+    size_t cursor_pos_ = 0;
+    size_t anchor_pos_ = 0;        // Other end of the selection
+    float preferred_x_ = -1.0f;    // Kept across up/down moves; < 0 when unset
+    float scroll_x_ = 0.0f;
+    float scroll_y_ = 0.0f;
+    bool reveal_cursor_ = false;   // Scroll the cursor into view on the next draw
+    bool dragging_ = false;
+
+    TextStyleRef text_style_;
+    float line_height_ = 0.0f;     // 0 until shaped
+    Color selection_color_{100, 150, 255, 100};
+    Color cursor_color_{0, 0, 0, 255};
+    bool read_only_ = false;
+
+    std::unordered_map<size_t, CachedLine> lines_;  // By line number
+
+    TextChangedCallback on_text_changed_;
+    Signal<const TextChange&> text_changed_;
+
+public:
+    TextEdit() {
+        set_preferred_size(Sizef{400, 300});
+        set_background(Color::white());
+        set_foreground(Color(0, 0, 0, 255));
+
+        TextStyle style;
+        style.font_size = 12.0f;
+        style.align = TextAlign::left;
+        style.valign = TextVAlign::top;
+        text_style_ = style;
+    }
+
+    explicit TextEdit(std::wstring_view initial_text) : TextEdit() {
+        text_.assign(initial_text);
+    }
+
+    // === Text Management ===
+
+    void set_text(std::wstring_view text) {
+        if (text_.equals(text)) return;
+        size_t removed = text_.length();
+        text_.assign(text);
+        history_.clear();
+        lines_.clear();
+        cursor_pos_ = anchor_pos_ = 0;
+        scroll_x_ = scroll_y_ = 0.0f;
+        preferred_x_ = -1.0f;
+        mark_dirty();
+
+        notify_text_changed(TextChange{0, removed, text});
+    }
+
+    /**
+     * @brief Copy of the whole text - O(n); prefer buffer() or snapshot()
+     */
+    std::wstring text() const { return text_.str(); }
+
+    const TextBuffer& buffer() const { return text_; }
+    TextBuffer::Snapshot snapshot() const { return text_.snapshot(); }
+
+    size_t length() const { return text_.length(); }
+    size_t line_count() const { return text_.line_count(); }
+
+    /**
+     * @brief Replace the selection with text, or insert it at the cursor
+     */
+    void insert_text(std::wstring_view text) {
+        size_t begin = std::min(anchor_pos_, cursor_pos_);
+        replace(begin, std::max(anchor_pos_, cursor_pos_) - begin, text);
+    }
+
+    /**
+     * @brief Replace count characters at pos; the cursor ends up after the new text
+     */
+    void replace(size_t pos, size_t count, std::wstring_view text) {
+        pos = std::min(pos, text_.length());
+        count = std::min(count, text_.length() - pos);
+        if (count == 0 && text.empty()) return;
+
+        size_t first = text_.line_of(pos);
+        size_t removed_lines = count > 0 ? text_.line_of(pos + count) - first : 0;
+        size_t added_lines = static_cast<size_t>(std::count(text.begin(), text.end(), L'\n'));
+
+        history_.record(pos, text_.substr(pos, count), text, cursor_pos_);
+        text_.erase(pos, count);
+        text_.insert(pos, text);
+        lines_changed(first, removed_lines, added_lines);
+
+        cursor_pos_ = anchor_pos_ = pos + text.size();
+        preferred_x_ = -1.0f;
+        reveal_cursor_ = true;
+        mark_dirty();
+
+        notify_text_changed(TextChange{pos, count, text});
+    }
+
+    void set_read_only(bool read_only) { read_only_ = read_only; }
+    bool is_read_only() const { return read_only_; }
+
+    // === Undo ===
+
+    bool undo() {
+        return !read_only_ && history_.undo([this](const UndoStep& step) { apply(step); });
+    }
+
+    bool redo() {
+        return !read_only_ && history_.redo([this](const UndoStep& step) { apply(step); });
+    }
+
+    bool can_undo() const { return history_.can_undo(); }
+    bool can_redo() const { return history_.can_redo(); }
+
+    /**
+     * @brief The edit history, e.g. to change its byte budget
+     */
+    UndoHistory& undo_history() { return history_; }
+
+    // === Style ===
+
+    void set_text_style(const TextStyle& style) {
+        text_style_ = style;
+        invalidate_shaping();
+    }
+
+    const TextStyle& text_style() const { return *text_style_; }
+
+    void set_font_size(float size) {
+        text_style_ = text_style_.with([&](TextStyle& s) { s.font_size = size; });
+        invalidate_shaping();
+    }
+
+    /**
+     * @brief Drop cached line layouts, e.g. after the measuring context changed
+     */
+    void invalidate_shaping() {
+        lines_.clear();
+        line_height_ = 0.0f;
+        mark_dirty();
+    }
+
+    float line_height() {
+        if (line_height_ <= 0.0f) {
+            line_height_ = TextShaper::shape(L"Ag", *text_style_).line_height();
+            if (line_height_ <= 0.0f) line_height_ = text_style_->font_size * 1.25f;
+        }
+        return line_height_;
+    }
+
+    // === Cursor, Selection and Scrolling ===
+
+    size_t cursor_position() const { return cursor_pos_; }
+
+    void set_cursor_position(size_t pos, bool select = false) {
+        move_to(std::min(pos, text_.length()), select);
+        preferred_x_ = -1.0f;
+    }
+
+    void select(size_t anchor, size_t cursor) {
+        anchor_pos_ = std::min(anchor, text_.length());
+        move_to(std::min(cursor, text_.length()), true);
+    }
+
+    void select_all() { select(0, text_.length()); }
+
+    bool has_selection() const { return anchor_pos_ != cursor_pos_; }
+
+    std::wstring get_selected_text() const {
+        size_t begin = std::min(anchor_pos_, cursor_pos_);
+        return text_.substr(begin, std::max(anchor_pos_, cursor_pos_) - begin);
+    }
+
+    /**
+     * @brief Scroll so line is the first one shown
+     */
+    void scroll_to_line(size_t line) {
+        scroll_y_ = static_cast<float>(std::min(line, text_.line_count() - 1)) * line_height();
+        clamp_scroll();
+        mark_dirty();
+    }
+
+    size_t first_visible_line() {
+        return std::min(text_.line_count() - 1, static_cast<size_t>(scroll_y_ / line_height()));
+    }
+
+    /**
+     * @brief Offset of the character boundary nearest to a local position
+     */
+    size_t offset_at(const Pointf& pos) {
+        float y = pos.y - padding + scroll_y_;
+        size_t line = y <= 0.0f ? 0 : std::min(text_.line_count() - 1, static_cast<size_t>(y / line_height()));
+        return text_.line_start(line) + cached_line(line).layout.offset_at(pos.x - padding + scroll_x_);
+    }
+
+    size_t cached_lines() const { return lines_.size(); }
+
+    // === Clipboard ===
+
+    void copy() const {
+        if (has_selection()) {
+            clipboard::set_text(get_selected_text());
+        }
+    }
+
+    void cut() {
+        if (has_selection() && !read_only_) {
+            copy();
+            insert_text({});
+        }
+    }
+
+    void paste() {
+        if (read_only_) return;
+        clipboard::read_text([this](std::wstring_view text) { insert_text(text); });
+    }
+
+    // === Callbacks ===
+
+    void set_on_text_changed(TextChangedCallback callback) {
+        on_text_changed_ = std::move(callback);
+    }
+
+    /**
+     * @brief Multi-subscriber variant of set_on_text_changed
+     */
+    Signal<const TextChange&>& text_changed() { return text_changed_; }
+
+    // === Widget Interface ===
+
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        out.strings += text_.bytes();
+        out.other += history_.bytes();
+        for (const auto& [index, line] : lines_) {
+            out.other += string_heap_bytes(line.text) + line.layout.heap_bytes() + sizeof(CachedLine) + 32;
+        }
+    }
+
+    Rectf opaque_rect() const override {
+        if (background().a == 255) {
+            return Rectf{0.0f, 0.0f, width(), height()};
+        }
+        return Widget::opaque_rect();
+    }
+
+    void draw(Canvas& canvas) override {
+        Rectf bounds{0, 0, width(), height()};
+        canvas.fill_rect(bounds, background());
+
+        Color border_color = is_focused() ? Color(0, 120, 215, 255) : Color(200, 200, 200, 255);
+        canvas.draw_rect(bounds, border_color, is_focused() ? 2.0f : 1.0f);
+
+        if (reveal_cursor_) {
+            reveal_cursor();
+            reveal_cursor_ = false;
+        }
+
+        Rectf view = viewport();
+        CanvasClip clip(canvas, view);
+
+        float lh = line_height();
+        size_t count = text_.line_count();
+        size_t first = first_visible_line();
+        size_t last = std::min(count, static_cast<size_t>((scroll_y_ + view.size.h) / lh) + 1);
+        trim_cache(first, last);
+
+        size_t sel_begin = std::min(anchor_pos_, cursor_pos_);
+        size_t sel_end = std::max(anchor_pos_, cursor_pos_);
+        size_t sel_first = sel_begin < sel_end ? text_.line_of(sel_begin) : 1;
+        size_t sel_last = sel_begin < sel_end ? text_.line_of(sel_end) : 0;
+        size_t cursor_line = text_.line_of(cursor_pos_);
+
+        float x = view.pos.x - scroll_x_;
+        for (size_t i = first; i < last; ++i) {
+            const CachedLine& line = cached_line(i);
+            float y = view.pos.y + static_cast<float>(i) * lh - scroll_y_;
+
+            // Selection: columns on its first and last lines, whole lines between
+            if (i >= sel_first && i <= sel_last) {
+                size_t from = i == sel_first ? column(sel_begin, i, line) : 0;
+                size_t to = i == sel_last ? column(sel_end, i, line) : line.text.size();
+                float left = line.layout.advance(0, static_cast<uint32_t>(from));
+                float right = line.layout.advance(0, static_cast<uint32_t>(to));
+                if (i != sel_last) right += lh * 0.3f;  // Show the selected line break
+                canvas.fill_rect(Rectf{x + left, y, right - left, lh}, selection_color_);
+            }
+
+            if (!line.text.empty()) {
+                float w = line.layout.advance(0, static_cast<uint32_t>(line.text.size()));
+                canvas.draw_text(line.text, Rectf{x, y, w + lh, lh}, foreground(), *text_style_);
+            }
+
+            if (i == cursor_line && is_focused() && !read_only_) {
+                float cx = x + line.layout.advance(0, static_cast<uint32_t>(column(cursor_pos_, i, line)));
+                canvas.draw_line(Pointf{cx, y + 1.0f}, Pointf{cx, y + lh - 1.0f}, cursor_color_, 1.5f);
+            }
+        }
+    }
+
+    bool on_mouse_event(const MouseEvent& event) override {
+        if (event.state == mouse_state::scroll) {
+            // One wheel notch (120) scrolls three lines
+            scroll_y_ -= static_cast<float>(event.scroll_delta) / 120.0f * 3.0f * line_height();
+            clamp_scroll();
+            mark_dirty();
+            return true;
+        }
+        return Widget::on_mouse_event(event);
+    }
+
+    bool on_mouse_press(mouse_button button, const Pointf& pos) override {
+        if (button != mouse_button::left) return false;
+
+        set_focused(true);
+        bool shift = GetKeyState(VK_SHIFT) & 0x8000;
+        set_cursor_position(offset_at(pos), shift);
+        dragging_ = true;
+        return true;
+    }
+
+    bool on_mouse_move(const Pointf& pos) override {
+        if (!dragging_) return false;
+        set_cursor_position(offset_at(pos), true);
+        return true;
+    }
+
+    bool on_mouse_release(mouse_button button, const Pointf& /*pos*/) override {
+        if (button != mouse_button::left || !dragging_) return false;
+        dragging_ = false;
+        return true;
+    }
+
+    bool on_key_press(uint32_t key) override {
+        bool ctrl = GetKeyState(VK_CONTROL) & 0x8000;
+        bool shift = GetKeyState(VK_SHIFT) & 0x8000;
+
+        switch (key) {
+            case VK_LEFT:
+                set_cursor_position(has_selection() && !shift ? std::min(anchor_pos_, cursor_pos_)
+                                                              : previous_position(cursor_pos_), shift);
+                return true;
+
+            case VK_RIGHT:
+                set_cursor_position(has_selection() && !shift ? std::max(anchor_pos_, cursor_pos_)
+                                                              : next_position(cursor_pos_), shift);
+                return true;
+
+            case VK_UP:
+                move_lines(-1, shift);
+                return true;
+
+            case VK_DOWN:
+                move_lines(1, shift);
+                return true;
+
+            case VK_PRIOR:
+                move_lines(-page_lines(), shift);
+                return true;
+
+            case VK_NEXT:
+                move_lines(page_lines(), shift);
+                return true;
+
+            case VK_HOME:
+                set_cursor_position(ctrl ? 0 : text_.line_start(text_.line_of(cursor_pos_)), shift);
+                return true;
+
+            case VK_END:
+                set_cursor_position(ctrl ? text_.length() : visible_line_end(text_.line_of(cursor_pos_)), shift);
+                return true;
+
+            case 'A':
+                if (ctrl) {
+                    select_all();
+                    return true;
+                }
+                break;
+
+            case 'C':
+                if (ctrl) {
+                    copy();
+                    return true;
+                }
+                break;
+        }
+
+        if (read_only_) return false;
+
+        switch (key) {
+            case VK_BACK:
+                if (has_selection()) {
+                    insert_text({});
+                } else if (cursor_pos_ > 0) {
+                    size_t prev = previous_position(cursor_pos_);
+                    replace(prev, cursor_pos_ - prev, {});
+                }
+                return true;
+
+            case VK_DELETE:
+                if (has_selection()) {
+                    insert_text({});
+                } else if (cursor_pos_ < text_.length()) {
+                    replace(cursor_pos_, next_position(cursor_pos_) - cursor_pos_, {});
+                }
+                return true;
+
+            case VK_RETURN:
+                insert_text(L"\n");
+                return true;
+
+            case VK_TAB:
+                insert_text(L"\t");
+                return true;
+
+            case 'V':
+                if (ctrl) {
+                    paste();
+                    return true;
+                }
+                break;
+
+            case 'X':
+                if (ctrl) {
+                    cut();
+                    return true;
+                }
+                break;
+
+            case 'Z':
+                if (ctrl) {
+                    shift ? redo() : undo();
+                    return true;
+                }
+                break;
+
+            case 'Y':
+                if (ctrl) {
+                    redo();
+                    return true;
+                }
+                break;
+        }
+
+        // Handle character input
+        if (key >= 32 && key <= 126 && !ctrl) {
+            wchar_t ch = static_cast<wchar_t>(key);
+            if (!shift && ch >= 'A' && ch <= 'Z') {
+                ch = ch - 'A' + 'a';
+            }
+            insert_text(std::wstring_view(&ch, 1));
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    void notify_text_changed(const TextChange& change) {
+        if (on_text_changed_) {
+            on_text_changed_(change);
+        }
+        text_changed_.emit(change);
+    }
+
+    Rectf viewport() const {
+        return Rectf{padding, padding, std::max(0.0f, width() - 2 * padding), std::max(0.0f, height() - 2 * padding)};
+    }
+
+    const CachedLine& cached_line(size_t index) {
+        auto it = lines_.find(index);
+        if (it != lines_.end()) return it->second;
+
+        size_t begin = text_.line_start(index);
+        size_t end = visible_line_end(index);
+        CachedLine line;
+        line.text = text_.substr(begin, end - begin);
+        line.layout = TextShaper::shape(line.text, *text_style_);
+        return lines_.emplace(index, std::move(line)).first->second;
+    }
+
+    /**
+     * @brief Keep cached lines above the edit, renumber those below it and
+     * drop the ones it touched
+     */
+    void lines_changed(size_t first, size_t removed_lines, size_t added_lines) {
+        std::unordered_map<size_t, CachedLine> kept;
+        kept.reserve(lines_.size());
+        for (auto& [index, line] : lines_) {
+            if (index < first) {
+                kept.emplace(index, std::move(line));
+            } else if (index > first + removed_lines) {
+                kept.emplace(index - removed_lines + added_lines, std::move(line));
+            }
+        }
+        lines_.swap(kept);
+    }
+
+    /**
+     * @brief Bound the cache to about a screen above and below the visible lines
+     */
+    void trim_cache(size_t first, size_t last) {
+        size_t screen = last - first + 1;
+        if (lines_.size() <= 3 * screen) return;
+
+        size_t low = first > screen ? first - screen : 0;
+        size_t high = last + screen;
+        std::erase_if(lines_, [&](const auto& entry) { return entry.first < low || entry.first >= high; });
+    }
+
+    /**
+     * @brief End of a line's text, before its line feed and a CR preceding it
+     */
+    size_t visible_line_end(size_t line) const {
+        size_t begin = text_.line_start(line);
+        size_t end = text_.line_end(line);
+        if (end > begin && text_.at(end - 1) == L'\r') --end;
+        return end;
+    }
+
+    size_t column(size_t pos, size_t line_index, const CachedLine& line) const {
+        return std::min(pos - text_.line_start(line_index), line.text.size());
+    }
+
+    // Steps over CRLF and surrogate pairs as one position
+    size_t next_position(size_t pos) const {
+        if (pos >= text_.length()) return pos;
+        wchar_t c = text_.at(pos);
+        if ((c == L'\r' && text_.at(pos + 1) == L'\n') || (c >= 0xD800 && c <= 0xDBFF)) return pos + 2;
+        return pos + 1;
+    }
+
+    size_t previous_position(size_t pos) const {
+        if (pos == 0) return 0;
+        wchar_t c = text_.at(pos - 1);
+        if (pos >= 2 && ((c == L'\n' && text_.at(pos - 2) == L'\r') || (c >= 0xDC00 && c <= 0xDFFF))) return pos - 2;
+        return pos - 1;
+    }
+
+    void move_to(size_t pos, bool select) {
+        cursor_pos_ = pos;
+        if (!select) anchor_pos_ = pos;
+        history_.seal();
+        reveal_cursor_ = true;
+        mark_dirty();
+    }
+
+    void apply(const UndoStep& step) {
+        replace(step.position, step.remove, step.insert);
+        cursor_pos_ = anchor_pos_ = std::min(step.cursor, text_.length());  // A callback may have replaced the text
+    }
+
+    void move_lines(ptrdiff_t delta, bool select) {
+        size_t line = text_.line_of(cursor_pos_);
+        const CachedLine& current = cached_line(line);
+        float x = preferred_x_ >= 0.0f ? preferred_x_
+                                       : current.layout.advance(0, static_cast<uint32_t>(column(cursor_pos_, line, current)));
+
+        ptrdiff_t last = static_cast<ptrdiff_t>(text_.line_count()) - 1;
+        size_t target = static_cast<size_t>(std::clamp(static_cast<ptrdiff_t>(line) + delta, ptrdiff_t{0}, last));
+        move_to(text_.line_start(target) + cached_line(target).layout.offset_at(x), select);
+        preferred_x_ = x;
+    }
+
+    ptrdiff_t page_lines() {
+        return std::max<ptrdiff_t>(1, static_cast<ptrdiff_t>(viewport().size.h / line_height()) - 1);
+    }
+
+    void clamp_scroll() {
+        float content = static_cast<float>(text_.line_count()) * line_height();
+        scroll_y_ = std::clamp(scroll_y_, 0.0f, std::max(0.0f, content - viewport().size.h));
+        scroll_x_ = std::max(0.0f, scroll_x_);
+    }
+
+    void reveal_cursor() {
+        Rectf view = viewport();
+        float lh = line_height();
+        size_t line = text_.line_of(cursor_pos_);
+        float top = static_cast<float>(line) * lh;
+        if (top < scroll_y_) {
+            scroll_y_ = top;
+        } else if (top + lh > scroll_y_ + view.size.h) {
+            scroll_y_ = top + lh - view.size.h;
+        }
+
+        const CachedLine& current = cached_line(line);
+        float x = current.layout.advance(0, static_cast<uint32_t>(column(cursor_pos_, line, current)));
+        if (x < scroll_x_) {
+            scroll_x_ = std::max(0.0f, x - view.size.w * 0.25f);
+        } else if (x > scroll_x_ + view.size.w - 2.0f) {
+            scroll_x_ = x - view.size.w * 0.75f;
+        }
+        clamp_scroll();
+    }
+};
+
+/**
+ * @brief Helper to create a text editor
+ */
+inline WidgetPtr make_text_edit(std::wstring_view initial_text = L"") {
+    return make_widget<TextEdit>(initial_text);
+}
+
+} // namespace zuu::widget
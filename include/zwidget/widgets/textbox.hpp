@@ -7,28 +7,43 @@
  * @date 2025-11-30
  */
 
+#include "zwidget/core/clipboard.hpp"
+#include "zwidget/core/signal.hpp"
+#include "zwidget/core/text_buffer.hpp"
+#include "zwidget/core/undo_history.hpp"
 #include "zwidget/core/widget.hpp"
 #include "zwidget/render/canvas.hpp"
+#include "zwidget/render/text_layout.hpp"
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <memory>
 
 namespace zuu::widget {
 
 /**
  * @brief Single-line text input box
+ * The text lives in a TextBuffer, so edits cost O(log n) however long it
+ * is, and change listeners get the edited range rather than the whole text.
+ * Every edit goes through replace(), which also records it for undo.
+ * The visible part of the text is shaped once per text, style, scroll or
+ * width change; caret and selection x are lookups in its advance prefix
+ * sums and a mouse x maps to a position by binary search.
  */
 class TextBox : public Widget {
 public:
-    using TextChangedCallback = std::function<void(const std::wstring&)>;
+    using TextChangedCallback = std::function<void(const TextChange&)>;
     using TextSubmitCallback = std::function<void(const std::wstring&)>;
     
 private:
-    std::wstring text_;
-    std::wstring placeholder_;
+    TextBuffer text_;
+    std::string placeholder_;  // UTF-8; the edited text stays wide, indexed by the cursor
     size_t cursor_pos_ = 0;
+    size_t scroll_pos_ = 0;    // First character drawn
     size_t selection_start_ = 0;
     size_t selection_end_ = 0;
     
-    TextStyle text_style_;
+    TextStyleRef text_style_;
     Color placeholder_color_{128, 128, 128, 255};
     Color selection_color_{100, 150, 255, 100};
     Color cursor_color_{0, 0, 0, 255};
@@ -38,10 +53,20 @@ private:
     float cursor_blink_interval_ = 0.5f;
     
     bool read_only_ = false;
-    size_t max_length_ = 1000;
+    size_t max_length_ = std::numeric_limits<size_t>::max();
+    std::unique_ptr<UndoHistory> history_;  // Created by the first edit
+    
+    // Shaped slice of the text from view_begin_, at least as long as fits
+    std::wstring view_text_;
+    TextLayout view_;
+    size_t view_begin_ = 0;
+    float view_width_ = -1.0f;
+    bool view_valid_ = false;
+    bool dragging_ = false;
     
     TextChangedCallback on_text_changed_;
     TextSubmitCallback on_submit_;
+    Signal<const TextChange&> text_changed_;
     
 public:
     TextBox() {
@@ -49,39 +74,103 @@ public:
         set_background(Color::white());
         set_foreground(Color::black());
         
-        text_style_.font_size = 12.0f;
-        text_style_.align = TextAlign::left;
-        text_style_.valign = TextVAlign::middle;
+        TextStyle style;
+        style.font_size = 12.0f;
+        style.align = TextAlign::left;
+        style.valign = TextVAlign::middle;
+        text_style_ = style;
     }
     
-    explicit TextBox(const std::wstring& initial_text) : TextBox() {
-        text_ = initial_text;
+    explicit TextBox(std::wstring_view initial_text) : TextBox() {
+        text_.assign(initial_text);
         cursor_pos_ = text_.length();
     }
     
     // === Text Management ===
     
-    void set_text(const std::wstring& text) {
-        if (text_ != text) {
-            text_ = text;
+    void set_text(std::wstring_view text) {
+        if (!text_.equals(text)) {
+            size_t removed = text_.length();
+            text_.assign(text);
             cursor_pos_ = std::min(cursor_pos_, text_.length());
             selection_start_ = selection_end_ = cursor_pos_;
+            if (history_) history_->clear();
+            view_valid_ = false;
             mark_dirty();
             
-            if (on_text_changed_) {
-                on_text_changed_(text_);
-            }
+            notify_text_changed(TextChange{0, removed, text});
         }
     }
     
-    const std::wstring& text() const { return text_; }
+    /**
+     * @brief Copy of the whole text - O(n); prefer buffer() or snapshot() for long text
+     */
+    std::wstring text() const { return text_.str(); }
+    
+    const TextBuffer& buffer() const { return text_; }
+    
+    /**
+     * @brief O(1) immutable copy of the text, e.g. for a background task
+     */
+    TextBuffer::Snapshot snapshot() const { return text_.snapshot(); }
+    
+    size_t length() const { return text_.length(); }
+    
+    /**
+     * @brief Replace the selection with text, or insert it at the cursor
+     * @return false if max_length() would be exceeded
+     */
+    bool insert_text(std::wstring_view text) {
+        size_t start = std::min(selection_start_, selection_end_);
+        size_t selected = std::max(selection_start_, selection_end_) - start;
+        if (text_.length() - selected + text.length() > max_length_) return false;
+        
+        replace(has_selection() ? start : cursor_pos_, selected, text);
+        return true;
+    }
+    
+    size_t cursor_position() const { return cursor_pos_; }
+    
+    void set_cursor_position(size_t pos) {
+        cursor_pos_ = std::min(pos, text_.length());
+        clear_selection();
+        seal_history();
+    }
+    
+    // === Undo ===
+    
+    bool undo() {
+        if (read_only_ || !history_) return false;
+        return history_->undo([this](const UndoStep& step) { apply(step); });
+    }
     
-    void set_placeholder(const std::wstring& placeholder) {
+    bool redo() {
+        if (read_only_ || !history_) return false;
+        return history_->redo([this](const UndoStep& step) { apply(step); });
+    }
+    
+    bool can_undo() const { return history_ && history_->can_undo(); }
+    bool can_redo() const { return history_ && history_->can_redo(); }
+    
+    /**
+     * @brief The edit history, e.g. to change its byte budget
+     */
+    UndoHistory& undo_history() {
+        if (!history_) history_ = std::make_unique<UndoHistory>();
+        return *history_;
+    }
+    
+    void set_placeholder(std::string_view placeholder) {
         placeholder_ = placeholder;
         mark_dirty();
     }
     
-    const std::wstring& placeholder() const { return placeholder_; }
+    void set_placeholder(std::wstring_view placeholder) {
+        placeholder_ = utf8::from_wide(placeholder);
+        mark_dirty();
+    }
+    
+    std::wstring placeholder() const { return utf8::to_wide(placeholder_); }
     
     void set_read_only(bool read_only) {
         read_only_ = read_only;
@@ -89,6 +178,28 @@ public:
     
     bool is_read_only() const { return read_only_; }
     
+    // === Style ===
+    
+    void set_text_style(const TextStyle& style) {
+        text_style_ = style;
+        invalidate_shaping();
+    }
+    
+    const TextStyle& text_style() const { return *text_style_; }
+    
+    void set_font_size(float size) {
+        text_style_ = text_style_.with([&](TextStyle& s) { s.font_size = size; });
+        invalidate_shaping();
+    }
+    
+    /**
+     * @brief Shape the visible text again, e.g. after the measuring context changed
+     */
+    void invalidate_shaping() {
+        view_valid_ = false;
+        mark_dirty();
+    }
+    
     void set_max_length(size_t length) {
         max_length_ = length;
     }
@@ -101,6 +212,11 @@ public:
         on_text_changed_ = std::move(callback);
     }
     
+    /**
+     * @brief Multi-subscriber variant of set_on_text_changed
+     */
+    Signal<const TextChange&>& text_changed() { return text_changed_; }
+    
     void set_on_submit(TextSubmitCallback callback) {
         on_submit_ = std::move(callback);
     }
@@ -123,6 +239,21 @@ public:
         return selection_start_ != selection_end_;
     }
     
+    /**
+     * @brief Text position nearest to a point in widget coordinates - O(log n)
+     * Left of the text maps to the character before the view and right of
+     * it to the one after, so dragging past an edge scrolls.
+     */
+    size_t offset_at(const Pointf& pos) {
+        const TextLayout& layout = visible_layout();
+        float x = pos.x - padding;
+        if (x < 0.0f && view_begin_ > 0) return view_begin_ - 1;
+        
+        size_t offset = view_begin_ + layout.offset_at(std::min(x, view_width_));
+        if (x > view_width_ && offset < text_.length()) ++offset;
+        return offset;
+    }
+    
     std::wstring get_selected_text() const {
         if (!has_selection()) return L"";
         size_t start = std::min(selection_start_, selection_end_);
@@ -130,8 +261,42 @@ public:
         return text_.substr(start, end - start);
     }
     
+    // === Clipboard ===
+    
+    void copy() const {
+        if (has_selection()) {
+            clipboard::set_text(get_selected_text());
+        }
+    }
+    
+    void cut() {
+        if (has_selection() && !read_only_) {
+            copy();
+            delete_selection();
+        }
+    }
+    
+    void paste() {
+        if (read_only_) return;
+        clipboard::read_text([this](std::wstring_view text) { insert_text(text); });
+    }
+    
     // === Widget Interface ===
     
+    void measure_memory(WidgetMemory& out) const override {
+        Widget::measure_memory(out);
+        out.object = sizeof(*this);
+        out.strings += text_.bytes() + string_heap_bytes(placeholder_);
+        if (history_) out.other += sizeof(UndoHistory) + history_->bytes();
+    }
+    
+    Rectf opaque_rect() const override {
+        if (background().a == 255) {
+            return Rectf{0.0f, 0.0f, width(), height()};
+        }
+        return Widget::opaque_rect();
+    }
+    
     void draw(Canvas& canvas) override {
         Rectf bounds{0, 0, width(), height()};
         
@@ -144,29 +309,38 @@ public:
         canvas.draw_rect(bounds, border_color, is_focused() ? 2.0f : 1.0f);
         
         // Prepare text rect with padding
-        Rectf text_rect{5, 0, width() - 10, height()};
+        Rectf text_rect{padding, 0.0f, width() - padding * 2, height()};
+        
+        // Draw text or placeholder
+        if (text_.empty() && !placeholder_.empty() && !is_focused()) {
+            canvas.draw_text(placeholder_, text_rect, placeholder_color_, *text_style_);
+            return;
+        }
+        
+        reveal_cursor();
+        const TextLayout& layout = visible_layout();
+        CanvasClip clip(canvas, text_rect);
         
         // Draw selection
         if (has_selection() && is_focused()) {
-            // Simplified: draw selection background
-            // In real implementation, would calculate exact text positions
+            float left = caret_x(std::min(selection_start_, selection_end_));
+            float right = caret_x(std::max(selection_start_, selection_end_));
             canvas.fill_rect(
-                Rectf{text_rect.pos.x, text_rect.pos.y, 
-                      text_rect.size.w * 0.3f, text_rect.size.h},
+                Rectf{text_rect.pos.x + left, text_rect.pos.y, right - left, text_rect.size.h},
                 selection_color_
             );
         }
         
-        // Draw text or placeholder
-        if (text_.empty() && !placeholder_.empty() && !is_focused()) {
-            canvas.draw_text(placeholder_, text_rect, placeholder_color_, text_style_);
-        } else {
-            canvas.draw_text(text_, text_rect, foreground(), text_style_);
+        if (!view_text_.empty()) {
+            // As wide as the shaped slice so the backend never wraps it
+            float w = layout.advance(0, static_cast<uint32_t>(layout.length()));
+            canvas.draw_text(view_text_, Rectf{text_rect.pos.x, text_rect.pos.y, w + text_style_->font_size, text_rect.size.h},
+                             foreground(), *text_style_);
         }
         
         // Draw cursor
         if (is_focused() && show_cursor_ && !read_only_) {
-            float cursor_x = text_rect.pos.x + 5; // Simplified position
+            float cursor_x = text_rect.pos.x + caret_x(cursor_pos_);
             canvas.draw_line(
                 Pointf{cursor_x, text_rect.pos.y + 5},
                 Pointf{cursor_x, text_rect.pos.y + height() - 10},
@@ -180,10 +354,13 @@ public:
         if (button == mouse_button::left) {
             set_focused(true);
             
-            // Calculate cursor position from mouse click
-            // Simplified: just set to end
-            cursor_pos_ = text_.length();
-            clear_selection();
+            // Shift-click extends the selection from its anchor
+            bool shift = GetKeyState(VK_SHIFT) & 0x8000;
+            cursor_pos_ = offset_at(pos);
+            if (!shift) selection_start_ = cursor_pos_;
+            selection_end_ = cursor_pos_;
+            seal_history();
+            dragging_ = true;
             
             mark_dirty();
             return true;
@@ -191,6 +368,23 @@ public:
         return false;
     }
     
+    bool on_mouse_move(const Pointf& pos) override {
+        if (!dragging_) return false;
+        
+        size_t offset = offset_at(pos);
+        if (offset != cursor_pos_) {
+            cursor_pos_ = selection_end_ = offset;
+            mark_dirty();
+        }
+        return true;
+    }
+    
+    bool on_mouse_release(mouse_button button, const Pointf& /*pos*/) override {
+        if (button != mouse_button::left || !dragging_) return false;
+        dragging_ = false;
+        return true;
+    }
+    
     bool on_key_press(uint32_t key) override {
         if (read_only_) return false;
         
@@ -218,10 +412,7 @@ public:
                 if (has_selection()) {
                     delete_selection();
                 } else if (cursor_pos_ > 0) {
-                    text_.erase(cursor_pos_ - 1, 1);
-                    cursor_pos_--;
-                    mark_dirty();
-                    if (on_text_changed_) on_text_changed_(text_);
+                    replace(cursor_pos_ - 1, 1, {});
                 }
                 return true;
                 
@@ -229,15 +420,13 @@ public:
                 if (has_selection()) {
                     delete_selection();
                 } else if (cursor_pos_ < text_.length()) {
-                    text_.erase(cursor_pos_, 1);
-                    mark_dirty();
-                    if (on_text_changed_) on_text_changed_(text_);
+                    replace(cursor_pos_, 1, {});
                 }
                 return true;
                 
             case VK_RETURN:
                 if (on_submit_) {
-                    on_submit_(text_);
+                    on_submit_(text_.str());
                 }
                 return true;
                 
@@ -250,22 +439,35 @@ public:
                 
             case 'C':
                 if (ctrl && has_selection()) {
-                    // Copy to clipboard (simplified)
+                    copy();
                     return true;
                 }
                 break;
                 
             case 'V':
                 if (ctrl) {
-                    // Paste from clipboard (simplified)
+                    paste();
                     return true;
                 }
                 break;
                 
             case 'X':
                 if (ctrl && has_selection()) {
-                    // Cut to clipboard (simplified)
-                    delete_selection();
+                    cut();
+                    return true;
+                }
+                break;
+                
+            case 'Z':
+                if (ctrl) {
+                    shift ? redo() : undo();
+                    return true;
+                }
+                break;
+                
+            case 'Y':
+                if (ctrl) {
+                    redo();
                     return true;
                 }
                 break;
@@ -284,7 +486,7 @@ public:
                 ch = ch - 'A' + 'a';
             }
             
-            insert_text(std::wstring(1, ch));
+            insert_text(std::wstring_view(&ch, 1));
             return true;
         }
         
@@ -292,6 +494,93 @@ public:
     }
     
 private:
+    static constexpr float padding = 5.0f;
+    
+    /**
+     * @brief Layout of the text from scroll_pos_ on, shaped only when stale
+     * It covers at least the text width: no glyph is narrower than a fifth of an em.
+     */
+    const TextLayout& visible_layout() {
+        scroll_pos_ = std::min(scroll_pos_, text_.length());
+        float text_width = std::max(0.0f, width() - padding * 2);
+        if (!view_valid_ || view_begin_ != scroll_pos_ || view_width_ != text_width) {
+            size_t visible = static_cast<size_t>(text_width / (text_style_->font_size * 0.2f)) + 1;
+            view_begin_ = scroll_pos_;
+            view_width_ = text_width;
+            view_text_ = text_.substr(view_begin_, visible);
+            view_ = TextShaper::shape(view_text_, *text_style_);
+            view_valid_ = true;
+        }
+        return view_;
+    }
+    
+    /**
+     * @brief Offset of a caret at pos from the text's left edge, clamped to the view - O(1)
+     */
+    float caret_x(size_t pos) {
+        const TextLayout& layout = visible_layout();
+        size_t column = std::clamp(pos, view_begin_, view_begin_ + layout.length()) - view_begin_;
+        return layout.advance(0, static_cast<uint32_t>(column));
+    }
+    
+    /**
+     * @brief Scroll so the cursor is inside the text rect
+     */
+    void reveal_cursor() {
+        scroll_pos_ = std::min(scroll_pos_, text_.length());
+        if (cursor_pos_ < scroll_pos_) {
+            scroll_pos_ = cursor_pos_;
+            return;
+        }
+        
+        const TextLayout& layout = visible_layout();
+        size_t column = cursor_pos_ - view_begin_;
+        if (column <= layout.length() && layout.advance(0, static_cast<uint32_t>(column)) <= view_width_) return;
+        
+        // Put the cursor at the right edge: shape what fits before it once
+        size_t from = cursor_pos_ - std::min(cursor_pos_, layout.length());
+        std::wstring before = text_.substr(from, cursor_pos_ - from);
+        TextLayout span = TextShaper::shape(before, *text_style_);
+        uint32_t n = static_cast<uint32_t>(span.length());
+        uint32_t first = span.offset_at(span.advance(0, n) - view_width_);
+        while (first < n && span.advance(first, n) > view_width_) ++first;
+        if (first < n && before[first] >= 0xDC00 && before[first] <= 0xDFFF) ++first;
+        scroll_pos_ = from + first;
+    }
+    
+    void notify_text_changed(const TextChange& change) {
+        if (on_text_changed_) {
+            on_text_changed_(change);
+        }
+        text_changed_.emit(change);
+    }
+    
+    /**
+     * @brief Replace count characters at pos with text as one edit
+     */
+    void replace(size_t pos, size_t count, std::wstring_view text) {
+        if (count == 0 && text.empty()) return;
+        
+        undo_history().record(pos, text_.substr(pos, count), text, cursor_pos_);
+        text_.erase(pos, count);
+        text_.insert(pos, text);
+        cursor_pos_ = pos + text.length();
+        selection_start_ = selection_end_ = cursor_pos_;
+        view_valid_ = false;
+        mark_dirty();
+        
+        notify_text_changed(TextChange{pos, count, text});
+    }
+    
+    void apply(const UndoStep& step) {
+        replace(step.position, step.remove, step.insert);
+        cursor_pos_ = selection_start_ = selection_end_ = std::min(step.cursor, text_.length());  // A callback may have replaced the text
+    }
+    
+    void seal_history() {
+        if (history_) history_->seal();
+    }
+    
     void move_cursor_left(bool select = false) {
         if (cursor_pos_ > 0) {
             cursor_pos_--;
@@ -300,6 +589,7 @@ private:
             } else {
                 selection_end_ = cursor_pos_;
             }
+            seal_history();
             mark_dirty();
         }
     }
@@ -312,6 +602,7 @@ private:
             } else {
                 selection_end_ = cursor_pos_;
             }
+            seal_history();
             mark_dirty();
         }
     }
@@ -323,6 +614,7 @@ private:
         } else {
             selection_end_ = cursor_pos_;
         }
+        seal_history();
         mark_dirty();
     }
     
@@ -333,6 +625,7 @@ private:
         } else {
             selection_end_ = cursor_pos_;
         }
+        seal_history();
         mark_dirty();
     }
     
@@ -341,39 +634,15 @@ private:
         
         size_t start = std::min(selection_start_, selection_end_);
         size_t end = std::max(selection_start_, selection_end_);
-        
-        text_.erase(start, end - start);
-        cursor_pos_ = start;
-        clear_selection();
-        mark_dirty();
-        
-        if (on_text_changed_) {
-            on_text_changed_(text_);
-        }
-    }
-    
-    void insert_text(const std::wstring& text) {
-        if (text_.length() + text.length() > max_length_) return;
-        
-        if (has_selection()) {
-            delete_selection();
-        }
-        
-        text_.insert(cursor_pos_, text);
-        cursor_pos_ += text.length();
-        mark_dirty();
-        
-        if (on_text_changed_) {
-            on_text_changed_(text_);
-        }
+        replace(start, end - start, {});
     }
 };
 
 /**
  * @brief Helper to create textbox
  */
-inline WidgetPtr make_textbox(const std::wstring& initial_text = L"") {
-    return std::make_shared<TextBox>(initial_text);
+inline WidgetPtr make_textbox(std::wstring_view initial_text = L"") {
+    return make_widget<TextBox>(initial_text);
 }
 
 } // namespace zuu::widget
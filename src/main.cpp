@@ -5,11 +5,14 @@
 
 #include "zwidget/core/window.hpp"
 #include "zwidget/core/widget.hpp"
+#include "zwidget/core/property.hpp"
+#include "zwidget/core/layout_scheduler.hpp"
 #include "zwidget/widgets/label.hpp"
 #include "zwidget/widgets/textbox.hpp"
 #include "zwidget/widgets/checkbox.hpp"
 #include "zwidget/widgets/button.hpp"
 #include "zwidget/widgets/layout.hpp"
+#include "zwidget/widgets/grid.hpp"
 #include "zwidget/render/d2d/context.hpp"
 #include "zwidget/render/canvas.hpp"
 #include <iostream>
@@ -18,11 +21,13 @@ using namespace zuu::widget;
 
 /**
  * @brief Create a form demo panel
+ * One grid aligns labels and inputs, instead of a VBox of HBox rows.
  */
 WidgetPtr create_form_panel() {
-    auto panel = make_vbox(10.0f, 15.0f);
+    auto panel = make_grid(10.0f, 15.0f);
     panel->set_background(Color(250, 250, 250, 255));
     panel->set_bounds(Rectf{10, 10, 380, 400});
+    panel->set_columns({GridTrack::fixed(100), GridTrack::fraction(1)});
     
     // Title
     auto title = make_label(L"User Registration Form");
@@ -31,40 +36,31 @@ WidgetPtr create_form_panel() {
     title_style.bold = true;
     static_cast<Label*>(title.get())->set_text_style(title_style);
     title->set_preferred_size(Sizef{350, 30});
-    panel->add_child(title);
+    panel->add_child(title, GridCell{.row = 0, .column = 0, .column_span = 2});
     
     // Name field
-    auto name_row = make_hbox(10.0f);
-    name_row->set_preferred_size(Sizef{350, 30});
-    
     auto name_label = make_label(L"Name:");
     name_label->set_preferred_size(Sizef{100, 30});
-    name_row->add_child(name_label);
+    panel->add_child(name_label, GridCell{.row = 1, .column = 0});
     
     auto name_input = make_textbox();
     static_cast<TextBox*>(name_input.get())->set_placeholder(L"Enter your name");
     name_input->set_preferred_size(Sizef{240, 30});
-    name_row->add_child(name_input);
-    
-    panel->add_child(name_row);
+    panel->add_child(name_input, GridCell{.row = 1, .column = 1});
     
     // Email field
-    auto email_row = make_hbox(10.0f);
-    email_row->set_preferred_size(Sizef{350, 30});
-    
     auto email_label = make_label(L"Email:");
     email_label->set_preferred_size(Sizef{100, 30});
-    email_row->add_child(email_label);
+    panel->add_child(email_label, GridCell{.row = 2, .column = 0});
     
     auto email_input = make_textbox();
-    static_cast<TextBox*>(email_input.get())->set_placeholder(L"user@example.com");
-    static_cast<TextBox*>(email_input.get())->set_on_text_changed([](const std::wstring& text) {
-        std::wcout << L"Email changed: " << text << L"\n";
+    auto* email_box = static_cast<TextBox*>(email_input.get());
+    email_box->set_placeholder(L"user@example.com");
+    email_box->set_on_text_changed([email_box](const TextChange&) {
+        std::wcout << L"Email changed: " << email_box->text() << L"\n";
     });
     email_input->set_preferred_size(Sizef{240, 30});
-    email_row->add_child(email_input);
-    
-    panel->add_child(email_row);
+    panel->add_child(email_input, GridCell{.row = 2, .column = 1});
     
     // Checkboxes
     auto checkbox1 = make_checkbox(L"Subscribe to newsletter", false);
@@ -72,20 +68,20 @@ WidgetPtr create_form_panel() {
     static_cast<CheckBox*>(checkbox1.get())->set_on_checked_changed([](bool checked) {
         std::wcout << L"Newsletter: " << (checked ? L"Yes" : L"No") << L"\n";
     });
-    panel->add_child(checkbox1);
+    panel->add_child(checkbox1, GridCell{.row = 3, .column = 0, .column_span = 2});
     
     auto checkbox2 = make_checkbox(L"I agree to terms and conditions", false);
     checkbox2->set_preferred_size(Sizef{350, 24});
-    panel->add_child(checkbox2);
+    panel->add_child(checkbox2, GridCell{.row = 4, .column = 0, .column_span = 2});
     
     auto checkbox3 = make_checkbox(L"Enable notifications", true);
     checkbox3->set_preferred_size(Sizef{350, 24});
-    panel->add_child(checkbox3);
+    panel->add_child(checkbox3, GridCell{.row = 5, .column = 0, .column_span = 2});
     
-    // Buttons row
+    // Buttons row: a 40 px HBox across both columns, buttons at its bottom
     auto button_row = make_hbox(10.0f);
     button_row->set_preferred_size(Sizef{350, 40});
-    button_row->set_alignment(LayoutAlign::end);
+    static_cast<HBox*>(button_row.get())->set_alignment(LayoutAlign::end);
     
     auto cancel_btn = std::make_shared<Button>(L"Cancel");
     cancel_btn->set_preferred_size(Sizef{100, 35});
@@ -98,7 +94,7 @@ WidgetPtr create_form_panel() {
     submit_btn->set_foreground(Color::white());
     button_row->add_child(submit_btn);
     
-    panel->add_child(button_row);
+    panel->add_child(button_row, GridCell{.row = 6, .column = 0, .column_span = 2});
     
     return panel;
 }
@@ -238,6 +234,12 @@ int main() {
         // Create render context
         D2DContext render_ctx(window.native_handle());
         Canvas canvas(render_ctx);
+        TextShaper::set_context(&render_ctx);  // Labels shape text during layout
+        
+        // Measurements from earlier runs; tied to the default font file so a font update starts over
+        TextCacheFile text_cache("zwidget_text.cache",
+                                 TextCacheFile::file_identity("C:\\Windows\\Fonts\\segoeui.ttf"));
+        TextShaper::set_cache(&text_cache);
         
         // Create root container
         auto root = make_widget<Widget>();
@@ -249,8 +251,9 @@ int main() {
         root->add_child(create_settings_panel());
         root->add_child(create_info_panel());
         
-        // Perform initial layout
-        root->layout();
+        // Layout runs in per-frame slices, visible panels first
+        LayoutScheduler layout_scheduler(*root);
+        layout_scheduler.set_viewport(root->bounds());
         
         // Event handling
         Widget* hovered_widget = nullptr;
@@ -269,7 +272,8 @@ int main() {
                             static_cast<float>(evt.size.w),
                             static_cast<float>(evt.size.h)
                         });
-                        root->layout();
+                        layout_scheduler.set_viewport(root->bounds());
+                        layout_scheduler.relayout();
                     }
                 }
                 else if constexpr (std::is_same_v<T, MouseEvent>) {
@@ -326,20 +330,44 @@ int main() {
         std::wcout << L"Press ESC to exit.\n\n";
         
         // Main loop
+        bool first_frame = true;
         while (!window.should_close()) {
             // Process events
             window.poll_events();
             
+            // Deliver batched property changes before drawing
+            PropertyScheduler::get().flush();
+            
+            // Relayout only below boundaries invalidated since the last frame,
+            // leaving what does not fit the budget for the next one
+            layout_scheduler.run(std::chrono::milliseconds(4));
+            
             // Render
             {
                 DrawScope draw(render_ctx);
+                canvas.begin_frame();
                 canvas.clear(Color(240, 240, 240, 255));
+                root->cull_occluded(canvas);
                 root->render(canvas);
             }
             
+            if (first_frame) {
+                const auto& stats = canvas.stats();
+                std::wcout << L"First frame: " << stats.drawn_widgets << L" drawn, "
+                           << stats.culled_subtrees << L" culled, "
+                           << stats.occluded_subtrees + stats.occluded_widgets << L" occluded, "
+                           << L"overdraw " << stats.overdraw() << L"x\n";
+                TextCacheStats cached = text_cache.stats();
+                std::wcout << L"Text cache: " << cached.loaded << L" records loaded, " << cached.hits
+                           << L" hits, " << cached.misses << L" misses\n";  // Hits from the second run on
+                text_cache.flush();  // Persist what the first layout measured
+                first_frame = false;
+            }
+            
             render_ctx.present(1);
         }
         
+        TextShaper::set_cache(nullptr);
         std::wcout << L"\nDemo completed successfully!\n";
         
     } catch (const std::exception& e) {